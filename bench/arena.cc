@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/arena.hpp>
+#include <ntrusive/intrusive.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Per-request scratch state : kLists lists of `nodes` short-lived nodes are built,
+ * walked once, and all die together at the end of the request.
+ *
+ *  >> Request_NewDelete : operator new per node, IntrusiveList teardown, delete per node
+ *  >> Request_Arena     : Arena::create per node, ArenaList O(1) teardown, one Arena::reset()
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+constexpr std::size_t kLists = 4;
+
+struct HeapScratch : IntrusiveListNode<> {
+    std::uint64_t value{0};
+
+    explicit HeapScratch(std::uint64_t v) noexcept : value(v) {}
+};
+
+struct ArenaScratch : IntrusiveListNode<DefaultTag, NormalLink> {
+    std::uint64_t value{0};
+
+    explicit ArenaScratch(std::uint64_t v) noexcept : value(v) {}
+};
+
+template <typename List>
+std::uint64_t walk(List& list) noexcept {
+    std::uint64_t sum = 0;
+
+    for (const auto& node : list) {
+        sum += node.value;
+    }
+
+    return sum;
+}
+
+void sizes(benchmark::internal::Benchmark* b) {
+    b->ArgName("nodes");
+
+    for (std::int64_t n : {16, 256, 4096}) {
+        b->Arg(n);
+    }
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_Request_NewDelete(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        IntrusiveList<HeapScratch> lists[kLists];
+        std::uint64_t sum = 0;
+
+        for (auto& list : lists) {
+            for (std::size_t i = 0; i < n; ++i) {
+                list.push_back(*new HeapScratch(i));
+            }
+
+            sum += walk(list);
+        }
+
+        for (auto& list : lists) {
+            while (HeapScratch* node = list.try_pop_front()) {
+                delete node;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kLists * n));
+}
+
+static void BM_Request_Arena(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    Arena arena;
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+
+        {
+            ArenaList<ArenaScratch> lists[kLists] = {ArenaList<ArenaScratch>(arena),
+                                                     ArenaList<ArenaScratch>(arena),
+                                                     ArenaList<ArenaScratch>(arena),
+                                                     ArenaList<ArenaScratch>(arena)};
+
+            for (auto& list : lists) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    list.emplace_back(i);
+                }
+
+                sum += walk(list);
+            }
+        }
+
+        arena.reset();
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kLists * n));
+}
+
+BENCHMARK(BM_Request_NewDelete)->Apply(sizes);
+BENCHMARK(BM_Request_Arena)->Apply(sizes);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/hash_set.hpp>
+#include <ntrusive/intrusive.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Filling a table from 16 buckets to n elements, doubling at load factor 1.
+ * Besides the mean, each run reports the slowest single insert (max_insert_ns) :
+ *
+ *  >> InsertGrow_Incremental : rehash() + kRehashStep buckets moved per insert
+ *  >> InsertGrow_StopTheWorld: rehash() + every bucket moved by the insert that grows
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+struct SetEntry : IntrusiveListNode<DefaultTag, SafeLink> {
+    std::uint64_t id{0};
+};
+
+struct SetEntryHash {
+    std::size_t operator()(const SetEntry& e) const noexcept { return e.id; }
+};
+
+struct SetEntryEq {
+    bool operator()(const SetEntry& a, const SetEntry& b) const noexcept { return a.id == b.id; }
+};
+
+using Set = IntrusiveHashSet<SetEntry, SetEntryHash, SetEntryEq, CountingPolicy>;
+
+template <bool Incremental>
+void insert_grow(benchmark::State& state) {
+    using clock = std::chrono::steady_clock;
+
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto entries = std::make_unique<SetEntry[]>(n);
+
+    std::int64_t worst = 0;
+
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<Set::bucket_type[]>> tables;
+        tables.push_back(std::make_unique<Set::bucket_type[]>(16));
+
+        Set set({tables.back().get(), 16});
+
+        for (std::size_t i = 0; i < n; ++i) {
+            entries[i].id = i;
+
+            /* the new array is allocated outside the measured insert */
+            const bool grow = set.size() == set.bucket_count() && !set.rehashing();
+            const std::size_t count = set.bucket_count() * 2;
+
+            if (grow) {
+                tables.push_back(std::make_unique<Set::bucket_type[]>(count));
+            }
+
+            const auto start = clock::now();
+
+            if (grow) {
+                set.rehash({tables.back().get(), count});
+
+                if constexpr (!Incremental) {
+                    while (set.rehash_step(count)) {
+                    }
+                }
+            }
+
+            set.insert(entries[i]);
+
+            worst = std::max<std::int64_t>(
+                worst,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+        }
+
+        set.clear();
+    }
+
+    state.counters["max_insert_ns"] = static_cast<double>(worst);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+
+void sizes(benchmark::internal::Benchmark* b) {
+    b->ArgName("n");
+
+    for (std::int64_t n : {4096, 1 << 18, 1 << 20}) {
+        b->Arg(n);
+    }
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_InsertGrow_Incremental(benchmark::State& state) {
+    insert_grow<true>(state);
+}
+
+static void BM_InsertGrow_StopTheWorld(benchmark::State& state) {
+    insert_grow<false>(state);
+}
+
+BENCHMARK(BM_InsertGrow_Incremental)->Apply(sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InsertGrow_StopTheWorld)->Apply(sizes)->Unit(benchmark::kMicrosecond);
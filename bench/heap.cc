@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/heap.hpp>
+#include <ntrusive/intrusive.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+/**
+ * Deadline scheduler in steady state : n live timers, every operation fires the
+ * earliest one and re-arms it with a new random deadline.
+ *
+ *  >> SortedList   : IntrusiveList kept sorted by insert(), O(n) per re-arm
+ *  >> PairingHeap  : IntrusivePairingHeap, pop O(log n) + push O(1)
+ *  >> Decrease     : IntrusivePairingHeap, pull a random timer earlier with decrease()
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+struct ListTimer : IntrusiveListNode<> {
+    std::uint64_t deadline{0};
+};
+
+struct HeapTimer : IntrusiveHeapNode<> {
+    std::uint64_t deadline{0};
+};
+
+struct ByDeadline {
+    bool operator()(const HeapTimer& a, const HeapTimer& b) const noexcept {
+        return a.deadline < b.deadline;
+    }
+};
+
+using TimerHeap = IntrusivePairingHeap<HeapTimer, ByDeadline>;
+
+constexpr std::uint64_t kHorizon = 1'000'000;
+
+void timers(benchmark::internal::Benchmark* b) {
+    b->ArgName("n");
+
+    for (std::int64_t n : {256, 4096, 65536, 1 << 20}) {
+        b->Arg(n);
+    }
+}
+
+void insert_sorted(IntrusiveList<ListTimer>& list, ListTimer& timer) {
+    auto it = list.begin();
+
+    while (it != list.end() && it->deadline <= timer.deadline) {
+        ++it;
+    }
+
+    list.insert(it, timer);
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_Rearm_SortedList(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto nodes = std::make_unique<ListTimer[]>(n);
+
+    std::mt19937_64 rng(1);
+    IntrusiveList<ListTimer> list;
+
+    /* build sorted : deadlines i * step */
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].deadline = i * (kHorizon / n);
+        list.push_back(nodes[i]);
+    }
+
+    std::uint64_t now = 0;
+
+    for (auto _ : state) {
+        ListTimer* fired = list.try_pop_front();
+        now = fired->deadline;
+
+        fired->deadline = now + rng() % kHorizon;
+        insert_sorted(list, *fired);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    list.clear();
+}
+
+static void BM_Rearm_PairingHeap(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto nodes = std::make_unique<HeapTimer[]>(n);
+
+    std::mt19937_64 rng(1);
+    TimerHeap heap;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].deadline = i * (kHorizon / n);
+        heap.push(nodes[i]);
+    }
+
+    /* the first pop pairs n flat children in O(n), keep it out of the timed loop */
+    HeapTimer* first = heap.try_pop();
+    heap.push(*first);
+
+    std::uint64_t now = 0;
+
+    for (auto _ : state) {
+        HeapTimer* fired = heap.try_pop();
+        now = fired->deadline;
+
+        fired->deadline = now + rng() % kHorizon;
+        heap.push(*fired);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    heap.clear();
+}
+
+static void BM_Decrease_PairingHeap(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto nodes = std::make_unique<HeapTimer[]>(n);
+
+    std::mt19937_64 rng(1);
+    TimerHeap heap;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].deadline = kHorizon + rng() % kHorizon;
+        heap.push(nodes[i]);
+    }
+
+    for (auto _ : state) {
+        HeapTimer& timer = nodes[rng() % n];
+
+        if (timer.deadline > 0) {
+            timer.deadline -= 1;
+        }
+
+        heap.decrease(timer);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    heap.clear();
+}
+
+BENCHMARK(BM_Rearm_SortedList)->Apply(timers);
+BENCHMARK(BM_Rearm_PairingHeap)->Apply(timers);
+BENCHMARK(BM_Decrease_PairingHeap)->Apply(timers);
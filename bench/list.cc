@@ -0,0 +1,947 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <vector>
+
+/**
+ * IntrusiveList<T> (and IntrusiveSList<T> where it applies) vs std::list<T> vs std::deque<T*>.
+ *
+ * Every benchmark takes two arguments:
+ *  >> n    : number of elements in the container
+ *  >> cold : 0 = caches stay warm between iterations,
+ *            1 = a buffer larger than the LLC is streamed through before each iteration
+ *
+ * The intrusive and deque variants use preallocated nodes, std::list allocates
+ * its own (which is exactly the cost an intrusive list removes).
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+template <typename Mode>
+struct BasicNode : IntrusiveListNode<DefaultTag, Mode> {
+    std::int64_t value{0};
+};
+
+using Node = BasicNode<AutoUnlink>;
+
+/* 8-byte hook instead of the list's 16 : one pointer, no prev */
+struct SNode : IntrusiveSListNode<> {
+    std::int64_t value{0};
+};
+
+struct Plain {
+    std::int64_t value{0};
+};
+
+using List = IntrusiveList<Node>;
+
+constexpr std::size_t kBatch = 64;
+
+/* 64 MiB is larger than the last level cache of anything we deploy on */
+constexpr std::size_t kFlushBytes = std::size_t{64} << 20;
+
+void flush_caches() {
+    static std::vector<char> buffer(kFlushBytes);
+
+    for (std::size_t i = 0; i < buffer.size(); i += 64) {
+        buffer[i] = static_cast<char>(buffer[i] + 1);
+    }
+
+    benchmark::ClobberMemory();
+}
+
+/* runs before every timed iteration in cold mode */
+void maybe_flush(benchmark::State& state) {
+    if (state.range(1) == 0) {
+        return;
+    }
+
+    state.PauseTiming();
+    flush_caches();
+    state.ResumeTiming();
+}
+
+template <typename N = Node>
+auto make_nodes(std::size_t n) -> std::unique_ptr<N[]> {
+    auto nodes = std::make_unique<N[]>(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].value = static_cast<std::int64_t>(i);
+    }
+
+    return nodes;
+}
+
+template <typename L, typename N>
+void fill(L& list, N* nodes, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        list.push_back(nodes[i]);
+    }
+}
+
+void fill(std::list<Plain>& list, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        list.push_back(Plain{static_cast<std::int64_t>(i)});
+    }
+}
+
+void fill(std::deque<Node*>& deque, Node* nodes, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        deque.push_back(&nodes[i]);
+    }
+}
+
+void sizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "cold"});
+
+    for (std::int64_t n : {16, 256, 4096, 65536, 1 << 20, 10'000'000}) {
+        for (std::int64_t cold : {0, 1}) {
+            b->Args({n, cold});
+        }
+    }
+}
+
+auto size_arg(benchmark::State& state) -> std::size_t {
+    return static_cast<std::size_t>(state.range(0));
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---* push_back / pop_front *---*---*---*---*---*---*---*---*/
+
+static void BM_PushPop_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    List list;
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        fill(list, nodes.get(), n);
+
+        while (!list.empty()) {
+            list.pop_front();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+static void BM_PushPop_IntrusiveSList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes<SNode>(n);
+    IntrusiveSList<SNode> list;
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        fill(list, nodes.get(), n);
+
+        while (!list.empty()) {
+            list.pop_front();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+static void BM_PushPop_StdList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    std::list<Plain> list;
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        fill(list, n);
+
+        while (!list.empty()) {
+            list.pop_front();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+static void BM_PushPop_Deque(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    std::deque<Node*> deque;
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        fill(deque, nodes.get(), n);
+
+        while (!deque.empty()) {
+            deque.pop_front();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+BENCHMARK(BM_PushPop_Intrusive)->Apply(sizes);
+BENCHMARK(BM_PushPop_IntrusiveSList)->Apply(sizes);
+BENCHMARK(BM_PushPop_StdList)->Apply(sizes);
+BENCHMARK(BM_PushPop_Deque)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* insert / erase in the middle *---*---*---*---*---*---*---*---*/
+
+static void BM_InsertEraseMiddle_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    Node extra;
+    List list;
+
+    fill(list, nodes.get(), n);
+
+    /* an intrusive list gets the position for free: the node itself */
+    auto middle = List::iterator(&nodes[n / 2]);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        auto it = list.insert(middle, extra);
+        list.erase(it);
+    }
+
+    list.clear();
+}
+
+static void BM_InsertEraseMiddle_StdList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    std::list<Plain> list;
+
+    fill(list, n);
+
+    auto middle = std::next(list.begin(), static_cast<std::ptrdiff_t>(n / 2));
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        auto it = list.insert(middle, Plain{});
+        list.erase(it);
+    }
+}
+
+static void BM_InsertEraseMiddle_Deque(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    Node extra;
+    std::deque<Node*> deque;
+
+    fill(deque, nodes.get(), n);
+
+    const auto middle = static_cast<std::ptrdiff_t>(n / 2);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        auto it = deque.insert(deque.begin() + middle, &extra);
+        deque.erase(it);
+    }
+}
+
+BENCHMARK(BM_InsertEraseMiddle_Intrusive)->Apply(sizes);
+BENCHMARK(BM_InsertEraseMiddle_StdList)->Apply(sizes);
+BENCHMARK(BM_InsertEraseMiddle_Deque)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* splice *---*---*---*---*---*---*---*---*/
+
+static void BM_Splice_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    List from;
+    List to;
+
+    fill(from, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        to.splice(to.end(), from);
+        from.splice(from.end(), to);
+    }
+
+    from.clear();
+}
+
+static void BM_Splice_StdList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    std::list<Plain> from;
+    std::list<Plain> to;
+
+    fill(from, n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        to.splice(to.end(), from);
+        from.splice(from.end(), to);
+    }
+}
+
+static void BM_Splice_Deque(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    std::deque<Node*> from;
+    std::deque<Node*> to;
+
+    fill(from, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        to.insert(to.end(), from.begin(), from.end());
+        from.clear();
+
+        from.insert(from.end(), to.begin(), to.end());
+        to.clear();
+    }
+}
+
+BENCHMARK(BM_Splice_Intrusive)->Apply(sizes);
+BENCHMARK(BM_Splice_StdList)->Apply(sizes);
+BENCHMARK(BM_Splice_Deque)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* extract_front *---*---*---*---*---*---*---*---*/
+
+/* take a batch of kBatch from the front and requeue it at the back */
+
+static void BM_ExtractFront_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    List list;
+    List batch;
+
+    fill(list, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        auto cnt = list.extract_front(batch, kBatch);
+        benchmark::DoNotOptimize(cnt);
+
+        list.splice(list.end(), batch);
+    }
+
+    list.clear();
+}
+
+static void BM_ExtractFront_StdList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    std::list<Plain> list;
+    std::list<Plain> batch;
+
+    fill(list, n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        auto split = list.begin();
+        for (std::size_t i = 0; i < kBatch && split != list.end(); ++i) {
+            ++split;
+        }
+
+        batch.splice(batch.end(), list, list.begin(), split);
+        list.splice(list.end(), batch);
+    }
+}
+
+static void BM_ExtractFront_Deque(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    std::deque<Node*> deque;
+    std::deque<Node*> batch;
+
+    fill(deque, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        for (std::size_t i = 0; i < kBatch && !deque.empty(); ++i) {
+            batch.push_back(deque.front());
+            deque.pop_front();
+        }
+
+        deque.insert(deque.end(), batch.begin(), batch.end());
+        batch.clear();
+    }
+}
+
+BENCHMARK(BM_ExtractFront_Intrusive)->Apply(sizes);
+BENCHMARK(BM_ExtractFront_StdList)->Apply(sizes);
+BENCHMARK(BM_ExtractFront_Deque)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* clear *---*---*---*---*---*---*---*---*/
+
+/* only clear() is timed, refilling happens with the timer paused */
+
+/* clear() per link mode : AutoUnlink / SafeLink walk once resetting hooks, NormalLink is O(1) */
+template <typename Mode>
+static void BM_Clear_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes<BasicNode<Mode>>(n);
+    IntrusiveList<BasicNode<Mode>> list;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fill(list, nodes.get(), n);
+        if (state.range(1) != 0) {
+            flush_caches();
+        }
+        state.ResumeTiming();
+
+        list.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+static void BM_Clear_StdList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    std::list<Plain> list;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fill(list, n);
+        if (state.range(1) != 0) {
+            flush_caches();
+        }
+        state.ResumeTiming();
+
+        list.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+static void BM_Clear_Deque(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    std::deque<Node*> deque;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fill(deque, nodes.get(), n);
+        if (state.range(1) != 0) {
+            flush_caches();
+        }
+        state.ResumeTiming();
+
+        deque.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+/* what clear() used to be : pop_front() until empty */
+static void BM_Clear_IntrusivePopAll(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    List list;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fill(list, nodes.get(), n);
+        if (state.range(1) != 0) {
+            flush_caches();
+        }
+        state.ResumeTiming();
+
+        while (!list.empty()) {
+            list.pop_front();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+BENCHMARK_TEMPLATE(BM_Clear_Intrusive, AutoUnlink)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Clear_Intrusive, TrackedLink)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Clear_Intrusive, SafeLink)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Clear_Intrusive, NormalLink)->Apply(sizes);
+BENCHMARK(BM_Clear_IntrusivePopAll)->Apply(sizes);
+BENCHMARK(BM_Clear_StdList)->Apply(sizes);
+BENCHMARK(BM_Clear_Deque)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* teardown *---*---*---*---*---*---*---*---*/
+
+/*
+ * Shutdown / epoch reset : a populated list and its nodes are dropped together.
+ *  >> AutoUnlink : the list is left alone, every node unlinks itself in its destructor
+ *  >> SafeLink   : detach_all() walks once, the destructors only check the hooks
+ *  >> NormalLink : release_all() in O(1), the destructors do nothing
+ */
+template <typename Mode>
+static void BM_Teardown_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto nodes = make_nodes<BasicNode<Mode>>(n);
+        auto list = std::make_unique<IntrusiveList<BasicNode<Mode>>>();
+        fill(*list, nodes.get(), n);
+        if (state.range(1) != 0) {
+            flush_caches();
+        }
+        state.ResumeTiming();
+
+        if constexpr (Mode::is_auto_unlink) {
+            nodes.reset();
+        } else if constexpr (Mode::is_safe) {
+            list->detach_all();
+            nodes.reset();
+        } else {
+            list->release_all();
+            nodes.reset();
+        }
+
+        list.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+BENCHMARK_TEMPLATE(BM_Teardown_Intrusive, AutoUnlink)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Teardown_Intrusive, TrackedLink)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Teardown_Intrusive, SafeLink)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Teardown_Intrusive, NormalLink)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* traversal *---*---*---*---*---*---*---*---*/
+
+static void BM_Traverse_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    List list;
+
+    fill(list, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        std::int64_t sum = 0;
+        for (auto& node : list) {
+            sum += node.value;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+
+    list.clear();
+}
+
+static void BM_Traverse_IntrusiveSList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes<SNode>(n);
+    IntrusiveSList<SNode> list;
+
+    fill(list, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        std::int64_t sum = 0;
+        for (auto& node : list) {
+            sum += node.value;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+
+    list.clear();
+}
+
+static void BM_Traverse_StdList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    std::list<Plain> list;
+
+    fill(list, n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        std::int64_t sum = 0;
+        for (auto& node : list) {
+            sum += node.value;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+static void BM_Traverse_Deque(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    std::deque<Node*> deque;
+
+    fill(deque, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        std::int64_t sum = 0;
+        for (auto* node : deque) {
+            sum += node->value;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+BENCHMARK(BM_Traverse_Intrusive)->Apply(sizes);
+BENCHMARK(BM_Traverse_IntrusiveSList)->Apply(sizes);
+BENCHMARK(BM_Traverse_StdList)->Apply(sizes);
+BENCHMARK(BM_Traverse_Deque)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* size *---*---*---*---*---*---*---*---*/
+
+static void BM_Size_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    List list;
+
+    fill(list, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        benchmark::DoNotOptimize(list.size());
+    }
+
+    list.clear();
+}
+
+static void BM_Size_IntrusiveCounting(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes<BasicNode<SafeLink>>(n);
+    IntrusiveList<BasicNode<SafeLink>, CountingPolicy> list;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        list.push_back(nodes[i]);
+    }
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        benchmark::DoNotOptimize(list.size());
+    }
+
+    list.clear();
+}
+
+BENCHMARK(BM_Size_Intrusive)->Apply(sizes);
+BENCHMARK(BM_Size_IntrusiveCounting)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* sort *---*---*---*---*---*---*---*---*/
+
+/*
+ * The nodes carry pseudo-random keys, the list is refilled in node order with the
+ * timer paused, so every iteration sorts the same input.
+ *  >> Intrusive       : list.sort(), relinking only
+ *  >> VectorRoundTrip : pointers copied into a std::vector, std::stable_sort, list rebuilt
+ *  >> StdList         : std::list::sort() on its own nodes
+ */
+
+namespace {
+
+template <typename N>
+void scramble(N* nodes, std::size_t n) {
+    std::uint64_t x = 0x9e3779b97f4a7c15ULL;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        nodes[i].value = static_cast<std::int64_t>(x >> 1);
+    }
+}
+
+template <typename N>
+bool by_value(const N& a, const N& b) noexcept {
+    return a.value < b.value;
+}
+
+void batch_sizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "cold"});
+
+    for (std::int64_t n : {16, 256, 4096, 65536, 1 << 20}) {
+        for (std::int64_t cold : {0, 1}) {
+            b->Args({n, cold});
+        }
+    }
+}
+
+/* refill with the timer paused, then flush in cold mode */
+template <typename Refill>
+void prepare(benchmark::State& state, Refill refill) {
+    state.PauseTiming();
+    refill();
+    if (state.range(1) != 0) {
+        flush_caches();
+    }
+    state.ResumeTiming();
+}
+
+} // namespace
+
+static void BM_Sort_Intrusive(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    scramble(nodes.get(), n);
+    List list;
+
+    for (auto _ : state) {
+        prepare(state, [&] {
+            list.clear();
+            fill(list, nodes.get(), n);
+        });
+
+        list.sort(by_value<Node>);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+    list.clear();
+}
+
+static void BM_Sort_VectorRoundTrip(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    scramble(nodes.get(), n);
+    List list;
+
+    for (auto _ : state) {
+        prepare(state, [&] {
+            list.clear();
+            fill(list, nodes.get(), n);
+        });
+
+        std::vector<Node*> order;
+        order.reserve(n);
+
+        for (Node& node : list) {
+            order.push_back(&node);
+        }
+
+        std::stable_sort(order.begin(), order.end(),
+                         [](const Node* a, const Node* b) { return a->value < b->value; });
+
+        list.clear();
+
+        for (Node* node : order) {
+            list.push_back(*node);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+    list.clear();
+}
+
+static void BM_Sort_StdList(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto keys = make_nodes<Plain>(n);
+    scramble(keys.get(), n);
+    std::list<Plain> list;
+
+    for (auto _ : state) {
+        prepare(state, [&] { list.assign(keys.get(), keys.get() + n); });
+
+        list.sort(by_value<Plain>);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+BENCHMARK(BM_Sort_Intrusive)->Apply(batch_sizes);
+BENCHMARK(BM_Sort_VectorRoundTrip)->Apply(batch_sizes);
+BENCHMARK(BM_Sort_StdList)->Apply(batch_sizes);
+
+/*---*---*---*---*---*---*---*---* batch enqueue *---*---*---*---*---*---*---*---*/
+
+/*
+ * n nodes are linked at the back of the list, the detach afterwards is not timed.
+ *  >> Loop  : push_back() per node
+ *  >> Range : one push_back_range() over an array of pointers
+ */
+template <typename Mode>
+static void BM_PushBackBatch_Loop(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes<BasicNode<Mode>>(n);
+    std::vector<BasicNode<Mode>*> batch;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        batch.push_back(&nodes[i]);
+    }
+
+    IntrusiveList<BasicNode<Mode>> list;
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        for (BasicNode<Mode>* node : batch) {
+            list.push_back(*node);
+        }
+
+        state.PauseTiming();
+        list.detach_all();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+template <typename Mode>
+static void BM_PushBackBatch_Range(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes<BasicNode<Mode>>(n);
+    std::vector<BasicNode<Mode>*> batch;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        batch.push_back(&nodes[i]);
+    }
+
+    IntrusiveList<BasicNode<Mode>> list;
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        list.push_back_range(batch.begin(), batch.end());
+
+        state.PauseTiming();
+        list.detach_all();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+
+BENCHMARK_TEMPLATE(BM_PushBackBatch_Loop, SafeLink)->Apply(batch_sizes);
+BENCHMARK_TEMPLATE(BM_PushBackBatch_Range, SafeLink)->Apply(batch_sizes);
+BENCHMARK_TEMPLATE(BM_PushBackBatch_Loop, TrackedLink)->Apply(batch_sizes);
+BENCHMARK_TEMPLATE(BM_PushBackBatch_Range, TrackedLink)->Apply(batch_sizes);
+
+/*---*---*---*---*---*---*---*---* cut at a known node *---*---*---*---*---*---*---*---*/
+
+/*
+ * The dispatcher holds the node where the batch ends (half the list), the batch is
+ * cut off and requeued.
+ *  >> ExtractFront : extract_front(n / 2) walks to the cut
+ *  >> SplitAfter   : split_after(cut) in O(1)
+ */
+static void BM_Cut_ExtractFront(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    List list;
+    List batch;
+
+    fill(list, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        auto cnt = list.extract_front(batch, n / 2);
+        benchmark::DoNotOptimize(cnt);
+
+        list.splice(list.begin(), batch);
+    }
+
+    list.clear();
+}
+
+static void BM_Cut_SplitAfter(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes(n);
+    List list;
+    List batch;
+
+    fill(list, nodes.get(), n);
+
+    /* last node of the batch */
+    auto cut = list.cbegin();
+    std::advance(cut, n / 2 - 1);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        list.split_after(cut, batch);
+        benchmark::DoNotOptimize(batch.cbegin());
+
+        list.splice(list.end(), batch);
+    }
+
+    list.clear();
+}
+
+BENCHMARK(BM_Cut_ExtractFront)->Apply(sizes);
+BENCHMARK(BM_Cut_SplitAfter)->Apply(sizes);
+
+/*---*---*---*---*---*---*---*---* batch dispatch *---*---*---*---*---*---*---*---*/
+
+/*
+ * A consumer takes kBatch elements from the front, processes them and requeues them.
+ *  >> ExtractThenPop : extract_front() into a local list, then try_pop_front() each
+ *  >> Consume        : consume_front(), the callback requeues directly
+ */
+static void BM_Dispatch_ExtractThenPop(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes<BasicNode<SafeLink>>(n);
+    IntrusiveList<BasicNode<SafeLink>> list;
+    IntrusiveList<BasicNode<SafeLink>> local;
+
+    fill(list, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        auto cnt = list.extract_front(local, kBatch);
+        benchmark::DoNotOptimize(cnt);
+
+        while (auto* node = local.try_pop_front()) {
+            benchmark::DoNotOptimize(node->value);
+            list.push_back(*node);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(std::min(n, kBatch)));
+    list.clear();
+}
+
+static void BM_Dispatch_Consume(benchmark::State& state) {
+    const auto n = size_arg(state);
+    auto nodes = make_nodes<BasicNode<SafeLink>>(n);
+    IntrusiveList<BasicNode<SafeLink>> list;
+
+    fill(list, nodes.get(), n);
+
+    for (auto _ : state) {
+        maybe_flush(state);
+
+        auto cnt = list.consume_front(kBatch, [&](BasicNode<SafeLink>& node) {
+            benchmark::DoNotOptimize(node.value);
+            list.push_back(node);
+        });
+        benchmark::DoNotOptimize(cnt);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(std::min(n, kBatch)));
+    list.clear();
+}
+
+BENCHMARK(BM_Dispatch_ExtractThenPop)->Apply(sizes);
+BENCHMARK(BM_Dispatch_Consume)->Apply(sizes);
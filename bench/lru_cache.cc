@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/lru_cache.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Bounded cache of `capacity` entries over a key space 4x larger, keys drawn uniformly :
+ * a hit touches the entry, a miss evicts the LRU entry and reuses it for the new key.
+ *
+ *  >> Lookup_IntrusiveLruCache : hash index + recency list inside the object, no allocation
+ *  >> Lookup_StdLruCache       : std::list<pair> + std::unordered_map<K, list::iterator>,
+ *                                one node allocation per insert on each container
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+struct CacheEntry : IntrusiveListNode<LruOrderTag, SafeLink>, IntrusiveListNode<LruIndexTag> {
+    std::uint64_t key{0};
+    std::uint64_t value{0};
+};
+
+using Cache = IntrusiveLruCache<std::uint64_t, CacheEntry>;
+
+class StdLruCache {
+  public:
+    explicit StdLruCache(std::size_t capacity) : capacity_(capacity) { index_.reserve(capacity); }
+
+    std::uint64_t* get(std::uint64_t key) {
+        auto it = index_.find(key);
+
+        if (it == index_.end()) {
+            return nullptr;
+        }
+
+        order_.splice(order_.begin(), order_, it->second);
+        return &it->second->second;
+    }
+
+    void put(std::uint64_t key, std::uint64_t value) {
+        if (order_.size() == capacity_) {
+            index_.erase(order_.back().first);
+            order_.pop_back();
+        }
+
+        order_.emplace_front(key, value);
+        index_.emplace(key, order_.begin());
+    }
+
+  private:
+    std::size_t capacity_;
+    std::list<std::pair<std::uint64_t, std::uint64_t>> order_;
+    std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, std::uint64_t>>::iterator> index_;
+};
+
+void capacities(benchmark::internal::Benchmark* b) {
+    b->ArgName("capacity");
+
+    for (std::int64_t n : {1024, 65536, 1 << 20}) {
+        b->Arg(n);
+    }
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_Lookup_IntrusiveLruCache(benchmark::State& state) {
+    const auto capacity = static_cast<std::size_t>(state.range(0));
+
+    auto entries = std::make_unique<CacheEntry[]>(capacity);
+    std::vector<Cache::bucket_type> buckets(capacity);
+    Cache cache(buckets);
+    Cache::order_type evicted;
+
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<std::uint64_t> keys(0, 4 * capacity - 1);
+
+    for (std::size_t i = 0; i < capacity; ++i) {
+        entries[i].key = i;
+        cache.insert(entries[i]);
+    }
+
+    for (auto _ : state) {
+        const std::uint64_t key = keys(rng);
+        CacheEntry* entry = cache.get(key);
+
+        if (entry == nullptr) {
+            cache.evict_n(1, evicted);
+
+            entry = evicted.try_pop_front();
+            entry->key = key;
+            entry->value = key;
+
+            cache.insert(*entry);
+        }
+
+        benchmark::DoNotOptimize(entry->value);
+    }
+
+    cache.clear();
+}
+
+static void BM_Lookup_StdLruCache(benchmark::State& state) {
+    const auto capacity = static_cast<std::size_t>(state.range(0));
+
+    StdLruCache cache(capacity);
+
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<std::uint64_t> keys(0, 4 * capacity - 1);
+
+    for (std::size_t i = 0; i < capacity; ++i) {
+        cache.put(i, i);
+    }
+
+    for (auto _ : state) {
+        const std::uint64_t key = keys(rng);
+        std::uint64_t* value = cache.get(key);
+
+        if (value == nullptr) {
+            cache.put(key, key);
+            value = cache.get(key);
+        }
+
+        benchmark::DoNotOptimize(*value);
+    }
+}
+
+BENCHMARK(BM_Lookup_IntrusiveLruCache)->Apply(capacities);
+BENCHMARK(BM_Lookup_StdLruCache)->Apply(capacities);
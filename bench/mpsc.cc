@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/mpsc_queue.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * N producers push kPerProducer tasks each, one consumer drains them all.
+ * Wall-clock time of the whole hand-off, per argument : number of producers.
+ *
+ *  >> Mpsc_TryPop   : IntrusiveMpscQueue, consumer pops one by one
+ *  >> Mpsc_PopAll   : IntrusiveMpscQueue, consumer takes batches with pop_all()
+ *  >> Mutex_PopFront: std::mutex + IntrusiveList, consumer locks per task
+ *  >> Mutex_Splice  : std::mutex + IntrusiveList, consumer splices everything out per lock
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+struct Task : IntrusiveListNode<> {
+    std::int64_t payload{0};
+};
+
+constexpr std::size_t kPerProducer = std::size_t{1} << 16;
+
+struct MutexQueue {
+    std::mutex mutex;
+    IntrusiveList<Task> list;
+};
+
+template <typename Queue, typename Push, typename Drain>
+void run(benchmark::State& state, Push push, Drain drain) {
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto total = producers * kPerProducer;
+
+    auto tasks = std::make_unique<Task[]>(total);
+
+    for (auto _ : state) {
+        Queue queue;
+        std::vector<std::thread> threads;
+
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (std::size_t i = 0; i < kPerProducer; ++i) {
+                    push(queue, tasks[p * kPerProducer + i]);
+                }
+            });
+        }
+
+        std::size_t consumed = 0;
+        std::int64_t sum = 0;
+
+        while (consumed < total) {
+            consumed += drain(queue, sum);
+        }
+
+        benchmark::DoNotOptimize(sum);
+
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(total));
+}
+
+void producers(benchmark::internal::Benchmark* b) {
+    b->ArgName("producers");
+
+    for (std::int64_t p : {1, 2, 4, 8, 16, 32}) {
+        b->Arg(p);
+    }
+
+    b->UseRealTime();
+    b->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_Mpsc_TryPop(benchmark::State& state) {
+    run<IntrusiveMpscQueue<Task>>(
+        state,
+        [](auto& queue, Task& task) { queue.push(task); },
+        [](auto& queue, std::int64_t& sum) -> std::size_t {
+            if (auto* task = queue.try_pop()) {
+                sum += task->payload;
+                return 1;
+            }
+            return 0;
+        });
+}
+
+static void BM_Mpsc_PopAll(benchmark::State& state) {
+    run<IntrusiveMpscQueue<Task>>(
+        state,
+        [](auto& queue, Task& task) { queue.push(task); },
+        [](auto& queue, std::int64_t& sum) -> std::size_t {
+            IntrusiveList<Task> batch;
+            std::size_t cnt = queue.pop_all(batch);
+
+            for (auto& task : batch) {
+                sum += task.payload;
+            }
+
+            batch.clear();
+            return cnt;
+        });
+}
+
+static void BM_Mutex_PopFront(benchmark::State& state) {
+    run<MutexQueue>(
+        state,
+        [](auto& queue, Task& task) {
+            std::lock_guard guard(queue.mutex);
+            queue.list.push_back(task);
+        },
+        [](auto& queue, std::int64_t& sum) -> std::size_t {
+            std::lock_guard guard(queue.mutex);
+
+            if (auto* task = queue.list.try_pop_front()) {
+                sum += task->payload;
+                return 1;
+            }
+            return 0;
+        });
+}
+
+static void BM_Mutex_Splice(benchmark::State& state) {
+    run<MutexQueue>(
+        state,
+        [](auto& queue, Task& task) {
+            std::lock_guard guard(queue.mutex);
+            queue.list.push_back(task);
+        },
+        [](auto& queue, std::int64_t& sum) -> std::size_t {
+            IntrusiveList<Task> batch;
+            {
+                std::lock_guard guard(queue.mutex);
+                batch.splice(batch.end(), queue.list);
+            }
+
+            std::size_t cnt = 0;
+            for (auto& task : batch) {
+                sum += task.payload;
+                ++cnt;
+            }
+
+            batch.clear();
+            return cnt;
+        });
+}
+
+BENCHMARK(BM_Mpsc_TryPop)->Apply(producers);
+BENCHMARK(BM_Mpsc_PopAll)->Apply(producers);
+BENCHMARK(BM_Mutex_PopFront)->Apply(producers);
+BENCHMARK(BM_Mutex_Splice)->Apply(producers);
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/parallel.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * kNodes nodes with pseudo-random keys, refilled in node order with the timer paused.
+ *
+ *  >> Sort_Sequential     : list.sort() on the calling thread
+ *  >> Sort_Parallel       : parallel_sort() on a ThreadPool of `threads` workers
+ *  >> ForEach_Sequential  : range-for, fn hashes the key a few rounds
+ *  >> ForEach_Parallel    : parallel_for_each() with the same fn
+ *
+ * Speedups need as many idle cores as workers, the split/merge overhead shows on fewer.
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+constexpr std::size_t kNodes = 1 << 20;
+
+struct Keyed : IntrusiveListNode<DefaultTag, NormalLink> {
+    std::uint64_t key{0};
+};
+
+using KeyedList = IntrusiveList<Keyed, CountingPolicy>;
+
+auto keyed_nodes() -> std::unique_ptr<Keyed[]> {
+    auto nodes = std::make_unique<Keyed[]>(kNodes);
+    std::uint64_t x = 0x9e3779b97f4a7c15ULL;
+
+    for (std::size_t i = 0; i < kNodes; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        nodes[i].key = x;
+    }
+
+    return nodes;
+}
+
+void fill(KeyedList& list, Keyed* nodes) {
+    list.release_all();
+
+    for (std::size_t i = 0; i < kNodes; ++i) {
+        list.push_back(nodes[i]);
+    }
+}
+
+void refill(benchmark::State& state, KeyedList& list, Keyed* nodes) {
+    state.PauseTiming();
+    fill(list, nodes);
+    state.ResumeTiming();
+}
+
+bool by_key(const Keyed& a, const Keyed& b) noexcept {
+    return a.key < b.key;
+}
+
+void mix(Keyed& node) noexcept {
+    std::uint64_t h = node.key;
+
+    for (int r = 0; r < 16; ++r) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+    }
+
+    benchmark::DoNotOptimize(h);
+}
+
+void threads(benchmark::internal::Benchmark* b) {
+    b->ArgName("threads");
+
+    for (std::int64_t t : {1, 2, 4, 8}) {
+        b->Arg(t);
+    }
+
+    b->UseRealTime();
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_Sort_Sequential(benchmark::State& state) {
+    auto nodes = keyed_nodes();
+    KeyedList list;
+
+    for (auto _ : state) {
+        refill(state, list, nodes.get());
+        list.sort(by_key);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNodes));
+    list.release_all();
+}
+
+static void BM_Sort_Parallel(benchmark::State& state) {
+    auto nodes = keyed_nodes();
+    KeyedList list;
+    ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        refill(state, list, nodes.get());
+        parallel_sort(list, pool, by_key);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNodes));
+    list.release_all();
+}
+
+static void BM_ForEach_Sequential(benchmark::State& state) {
+    auto nodes = keyed_nodes();
+    KeyedList list;
+    fill(list, nodes.get());
+
+    for (auto _ : state) {
+        for (Keyed& node : list) {
+            mix(node);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNodes));
+    list.release_all();
+}
+
+static void BM_ForEach_Parallel(benchmark::State& state) {
+    auto nodes = keyed_nodes();
+    KeyedList list;
+    ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+    fill(list, nodes.get());
+
+    for (auto _ : state) {
+        parallel_for_each(list, mix, pool);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNodes));
+    list.release_all();
+}
+
+BENCHMARK(BM_Sort_Sequential)->UseRealTime();
+BENCHMARK(BM_Sort_Parallel)->Apply(threads);
+BENCHMARK(BM_ForEach_Sequential)->UseRealTime();
+BENCHMARK(BM_ForEach_Parallel)->Apply(threads);
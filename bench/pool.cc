@@ -0,0 +1,151 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/pool.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * Request lifecycle : kRequests request objects are created, linked into an IntrusiveList,
+ * processed, then all destroyed. Per argument : number of threads doing it at once.
+ *
+ *  >> Lifecycle_NewDelete        : operator new / delete per request
+ *  >> Lifecycle_Pool             : IntrusivePool::acquire / release, one depot lock each
+ *  >> Lifecycle_PoolLocalCache   : per-thread LocalCache, lock only every kCacheBatch objects
+ *  >> Lifecycle_PoolBatch        : acquire_batch / release_batch, one lock each per round
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+struct Request : IntrusiveListNode<> {
+    std::uint64_t id{0};
+    std::uint64_t payload[7]{};
+
+    Request() noexcept = default;
+    explicit Request(std::uint64_t i) noexcept : id(i) {}
+};
+
+using RequestPool = IntrusivePool<Request, 1024>;
+
+constexpr std::size_t kRequests = 256;
+constexpr std::size_t kRounds = 64;
+
+std::uint64_t process(IntrusiveList<Request>& live) noexcept {
+    std::uint64_t sum = 0;
+
+    for (const Request& r : live) {
+        sum += r.id;
+    }
+
+    return sum;
+}
+
+/* kRounds request lifecycles, objects from acquire(i), given back with release(r) */
+template <typename Acquire, typename Release>
+std::uint64_t rounds(Acquire acquire, Release release) {
+    std::uint64_t sum = 0;
+
+    for (std::size_t round = 0; round < kRounds; ++round) {
+        IntrusiveList<Request> live;
+
+        for (std::size_t i = 0; i < kRequests; ++i) {
+            live.push_back(*acquire(i));
+        }
+
+        sum += process(live);
+
+        while (Request* r = live.try_pop_front()) {
+            release(r);
+        }
+    }
+
+    return sum;
+}
+
+/* body() runs on every thread at once */
+template <typename Body>
+void lifecycle(benchmark::State& state, Body body) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+
+        for (std::size_t t = 0; t < n; ++t) {
+            threads.emplace_back([&] { benchmark::DoNotOptimize(body()); });
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(n * kRounds * kRequests));
+}
+
+void threads(benchmark::internal::Benchmark* b) {
+    b->ArgName("threads");
+
+    for (std::int64_t t : {1, 2, 4}) {
+        b->Arg(t);
+    }
+
+    b->UseRealTime();
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_Lifecycle_NewDelete(benchmark::State& state) {
+    lifecycle(state, [] {
+        return rounds([](std::size_t i) { return new Request(i); },
+                      [](Request* r) { delete r; });
+    });
+}
+
+static void BM_Lifecycle_Pool(benchmark::State& state) {
+    RequestPool pool(4 * kRequests);
+
+    lifecycle(state, [&] {
+        return rounds([&](std::size_t i) { return pool.acquire(i); },
+                      [&](Request* r) { pool.release(r); });
+    });
+}
+
+static void BM_Lifecycle_PoolLocalCache(benchmark::State& state) {
+    RequestPool pool(4 * kRequests);
+
+    lifecycle(state, [&] {
+        RequestPool::LocalCache cache(pool);
+
+        return rounds([&](std::size_t i) { return cache.acquire(i); },
+                      [&](Request* r) { cache.release(r); });
+    });
+}
+
+static void BM_Lifecycle_PoolBatch(benchmark::State& state) {
+    RequestPool pool(4 * kRequests);
+
+    lifecycle(state, [&] {
+        std::uint64_t sum = 0;
+
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            IntrusiveList<Request> live;
+
+            pool.acquire_batch(kRequests, live);
+            sum += process(live);
+            pool.release_batch(live);
+        }
+
+        return sum;
+    });
+}
+
+BENCHMARK(BM_Lifecycle_NewDelete)->Apply(threads);
+BENCHMARK(BM_Lifecycle_Pool)->Apply(threads);
+BENCHMARK(BM_Lifecycle_PoolLocalCache)->Apply(threads);
+BENCHMARK(BM_Lifecycle_PoolBatch)->Apply(threads);
@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/prefetch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * Traversal of a list whose nodes are scattered over a heap much larger than the caches :
+ * kNodes cache-line sized nodes, linked in a shuffled order.
+ *
+ *  >> Scan_Plain    : range-for over the list
+ *  >> Scan_Prefetch : for_each_prefetch() with the given lookahead
+ *  >> Scan_Relayout : range-for after relayout() moved the nodes into one buffer
+ *
+ * work = 0 only sums a field, work > 0 adds that many rounds of hashing per node.
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+constexpr std::size_t kNodes = 1 << 18;
+
+struct alignas(64) ScanNode : IntrusiveListNode<DefaultTag, NormalLink> {
+    std::uint64_t value{0};
+
+    explicit ScanNode(std::uint64_t v) noexcept : value(v) {}
+
+    ScanNode(ScanNode&& other) noexcept : value(other.value) {}
+};
+
+using ScanList = IntrusiveList<ScanNode, CountingPolicy>;
+
+struct Scattered {
+    std::vector<std::unique_ptr<ScanNode>> nodes;
+    ScanList list;
+
+    Scattered() {
+        nodes.reserve(kNodes);
+
+        for (std::size_t i = 0; i < kNodes; ++i) {
+            nodes.push_back(std::make_unique<ScanNode>(i));
+        }
+
+        std::vector<ScanNode*> order;
+        order.reserve(kNodes);
+
+        for (auto& node : nodes) {
+            order.push_back(node.get());
+        }
+
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(42));
+
+        for (ScanNode* node : order) {
+            list.push_back(*node);
+        }
+    }
+
+    ~Scattered() {
+        list.clear();
+    }
+};
+
+inline std::uint64_t visit(const ScanNode& node, std::int64_t work) noexcept {
+    std::uint64_t h = node.value;
+
+    for (std::int64_t r = 0; r < work; ++r) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+    }
+
+    return h;
+}
+
+void workloads(benchmark::internal::Benchmark* b) {
+    b->ArgName("work");
+
+    for (std::int64_t work : {0, 16}) {
+        b->Arg(work);
+    }
+}
+
+void lookaheads(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"distance", "work"});
+
+    for (std::int64_t work : {0, 16}) {
+        for (std::int64_t distance : {2, 8, 32}) {
+            b->Args({distance, work});
+        }
+    }
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_Scan_Plain(benchmark::State& state) {
+    const std::int64_t work = state.range(0);
+    Scattered s;
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+
+        for (const ScanNode& node : s.list) {
+            sum += visit(node, work);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNodes));
+}
+
+static void BM_Scan_Prefetch(benchmark::State& state) {
+    const auto distance = static_cast<std::size_t>(state.range(0));
+    const std::int64_t work = state.range(1);
+    Scattered s;
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+
+        for_each_prefetch(s.list, [&](ScanNode& node) { sum += visit(node, work); }, distance);
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNodes));
+}
+
+static void BM_Scan_Relayout(benchmark::State& state) {
+    const std::int64_t work = state.range(0);
+    Scattered s;
+
+    std::allocator<ScanNode> alloc;
+
+    /* the originals stay owned by s.nodes */
+    ScanNode* buffer = relayout(s.list, alloc, [](ScanNode&) {});
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+
+        for (const ScanNode& node : s.list) {
+            sum += visit(node, work);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNodes));
+
+    s.list.clear();
+    alloc.deallocate(buffer, kNodes);
+}
+
+BENCHMARK(BM_Scan_Plain)->Apply(workloads);
+BENCHMARK(BM_Scan_Prefetch)->Apply(lookaheads);
+BENCHMARK(BM_Scan_Relayout)->Apply(workloads);
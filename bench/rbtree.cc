@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/rbtree.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+
+/**
+ * Order book churn : n live price levels, each operation cancels a random level
+ * and adds one at a new price, then looks a random price up.
+ *
+ *  >> Churn_IntrusiveRbTree : erase by reference + insert, no allocation
+ *  >> Churn_StdMap          : std::multimap<price, Level*>, erase by key + one node allocation per insert
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+struct Level : IntrusiveRbTreeNode<> {
+    std::int64_t price{0};
+};
+
+struct ByPrice {
+    bool operator()(const Level& a, const Level& b) const noexcept { return a.price < b.price; }
+    bool operator()(const Level& a, std::int64_t p) const noexcept { return a.price < p; }
+    bool operator()(std::int64_t p, const Level& b) const noexcept { return p < b.price; }
+};
+
+using Book = IntrusiveRbTree<Level, ByPrice>;
+
+void levels(benchmark::internal::Benchmark* b) {
+    b->ArgName("n");
+
+    for (std::int64_t n : {256, 16384, 1 << 20}) {
+        b->Arg(n);
+    }
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_Churn_IntrusiveRbTree(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto nodes = std::make_unique<Level[]>(n);
+
+    std::mt19937_64 rng(1);
+    Book book;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].price = static_cast<std::int64_t>(rng() >> 1);
+        book.insert(nodes[i]);
+    }
+
+    for (auto _ : state) {
+        Level& level = nodes[rng() % n];
+
+        book.erase(level);
+        level.price = static_cast<std::int64_t>(rng() >> 1);
+        book.insert(level);
+
+        benchmark::DoNotOptimize(book.lower_bound(static_cast<std::int64_t>(rng() >> 1)));
+    }
+
+    book.clear();
+}
+
+static void BM_Churn_StdMap(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto nodes = std::make_unique<Level[]>(n);
+
+    std::mt19937_64 rng(1);
+    std::multimap<std::int64_t, Level*> book;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].price = static_cast<std::int64_t>(rng() >> 1);
+        book.emplace(nodes[i].price, &nodes[i]);
+    }
+
+    for (auto _ : state) {
+        Level& level = nodes[rng() % n];
+
+        /* no handle back into the map : erase by key */
+        auto [first, last] = book.equal_range(level.price);
+
+        for (; first != last; ++first) {
+            if (first->second == &level) {
+                book.erase(first);
+                break;
+            }
+        }
+
+        level.price = static_cast<std::int64_t>(rng() >> 1);
+        book.emplace(level.price, &level);
+
+        benchmark::DoNotOptimize(book.lower_bound(static_cast<std::int64_t>(rng() >> 1)));
+    }
+}
+
+BENCHMARK(BM_Churn_IntrusiveRbTree)->Apply(levels);
+BENCHMARK(BM_Churn_StdMap)->Apply(levels);
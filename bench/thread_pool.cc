@@ -0,0 +1,200 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/thread_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Submit-to-execute : kBurst tasks submitted from outside the pool, timed until the last
+ * one has run. Every task stamps its submit and start times, the counters report the
+ * average and worst submit-to-start latency. Per argument : number of workers.
+ *
+ *  >> ThreadPool_Submit      : one submit() per task
+ *  >> ThreadPool_SubmitBatch : the burst linked into a list, one submit_batch()
+ *  >> NaiveExecutor          : the usual mutex + condvar + IntrusiveList executor,
+ *                              one notify_one() per task
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kBurst = 1 << 14;
+
+struct LatencyTask : PoolTask, IntrusiveListNode<> {
+    Clock::time_point submitted;
+    Clock::time_point started;
+    std::atomic<std::size_t>* done{nullptr};
+
+    void run() noexcept override {
+        started = Clock::now();
+        done->fetch_add(1, std::memory_order_release);
+    }
+};
+
+/* mutex + condvar + IntrusiveList, the executor every team writes first */
+class NaiveExecutor {
+  public:
+    explicit NaiveExecutor(std::size_t threads) {
+        for (std::size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([this] { loop(); });
+        }
+    }
+
+    ~NaiveExecutor() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+
+        cv_.notify_all();
+
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+
+    void submit(LatencyTask& task) {
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push_back(task);
+        }
+
+        cv_.notify_one();
+    }
+
+  private:
+    void loop() {
+        for (;;) {
+            LatencyTask* task = nullptr;
+
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+
+                if (queue_.empty()) {
+                    return;
+                }
+
+                task = queue_.try_pop_front();
+            }
+
+            task->run();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    IntrusiveList<LatencyTask> queue_;
+    bool stop_{false};
+    std::vector<std::thread> threads_;
+};
+
+void wait_all(const std::atomic<std::size_t>& done) {
+    while (done.load(std::memory_order_acquire) < kBurst) {
+        std::this_thread::yield();
+    }
+}
+
+template <typename Submit>
+void submit_to_execute(benchmark::State& state, Submit submit) {
+    auto tasks = std::make_unique<LatencyTask[]>(kBurst);
+
+    double total_ns = 0;
+    double worst_ns = 0;
+
+    for (auto _ : state) {
+        std::atomic<std::size_t> done{0};
+
+        for (std::size_t i = 0; i < kBurst; ++i) {
+            tasks[i].done = &done;
+        }
+
+        submit(tasks.get());
+        wait_all(done);
+
+        state.PauseTiming();
+
+        for (std::size_t i = 0; i < kBurst; ++i) {
+            const auto ns = std::chrono::duration<double, std::nano>(tasks[i].started -
+                                                                     tasks[i].submitted);
+            total_ns += ns.count();
+            worst_ns = std::max(worst_ns, ns.count());
+        }
+
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBurst));
+    state.counters["avg_latency_ns"] =
+        total_ns / static_cast<double>(state.iterations() * static_cast<std::int64_t>(kBurst));
+    state.counters["max_latency_ns"] = worst_ns;
+}
+
+void workers(benchmark::internal::Benchmark* b) {
+    b->ArgName("workers");
+
+    for (std::int64_t w : {1, 2, 4, 8}) {
+        b->Arg(w);
+    }
+
+    b->UseRealTime();
+    b->Unit(benchmark::kMicrosecond);
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_ThreadPool_Submit(benchmark::State& state) {
+    ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+
+    submit_to_execute(state, [&](LatencyTask* tasks) {
+        for (std::size_t i = 0; i < kBurst; ++i) {
+            tasks[i].submitted = Clock::now();
+            pool.submit(tasks[i]);
+        }
+    });
+}
+
+static void BM_ThreadPool_SubmitBatch(benchmark::State& state) {
+    ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+
+    submit_to_execute(state, [&](LatencyTask* tasks) {
+        ThreadPool::task_list batch;
+
+        const auto now = Clock::now();
+
+        for (std::size_t i = 0; i < kBurst; ++i) {
+            tasks[i].submitted = now;
+            batch.push_back(tasks[i]);
+        }
+
+        pool.submit_batch(batch);
+    });
+}
+
+static void BM_NaiveExecutor(benchmark::State& state) {
+    NaiveExecutor executor(static_cast<std::size_t>(state.range(0)));
+
+    submit_to_execute(state, [&](LatencyTask* tasks) {
+        for (std::size_t i = 0; i < kBurst; ++i) {
+            tasks[i].submitted = Clock::now();
+            executor.submit(tasks[i]);
+        }
+    });
+}
+
+BENCHMARK(BM_ThreadPool_Submit)->Apply(workers);
+BENCHMARK(BM_ThreadPool_SubmitBatch)->Apply(workers);
+BENCHMARK(BM_NaiveExecutor)->Apply(workers);
@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/heap.hpp>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/timer_wheel.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+/**
+ * Connection timeouts : n live timers, each operation re-arms one of them
+ * (cancel + schedule with a new deadline), the pattern of a timeout that is
+ * pushed back on every packet and almost never fires.
+ *
+ *  >> TimeoutRearm_TimerWheel   : IntrusiveTimerWheel, O(1) + O(1)
+ *  >> TimeoutRearm_PairingHeap  : IntrusivePairingHeap, erase O(log n) + push O(1)
+ *  >> TimeoutAdvance_TimerWheel : one tick of a wheel holding n timers, fired timers re-armed
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+struct WheelTimer : IntrusiveListNode<> {
+    std::uint64_t deadline{0};
+};
+
+struct HeapTimer : IntrusiveHeapNode<> {
+    std::uint64_t deadline{0};
+};
+
+struct ByDeadline {
+    bool operator()(const HeapTimer& a, const HeapTimer& b) const noexcept {
+        return a.deadline < b.deadline;
+    }
+};
+
+using Wheel = IntrusiveTimerWheel<WheelTimer>;
+
+/* 30 s timeouts in ms ticks */
+constexpr std::uint64_t kTimeout = 30'000;
+
+void timers(benchmark::internal::Benchmark* b) {
+    b->ArgName("n");
+
+    for (std::int64_t n : {256, 4096, 65536, 1 << 20}) {
+        b->Arg(n);
+    }
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_TimeoutRearm_TimerWheel(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto nodes = std::make_unique<WheelTimer[]>(n);
+
+    std::mt19937_64 rng(1);
+    Wheel wheel;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].deadline = kTimeout + rng() % kTimeout;
+        wheel.schedule(nodes[i]);
+    }
+
+    for (auto _ : state) {
+        WheelTimer& timer = nodes[rng() % n];
+
+        Wheel::cancel(timer);
+        timer.deadline = kTimeout + rng() % kTimeout;
+        wheel.schedule(timer);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_TimeoutRearm_PairingHeap(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto nodes = std::make_unique<HeapTimer[]>(n);
+
+    std::mt19937_64 rng(1);
+    IntrusivePairingHeap<HeapTimer, ByDeadline> heap;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].deadline = kTimeout + rng() % kTimeout;
+        heap.push(nodes[i]);
+    }
+
+    for (auto _ : state) {
+        HeapTimer& timer = nodes[rng() % n];
+
+        heap.erase(timer);
+        timer.deadline = kTimeout + rng() % kTimeout;
+        heap.push(timer);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    heap.clear();
+}
+
+static void BM_TimeoutAdvance_TimerWheel(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto nodes = std::make_unique<WheelTimer[]>(n);
+
+    std::mt19937_64 rng(1);
+    Wheel wheel;
+    IntrusiveList<WheelTimer> expired;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        nodes[i].deadline = 1 + rng() % kTimeout;
+        wheel.schedule(nodes[i]);
+    }
+
+    std::uint64_t now = 0;
+    std::int64_t fired = 0;
+
+    for (auto _ : state) {
+        wheel.advance(++now, expired);
+
+        while (WheelTimer* timer = expired.try_pop_front()) {
+            timer->deadline = now + kTimeout;
+            wheel.schedule(*timer);
+            ++fired;
+        }
+    }
+
+    state.counters["fired_per_tick"] =
+        benchmark::Counter(static_cast<double>(fired) / static_cast<double>(state.iterations()));
+}
+
+BENCHMARK(BM_TimeoutRearm_TimerWheel)->Apply(timers);
+BENCHMARK(BM_TimeoutRearm_PairingHeap)->Apply(timers);
+BENCHMARK(BM_TimeoutAdvance_TimerWheel)->Apply(timers);
@@ -0,0 +1,193 @@
+#include <benchmark/benchmark.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/work_stealing_deque.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * Fork/join : a complete binary tree of kTreeTasks tasks, task i spawns tasks 2i+1 and 2i+2
+ * into its worker's queue. Idle workers steal a batch from a random victim.
+ * Wall-clock time to run the whole tree, per argument : number of workers.
+ *
+ *  >> ForkJoin_WorkStealingDeque : owner push/pop without RMW, thieves steal_batch()
+ *  >> ForkJoin_MutexList         : per-worker std::mutex + IntrusiveList, thieves
+ *                                  lock the victim and extract_front() half of it
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+namespace {
+
+struct ForkTask : IntrusiveListNode<> {
+    std::size_t index{0};
+};
+
+constexpr std::size_t kTreeTasks = (std::size_t{1} << 18) - 1;
+constexpr std::size_t kStealBatch = 32;
+
+/* a few dozen ns of "work" per task */
+std::uint64_t work(std::size_t index) noexcept {
+    std::uint64_t x = index;
+
+    for (int i = 0; i < 32; ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    }
+
+    return x;
+}
+
+struct StealingWorker {
+    IntrusiveWorkStealingDeque<ForkTask, 4096> deque;
+    IntrusiveList<ForkTask> overflow;
+};
+
+struct MutexWorker {
+    std::mutex mutex;
+    IntrusiveList<ForkTask> queue;
+};
+
+template <typename Worker, typename Push, typename Pop, typename Steal>
+void fork_join(benchmark::State& state, Push push, Pop pop, Steal steal) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    auto tasks = std::make_unique<ForkTask[]>(kTreeTasks);
+
+    for (std::size_t i = 0; i < kTreeTasks; ++i) {
+        tasks[i].index = i;
+    }
+
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        for (std::size_t w = 0; w < n; ++w) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+
+        std::atomic<std::size_t> done{0};
+        std::atomic<std::uint64_t> checksum{0};
+
+        push(*workers[0], tasks[0]);
+
+        auto body = [&](std::size_t self) {
+            Worker& me = *workers[self];
+            std::minstd_rand rng(static_cast<unsigned>(self) + 1);
+            IntrusiveList<ForkTask> loot;
+            std::uint64_t sum = 0;
+
+            while (done.load(std::memory_order_relaxed) < kTreeTasks) {
+                ForkTask* task = pop(me);
+
+                if (task == nullptr && n > 1) {
+                    const std::size_t victim = rng() % n;
+
+                    if (victim != self && steal(*workers[victim], loot) > 0) {
+                        while (ForkTask* stolen = loot.try_pop_front()) {
+                            push(me, *stolen);
+                        }
+                    } else {
+                        /* oversubscribed runs : let the victims make progress */
+                        std::this_thread::yield();
+                    }
+
+                    continue;
+                }
+
+                if (task == nullptr) {
+                    continue;
+                }
+
+                sum += work(task->index);
+
+                for (std::size_t child : {2 * task->index + 1, 2 * task->index + 2}) {
+                    if (child < kTreeTasks) {
+                        push(me, tasks[child]);
+                    }
+                }
+
+                done.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            checksum.fetch_add(sum, std::memory_order_relaxed);
+        };
+
+        std::vector<std::thread> threads;
+
+        for (std::size_t w = 1; w < n; ++w) {
+            threads.emplace_back(body, w);
+        }
+
+        body(0);
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        benchmark::DoNotOptimize(checksum.load());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kTreeTasks));
+}
+
+void workers(benchmark::internal::Benchmark* b) {
+    b->ArgName("workers");
+
+    for (std::int64_t w : {1, 2, 4, 8, 16, 32, 64}) {
+        b->Arg(w);
+    }
+
+    b->UseRealTime();
+    b->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+static void BM_ForkJoin_WorkStealingDeque(benchmark::State& state) {
+    fork_join<StealingWorker>(
+        state,
+        [](StealingWorker& w, ForkTask& task) {
+            if (!w.deque.push(task)) {
+                w.overflow.push_back(task);
+            }
+        },
+        [](StealingWorker& w) -> ForkTask* {
+            if (ForkTask* task = w.deque.pop()) {
+                return task;
+            }
+
+            return w.overflow.try_pop_front();
+        },
+        [](StealingWorker& victim, IntrusiveList<ForkTask>& out) {
+            return victim.deque.steal_batch(out, kStealBatch);
+        });
+}
+
+static void BM_ForkJoin_MutexList(benchmark::State& state) {
+    fork_join<MutexWorker>(
+        state,
+        [](MutexWorker& w, ForkTask& task) {
+            std::lock_guard lock(w.mutex);
+            w.queue.push_back(task);
+        },
+        [](MutexWorker& w) -> ForkTask* {
+            std::lock_guard lock(w.mutex);
+            return w.queue.try_pop_back();
+        },
+        [](MutexWorker& victim, IntrusiveList<ForkTask>& out) {
+            std::lock_guard lock(victim.mutex);
+            const std::size_t half = (victim.queue.size() + 1) / 2;
+
+            return victim.queue.extract_front(out, std::min(kStealBatch, half));
+        });
+}
+
+BENCHMARK(BM_ForkJoin_WorkStealingDeque)->Apply(workers);
+BENCHMARK(BM_ForkJoin_MutexList)->Apply(workers);
@@ -0,0 +1,434 @@
+#pragma once
+
+#include "list.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Bump allocator over a chain of chunks : allocation is a pointer increment,
+ * everything is dropped at once by reset().
+ *
+ *   head_ -> [ Chunk | used ...... ] -> [ Chunk | used ... | free    ] -> [ Chunk | spare ]
+ *                                               current_ ^    cursor_ ^
+ *
+ *  >> allocate() / create() : O(1), a new chunk only when the current one is full
+ *  >> reset()               : O(1) in release builds, chunks are kept for the next round
+ *  >> release()             : reset() + chunks handed back to the system
+ *
+ * Destructors of the objects are NOT run : an Arena is for objects whose whole
+ * lifetime fits in one round (a request, a frame, a pass) and that own nothing
+ * outside the arena.
+ *
+ * >> USAGE :
+ *  Arena arena;
+ *
+ *  for (;;) {
+ *    ArenaList<Node> pending(arena);
+ *    pending.emplace_back(...);
+ *    ...
+ *    // pending dies, then
+ *    arena.reset();
+ *  }
+ */
+class Arena {
+  public:
+    using size_type = std::size_t;
+
+    static constexpr size_type kDefaultChunkSize = 64 * 1024;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    explicit Arena(size_type chunk_size = kDefaultChunkSize) noexcept;
+
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    Arena(Arena&&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @throws std::bad_alloc when a new chunk cannot be allocated.
+     */
+    [[nodiscard]]
+    void* allocate(size_type bytes, size_type align = alignof(std::max_align_t));
+
+    /**
+     * @brief T(args...) in arena memory. Its destructor will never run.
+     */
+    template <typename T, typename... Args>
+    [[nodiscard]]
+    auto create(Args&&... args) -> T*;
+
+    /**
+     * @brief Drops every allocation, the chunks stay for reuse.
+     *
+     * No ArenaList may still be bound to the arena (asserted). Debug builds also
+     * scribble over the dropped memory, so a stale node is caught early.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief reset(), then frees every chunk.
+     */
+    void release() noexcept;
+
+    /**
+     * @brief Does p point into memory handed out since the last reset() ? O(chunks).
+     */
+    [[nodiscard]]
+    bool owns(const void* p) const noexcept;
+
+    /**
+     * @brief Bytes handed out since the last reset(), alignment padding included.
+     */
+    [[nodiscard]]
+    auto used() const noexcept -> size_type;
+
+    [[nodiscard]]
+    auto chunk_count() const noexcept -> size_type;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    struct Chunk {
+        Chunk* next;
+        size_type size; /* usable bytes after the header */
+        size_type used; /* bytes used, valid for the chunks before current_ */
+
+        [[nodiscard]] std::byte* data() noexcept;
+        [[nodiscard]] const std::byte* data() const noexcept;
+    };
+
+    static constexpr size_type kHeaderSize =
+        (sizeof(Chunk) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+        alignof(std::max_align_t);
+
+    /* slow path of allocate() : moves to the next chunk that fits, or chains a new one */
+    void* allocate_slow(size_type bytes, size_type align);
+
+    void enter(Chunk* chunk) noexcept;
+
+    /* bound ArenaLists, for the lifetime checks */
+    void bind() noexcept;
+    void unbind() noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    size_type chunk_size_;
+
+    Chunk* head_{nullptr};
+    Chunk* current_{nullptr};
+
+    std::byte* cursor_{nullptr};
+    std::byte* end_{nullptr};
+
+    size_type bound_lists_{0};
+
+    template <typename, typename...>
+    friend class ArenaList;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief IntrusiveList of nodes living in an Arena : nothing is ever unlinked one by one.
+ *
+ * A NormalLink IntrusiveList, bound to its arena : clear() and the destructor are the
+ * plain O(1) ones of NormalLink hooks, the nodes die with the arena anyway.
+ *
+ * Debug builds check that the list is gone before the arena is reset, and that every
+ * node linked one by one comes from the arena :
+ *
+ *  >> checked   : push_back(), push_front(), insert(), insert_range(), push_back_range(), emplace_back()
+ *  >> unchecked : splice(), splice_cell(), splice_range() and the extract / split family,
+ *                 which move whole chains in O(1) : only feed them lists of the same arena
+ *
+ * >> USAGE :
+ *  struct Node : IntrusiveListNode<DefaultTag, NormalLink> { ... };
+ *
+ *  ArenaList<Node> list(arena);
+ *  list.emplace_back(args...);
+ */
+template <typename T, typename... Options>
+class ArenaList : public IntrusiveList<T, Options...> {
+    using base_type = IntrusiveList<T, Options...>;
+
+    static_assert(!base_type::link_mode::is_safe,
+                  "ArenaList needs NormalLink hooks : its nodes are dropped, never unlinked");
+
+  public:
+    using typename base_type::reference;
+    using typename base_type::size_type;
+    using typename base_type::iterator;
+    using typename base_type::const_iterator;
+
+    explicit ArenaList(Arena& arena) noexcept;
+
+    ~ArenaList();
+
+    void push_back(reference element) noexcept;
+
+    void push_front(reference element) noexcept;
+
+    auto insert(const_iterator pos, reference element) noexcept -> iterator;
+
+    template <typename InputIt>
+    auto insert_range(const_iterator pos, InputIt first, InputIt last) noexcept -> iterator;
+
+    template <typename InputIt>
+    void push_back_range(InputIt first, InputIt last) noexcept;
+
+    /**
+     * @brief Creates a T(args...) in the arena and appends it.
+     */
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> reference;
+
+    [[nodiscard]]
+    auto arena() const noexcept -> Arena&;
+
+  private:
+    Arena& arena_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+inline std::byte* Arena::Chunk::data() noexcept {
+    return reinterpret_cast<std::byte*>(this) + kHeaderSize;
+}
+
+inline const std::byte* Arena::Chunk::data() const noexcept {
+    return reinterpret_cast<const std::byte*>(this) + kHeaderSize;
+}
+
+inline Arena::Arena(size_type chunk_size) noexcept : chunk_size_(chunk_size) {}
+
+inline Arena::~Arena() {
+    release();
+}
+
+inline void Arena::enter(Chunk* chunk) noexcept {
+    current_ = chunk;
+    cursor_ = chunk->data();
+    end_ = chunk->data() + chunk->size;
+}
+
+inline void* Arena::allocate(size_type bytes, size_type align) {
+    assert(align != 0 && (align & (align - 1)) == 0 && "alignment must be a power of two...");
+
+    if (cursor_ != nullptr) {
+        const auto addr = reinterpret_cast<std::uintptr_t>(cursor_);
+        const size_type pad = (align - (addr & (align - 1))) & (align - 1);
+
+        if (pad + bytes <= static_cast<size_type>(end_ - cursor_)) {
+            std::byte* p = cursor_ + pad;
+            cursor_ = p + bytes;
+            return p;
+        }
+    }
+
+    return allocate_slow(bytes, align);
+}
+
+inline void* Arena::allocate_slow(size_type bytes, size_type align) {
+    /* worst case padding included */
+    const size_type need = bytes + align - 1;
+
+    if (current_ != nullptr) {
+        current_->used = static_cast<size_type>(cursor_ - current_->data());
+    }
+
+    Chunk* next = (current_ != nullptr) ? current_->next : head_;
+
+    /* chunks kept by reset() : take the next one if it fits, it is empty */
+    if (next == nullptr || next->size < need) {
+        const size_type size = std::max(chunk_size_, need);
+
+        void* raw = ::operator new(kHeaderSize + size);
+        Chunk* chunk = ::new (raw) Chunk{next, size, 0};
+
+        if (current_ != nullptr) {
+            current_->next = chunk;
+        } else {
+            head_ = chunk;
+        }
+
+        next = chunk;
+    }
+
+    enter(next);
+
+    return allocate(bytes, align);
+}
+
+template <typename T, typename... Args>
+auto Arena::create(Args&&... args) -> T* {
+    void* p = allocate(sizeof(T), alignof(T));
+
+    return ::new (p) T(std::forward<Args>(args)...);
+}
+
+inline void Arena::reset() noexcept {
+    assert(bound_lists_ == 0 && "Arena reset while an ArenaList still uses it...");
+
+    if (head_ == nullptr) {
+        return;
+    }
+
+    #ifndef NDEBUG
+    /* scribble over what was handed out : a node that outlived the reset is now garbage */
+    for (Chunk* chunk = head_; chunk != current_; chunk = chunk->next) {
+        std::memset(chunk->data(), 0xA5, chunk->used);
+    }
+
+    std::memset(current_->data(), 0xA5, static_cast<size_type>(cursor_ - current_->data()));
+    #endif
+
+    enter(head_);
+}
+
+inline void Arena::release() noexcept {
+    reset();
+
+    while (head_ != nullptr) {
+        Chunk* next = head_->next;
+        ::operator delete(static_cast<void*>(head_));
+        head_ = next;
+    }
+
+    current_ = nullptr;
+    cursor_ = nullptr;
+    end_ = nullptr;
+}
+
+inline bool Arena::owns(const void* p) const noexcept {
+    const auto* b = static_cast<const std::byte*>(p);
+
+    for (const Chunk* chunk = head_; chunk != nullptr; chunk = chunk->next) {
+        const std::byte* last =
+            (chunk == current_) ? cursor_ : chunk->data() + chunk->used;
+
+        if (b >= chunk->data() && b < last) {
+            return true;
+        }
+
+        if (chunk == current_) {
+            break;
+        }
+    }
+
+    return false;
+}
+
+inline auto Arena::used() const noexcept -> size_type {
+    size_type total = 0;
+
+    for (const Chunk* chunk = head_; chunk != nullptr; chunk = chunk->next) {
+        if (chunk == current_) {
+            return total + static_cast<size_type>(cursor_ - chunk->data());
+        }
+
+        total += chunk->used;
+    }
+
+    return total;
+}
+
+inline auto Arena::chunk_count() const noexcept -> size_type {
+    size_type cnt = 0;
+
+    for (const Chunk* chunk = head_; chunk != nullptr; chunk = chunk->next) {
+        ++cnt;
+    }
+
+    return cnt;
+}
+
+inline void Arena::bind() noexcept {
+    ++bound_lists_;
+}
+
+inline void Arena::unbind() noexcept {
+    assert(bound_lists_ > 0 && "unbalanced ArenaList bookkeeping...");
+    --bound_lists_;
+}
+
+/*---*---*---*---*---*---*---* ArenaList *---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+ArenaList<T, Options...>::ArenaList(Arena& arena) noexcept : arena_(arena) {
+    arena_.bind();
+}
+
+template <typename T, typename... Options>
+ArenaList<T, Options...>::~ArenaList() {
+    arena_.unbind();
+}
+
+template <typename T, typename... Options>
+void ArenaList<T, Options...>::push_back(reference element) noexcept {
+    assert(arena_.owns(&element) && "ArenaList::push_back() of a node outside its arena...");
+    base_type::push_back(element);
+}
+
+template <typename T, typename... Options>
+void ArenaList<T, Options...>::push_front(reference element) noexcept {
+    assert(arena_.owns(&element) && "ArenaList::push_front() of a node outside its arena...");
+    base_type::push_front(element);
+}
+
+template <typename T, typename... Options>
+auto ArenaList<T, Options...>::insert(const_iterator pos, reference element) noexcept -> iterator {
+    assert(arena_.owns(&element) && "ArenaList::insert() of a node outside its arena...");
+    return base_type::insert(pos, element);
+}
+
+template <typename T, typename... Options>
+template <typename InputIt>
+auto ArenaList<T, Options...>::insert_range(const_iterator pos, InputIt first,
+                                            InputIt last) noexcept -> iterator {
+    iterator inserted = base_type::insert_range(pos, first, last);
+
+    #ifndef NDEBUG
+    /* checked after the fact : [first, last) may be single pass */
+    for (const_iterator it = inserted; it != pos; ++it) {
+        assert(arena_.owns(&*it) && "ArenaList::insert_range() of a node outside its arena...");
+    }
+    #endif
+
+    return inserted;
+}
+
+template <typename T, typename... Options>
+template <typename InputIt>
+void ArenaList<T, Options...>::push_back_range(InputIt first, InputIt last) noexcept {
+    insert_range(base_type::cend(), first, last);
+}
+
+template <typename T, typename... Options>
+template <typename... Args>
+auto ArenaList<T, Options...>::emplace_back(Args&&... args) -> reference {
+    T* element = arena_.template create<T>(std::forward<Args>(args)...);
+    base_type::push_back(*element);
+
+    return *element;
+}
+
+template <typename T, typename... Options>
+auto ArenaList<T, Options...>::arena() const noexcept -> Arena& {
+    return arena_;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
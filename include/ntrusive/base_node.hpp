@@ -42,11 +42,26 @@ struct NodeBase {
      */
     void unlink_base() noexcept;
 
+    /**
+     * @brief Unlinks this node from its neighbors without resetting it.
+     *
+     * Same as unlink_base(), but this node keeps its (now stale) prev/next.
+     * Two stores instead of four.
+     */
+    void unlink_base_fast() noexcept;
+
+    /**
+     * @brief Forgets the neighbors without touching them.
+     *
+     * Only valid when the neighbors are being dropped as well (bulk detach).
+     */
+    void reset_base() noexcept;
+
     /**
      * @brief Checks if node appears to be linked (has neighbors).
      *
-     * Note: This is a basic check. For proper tracking, use
-     * IntrusiveListNode with TrackingPolicy.
+     * Exact for hooks that are reset on unlink (SafeLink / AutoUnlink),
+     * meaningless for NormalLink ones which keep stale pointers.
      */
     [[nodiscard]]
     bool is_linked_base() const noexcept;
@@ -124,6 +139,16 @@ inline void NodeBase::unlink_base() noexcept {
     next_ = nullptr;
 }
 
+inline void NodeBase::unlink_base_fast() noexcept {
+    prev_->next_ = next_;
+    next_->prev_ = prev_;
+}
+
+inline void NodeBase::reset_base() noexcept {
+    prev_ = nullptr;
+    next_ = nullptr;
+}
+
 inline bool NodeBase::is_linked_base() const noexcept {
     return next_ != nullptr;
 }
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Assumed cache line size, used to keep producer and consumer sides
+ * of the concurrent containers on separate lines.
+ *
+ * (std::hardware_destructive_interference_size is not ABI-stable across
+ * compiler flags, so it is not used here.)
+ */
+inline constexpr std::size_t kCacheLineSize = 64;
@@ -0,0 +1,590 @@
+#pragma once
+
+#include "list.hpp"
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+/**
+ * @brief Hook tag of suspended coroutines : run queue and wait-lists share it,
+ * a suspended coroutine is in exactly one of them.
+ */
+struct CoroTag {};
+
+class CoroScheduler;
+
+/**
+ * @brief A suspension point, living in the coroutine frame : the frame IS the list node.
+ *
+ * Every awaitable of this header derives from it, co_await keeps the awaiter in the
+ * suspended frame, so suspending is a push_back of the awaiter and nothing else.
+ *
+ *  >> waiting()   : parked in a wait-list (AsyncMutex, AsyncEvent, AsyncSemaphore)
+ *  >> cancelled() : woken by CoroScheduler::cancel() instead of the primitive
+ */
+class CoroAwaiter : public IntrusiveListNode<CoroTag, SafeLink> {
+  public:
+    [[nodiscard]] bool waiting() const noexcept;
+
+    [[nodiscard]] bool cancelled() const noexcept;
+
+  protected:
+    CoroAwaiter() noexcept = default;
+
+    ~CoroAwaiter() = default;
+
+    /* parks the suspending coroutine h at the back of waiters */
+    void wait_on(IntrusiveList<CoroAwaiter, BaseHook<CoroTag>>& waiters,
+                 std::coroutine_handle<> h) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    std::coroutine_handle<> handle_;
+    bool waiting_{false};
+    bool cancelled_{false};
+
+    friend class CoroScheduler;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Fire-and-forget coroutine, started by CoroScheduler::spawn().
+ *
+ * The promise is a CoroAwaiter too : spawning links the frame itself into the run
+ * queue. The frame frees itself when the body returns, an exception terminates.
+ *
+ * >> USAGE :
+ *  CoroTask session(CoroScheduler& sched, AsyncMutex& mutex) {
+ *    co_await mutex.lock();
+ *    ...
+ *    mutex.unlock();
+ *  }
+ *
+ *  sched.spawn(session(sched, mutex));
+ */
+class CoroTask {
+  public:
+    struct promise_type : CoroAwaiter {
+        auto get_return_object() noexcept -> CoroTask;
+
+        auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+
+        auto final_suspend() noexcept -> std::suspend_never { return {}; }
+
+        void return_void() noexcept {}
+
+        [[noreturn]] void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    CoroTask(CoroTask&& other) noexcept;
+
+    CoroTask& operator=(CoroTask&&) = delete;
+
+    CoroTask(const CoroTask&) = delete;
+    CoroTask& operator=(const CoroTask&) = delete;
+
+    /* a task that was never spawned is destroyed without running */
+    ~CoroTask();
+
+  private:
+    explicit CoroTask(handle_type handle) noexcept;
+
+    handle_type handle_;
+
+    friend class CoroScheduler;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Single-threaded coroutine scheduler : an IntrusiveList run queue of awaiters.
+ *
+ *   spawn() / yield() / wake()          run_one()
+ *            |                              |
+ *            v                              v
+ *   [ awaiter <-> awaiter <-> ... ]  -- try_pop_front() --> handle.resume()
+ *
+ *  >> spawn()    : O(1), links the new frame's promise
+ *  >> yield()    : O(1), the current coroutine goes to the back of the queue
+ *  >> wake_all() : one splice of a whole wait-list
+ *  >> cancel()   : O(1), IntrusiveList::remove() from whatever wait-list holds the awaiter
+ *
+ * Nothing is allocated besides the coroutine frames themselves. One scheduler per
+ * thread : neither the scheduler nor the primitives below are thread-safe.
+ *
+ * >> USAGE :
+ *  CoroScheduler sched;
+ *
+ *  sched.spawn(worker(sched));
+ *  sched.run();
+ */
+class CoroScheduler {
+  public:
+    using size_type = std::size_t;
+    using wait_list = IntrusiveList<CoroAwaiter, BaseHook<CoroTag>>;
+
+    class YieldAwaiter : public CoroAwaiter {
+      public:
+        explicit YieldAwaiter(CoroScheduler& scheduler) noexcept : scheduler_(scheduler) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> h) noexcept;
+
+        void await_resume() const noexcept {}
+
+      private:
+        CoroScheduler& scheduler_;
+    };
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    CoroScheduler() noexcept = default;
+
+    ~CoroScheduler();
+
+    CoroScheduler(const CoroScheduler&) = delete;
+    CoroScheduler& operator=(const CoroScheduler&) = delete;
+
+    CoroScheduler(CoroScheduler&&) = delete;
+    CoroScheduler& operator=(CoroScheduler&&) = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief Queues the start of task.
+     */
+    void spawn(CoroTask task) noexcept;
+
+    /**
+     * @brief co_await sched.yield() : lets every coroutine already queued run first.
+     */
+    [[nodiscard]]
+    auto yield() noexcept -> YieldAwaiter;
+
+    /**
+     * @brief Queues a parked awaiter, unlinked by the caller from its wait-list.
+     */
+    void wake(CoroAwaiter& awaiter) noexcept;
+
+    /**
+     * @brief Queues every awaiter of waiters, in order, leaving it empty.
+     */
+    void wake_all(wait_list& waiters) noexcept;
+
+    /**
+     * @brief Takes a parked awaiter out of its wait-list and queues it, its co_await
+     * then reports the failure (false).
+     *
+     * @return false if awaiter was not parked (already woken, or running).
+     */
+    bool cancel(CoroAwaiter& awaiter) noexcept;
+
+    /**
+     * @brief Resumes the coroutine at the front of the run queue.
+     *
+     * @return false if the run queue was empty.
+     */
+    bool run_one() noexcept;
+
+    /**
+     * @brief Resumes coroutines until the run queue is empty.
+     *
+     * @return Number of resumptions.
+     */
+    auto run() noexcept -> size_type;
+
+    [[nodiscard]] bool empty() const noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    void post(CoroAwaiter& awaiter, std::coroutine_handle<> h) noexcept;
+
+    wait_list ready_;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief FIFO coroutine mutex : unlock() hands the lock straight to the oldest waiter.
+ *
+ * >> USAGE :
+ *  const bool locked = co_await mutex.lock();  // false : cancelled
+ *
+ *  if (locked) {
+ *    ...
+ *    mutex.unlock();
+ *  }
+ */
+class AsyncMutex {
+  public:
+    class LockAwaiter : public CoroAwaiter {
+      public:
+        explicit LockAwaiter(AsyncMutex& mutex) noexcept : mutex_(mutex) {}
+
+        bool await_ready() noexcept { return mutex_.try_lock(); }
+
+        void await_suspend(std::coroutine_handle<> h) noexcept { wait_on(mutex_.waiters_, h); }
+
+        /* true : locked, false : cancelled */
+        bool await_resume() const noexcept { return !cancelled(); }
+
+      private:
+        AsyncMutex& mutex_;
+    };
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    explicit AsyncMutex(CoroScheduler& scheduler) noexcept : scheduler_(scheduler) {}
+
+    ~AsyncMutex();
+
+    AsyncMutex(const AsyncMutex&) = delete;
+    AsyncMutex& operator=(const AsyncMutex&) = delete;
+
+    [[nodiscard]]
+    auto lock() noexcept -> LockAwaiter;
+
+    [[nodiscard]] bool try_lock() noexcept;
+
+    void unlock() noexcept;
+
+    [[nodiscard]] bool locked() const noexcept;
+
+  private:
+    CoroScheduler& scheduler_;
+    CoroScheduler::wait_list waiters_;
+    bool locked_{false};
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Manual-reset coroutine event : set() wakes every waiter with one splice.
+ */
+class AsyncEvent {
+  public:
+    class WaitAwaiter : public CoroAwaiter {
+      public:
+        explicit WaitAwaiter(AsyncEvent& event) noexcept : event_(event) {}
+
+        bool await_ready() const noexcept { return event_.is_set(); }
+
+        void await_suspend(std::coroutine_handle<> h) noexcept { wait_on(event_.waiters_, h); }
+
+        /* true : set, false : cancelled */
+        bool await_resume() const noexcept { return !cancelled(); }
+
+      private:
+        AsyncEvent& event_;
+    };
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    explicit AsyncEvent(CoroScheduler& scheduler) noexcept : scheduler_(scheduler) {}
+
+    ~AsyncEvent();
+
+    AsyncEvent(const AsyncEvent&) = delete;
+    AsyncEvent& operator=(const AsyncEvent&) = delete;
+
+    [[nodiscard]]
+    auto wait() noexcept -> WaitAwaiter;
+
+    void set() noexcept;
+
+    void reset() noexcept;
+
+    [[nodiscard]] bool is_set() const noexcept;
+
+  private:
+    CoroScheduler& scheduler_;
+    CoroScheduler::wait_list waiters_;
+    bool set_{false};
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Counting coroutine semaphore, FIFO : release() hands permits to the oldest waiters.
+ */
+class AsyncSemaphore {
+  public:
+    using size_type = std::size_t;
+
+    class AcquireAwaiter : public CoroAwaiter {
+      public:
+        explicit AcquireAwaiter(AsyncSemaphore& semaphore) noexcept : semaphore_(semaphore) {}
+
+        bool await_ready() noexcept { return semaphore_.try_acquire(); }
+
+        void await_suspend(std::coroutine_handle<> h) noexcept {
+            wait_on(semaphore_.waiters_, h);
+        }
+
+        /* true : acquired, false : cancelled */
+        bool await_resume() const noexcept { return !cancelled(); }
+
+      private:
+        AsyncSemaphore& semaphore_;
+    };
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    AsyncSemaphore(CoroScheduler& scheduler, size_type permits) noexcept
+        : scheduler_(scheduler), permits_(permits) {}
+
+    ~AsyncSemaphore();
+
+    AsyncSemaphore(const AsyncSemaphore&) = delete;
+    AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+
+    [[nodiscard]]
+    auto acquire() noexcept -> AcquireAwaiter;
+
+    [[nodiscard]] bool try_acquire() noexcept;
+
+    void release(size_type n = 1) noexcept;
+
+    [[nodiscard]]
+    auto available() const noexcept -> size_type;
+
+  private:
+    CoroScheduler& scheduler_;
+    CoroScheduler::wait_list waiters_;
+    size_type permits_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+inline bool CoroAwaiter::waiting() const noexcept {
+    return waiting_;
+}
+
+inline bool CoroAwaiter::cancelled() const noexcept {
+    return cancelled_;
+}
+
+inline void CoroAwaiter::wait_on(IntrusiveList<CoroAwaiter, BaseHook<CoroTag>>& waiters,
+                                 std::coroutine_handle<> h) noexcept {
+    handle_ = h;
+    waiting_ = true;
+    waiters.push_back(*this);
+}
+
+/*---*---*---*---*---*---*---* CoroTask *---*---*---*---*---*---*---*/
+
+inline auto CoroTask::promise_type::get_return_object() noexcept -> CoroTask {
+    return CoroTask(handle_type::from_promise(*this));
+}
+
+inline CoroTask::CoroTask(handle_type handle) noexcept : handle_(handle) {}
+
+inline CoroTask::CoroTask(CoroTask&& other) noexcept
+    : handle_(std::exchange(other.handle_, nullptr)) {}
+
+inline CoroTask::~CoroTask() {
+    if (handle_) {
+        handle_.destroy();
+    }
+}
+
+/*---*---*---*---*---*---*---* CoroScheduler *---*---*---*---*---*---*---*/
+
+inline CoroScheduler::~CoroScheduler() {
+    assert(ready_.empty() && "destroying CoroScheduler with queued coroutines...");
+}
+
+inline void CoroScheduler::post(CoroAwaiter& awaiter, std::coroutine_handle<> h) noexcept {
+    awaiter.handle_ = h;
+    ready_.push_back(awaiter);
+}
+
+inline void CoroScheduler::YieldAwaiter::await_suspend(std::coroutine_handle<> h) noexcept {
+    scheduler_.post(*this, h);
+}
+
+inline auto CoroScheduler::yield() noexcept -> YieldAwaiter {
+    return YieldAwaiter(*this);
+}
+
+inline void CoroScheduler::spawn(CoroTask task) noexcept {
+    /* the frame now belongs to the run queue, then to itself */
+    CoroTask::handle_type h = std::exchange(task.handle_, nullptr);
+
+    post(h.promise(), h);
+}
+
+inline void CoroScheduler::wake(CoroAwaiter& awaiter) noexcept {
+    assert(!awaiter.is_linked() && "wake() : unlink the awaiter from its wait-list first...");
+
+    awaiter.waiting_ = false;
+    ready_.push_back(awaiter);
+}
+
+inline void CoroScheduler::wake_all(wait_list& waiters) noexcept {
+    for (CoroAwaiter& awaiter : waiters) {
+        awaiter.waiting_ = false;
+    }
+
+    ready_.splice(ready_.cend(), waiters);
+}
+
+inline bool CoroScheduler::cancel(CoroAwaiter& awaiter) noexcept {
+    if (!awaiter.waiting_) {
+        return false;
+    }
+
+    /* no reference to the wait-list needed : it is not counting */
+    wait_list::remove(awaiter);
+
+    awaiter.waiting_ = false;
+    awaiter.cancelled_ = true;
+    ready_.push_back(awaiter);
+
+    return true;
+}
+
+inline bool CoroScheduler::run_one() noexcept {
+    CoroAwaiter* awaiter = ready_.try_pop_front();
+
+    if (awaiter == nullptr) {
+        return false;
+    }
+
+    /* the awaiter may die inside resume() : read the handle first */
+    std::coroutine_handle<> h = awaiter->handle_;
+    h.resume();
+
+    return true;
+}
+
+inline auto CoroScheduler::run() noexcept -> size_type {
+    size_type cnt = 0;
+
+    while (run_one()) {
+        ++cnt;
+    }
+
+    return cnt;
+}
+
+inline bool CoroScheduler::empty() const noexcept {
+    return ready_.empty();
+}
+
+/*---*---*---*---*---*---*---* AsyncMutex *---*---*---*---*---*---*---*/
+
+inline AsyncMutex::~AsyncMutex() {
+    assert(waiters_.empty() && "destroying AsyncMutex with waiting coroutines...");
+}
+
+inline auto AsyncMutex::lock() noexcept -> LockAwaiter {
+    return LockAwaiter(*this);
+}
+
+inline bool AsyncMutex::try_lock() noexcept {
+    if (locked_) {
+        return false;
+    }
+
+    locked_ = true;
+
+    return true;
+}
+
+inline void AsyncMutex::unlock() noexcept {
+    assert(locked_ && "unlock() of an unlocked AsyncMutex...");
+
+    /* handoff : the mutex stays locked, on behalf of the oldest waiter */
+    if (CoroAwaiter* next = waiters_.try_pop_front()) {
+        scheduler_.wake(*next);
+        return;
+    }
+
+    locked_ = false;
+}
+
+inline bool AsyncMutex::locked() const noexcept {
+    return locked_;
+}
+
+/*---*---*---*---*---*---*---* AsyncEvent *---*---*---*---*---*---*---*/
+
+inline AsyncEvent::~AsyncEvent() {
+    assert(waiters_.empty() && "destroying AsyncEvent with waiting coroutines...");
+}
+
+inline auto AsyncEvent::wait() noexcept -> WaitAwaiter {
+    return WaitAwaiter(*this);
+}
+
+inline void AsyncEvent::set() noexcept {
+    set_ = true;
+    scheduler_.wake_all(waiters_);
+}
+
+inline void AsyncEvent::reset() noexcept {
+    set_ = false;
+}
+
+inline bool AsyncEvent::is_set() const noexcept {
+    return set_;
+}
+
+/*---*---*---*---*---*---*---* AsyncSemaphore *---*---*---*---*---*---*---*/
+
+inline AsyncSemaphore::~AsyncSemaphore() {
+    assert(waiters_.empty() && "destroying AsyncSemaphore with waiting coroutines...");
+}
+
+inline auto AsyncSemaphore::acquire() noexcept -> AcquireAwaiter {
+    return AcquireAwaiter(*this);
+}
+
+inline bool AsyncSemaphore::try_acquire() noexcept {
+    if (permits_ == 0) {
+        return false;
+    }
+
+    --permits_;
+
+    return true;
+}
+
+inline void AsyncSemaphore::release(size_type n) noexcept {
+    /* waiters first : a permit never sits idle while someone waits for it */
+    while (n > 0) {
+        CoroAwaiter* next = waiters_.try_pop_front();
+
+        if (next == nullptr) {
+            break;
+        }
+
+        scheduler_.wake(*next);
+        --n;
+    }
+
+    permits_ += n;
+}
+
+inline auto AsyncSemaphore::available() const noexcept -> size_type {
+    return permits_;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
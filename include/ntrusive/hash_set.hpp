@@ -0,0 +1,417 @@
+#pragma once
+
+#include "list.hpp"
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+/**
+ * @brief Intrusive hash set, separate chaining through an IntrusiveList<...> hook of T.
+ *
+ * Every bucket is an IntrusiveList (a 16-byte sentinel head), the bucket array
+ * is provided by the user : the table never allocates, it can live in an arena,
+ * in static storage or next to the objects.
+ *
+ *  >> insert()  : O(1) average, refuses duplicates
+ *  >> find()    : O(1) average, heterogeneous : find(key) works as soon as Hash(key)
+ *                 and Eq(key, element) do
+ *  >> erase()   : O(1), through the element's own hook
+ *  >> remove()  : static, the self-removal idiom of IntrusiveList::remove()
+ *  >> rehash()  : O(1), switches to a new bucket array INCREMENTALLY
+ *
+ * Incremental rehash : rehash(new_buckets) only records the new array. Every insert()
+ * and erase() then migrates kRehashStep old buckets (splice_cell, element by element,
+ * no copies), so no single operation pays for the whole table :
+ *
+ *   old : [ moved | moved | cursor | ... | ... ]      bucket >= cursor : still in old
+ *   new : [ ...   | ...   | ...    | ... | ... | ... ] bucket <  cursor : already in new
+ *
+ * Lookups probe the one table their key currently lives in. Once rehashing() is
+ * false, the old array is no longer referenced and may be reused or freed.
+ *
+ * @tparam Hash    Hash of T (and of any key type used with find())
+ * @tparam Eq      Equality of T (and of (key, T) for find())
+ * @tparam Options Same as IntrusiveList : a hook option (the hook the buckets chain through)
+ *                 and/or a size policy (the set's own counter, buckets never count).
+ *
+ * >> USAGE :
+ *  struct Entry : IntrusiveListNode<> {
+ *    std::uint64_t id;
+ *  };
+ *
+ *  using Set = IntrusiveHashSet<Entry, EntryHash, EntryEq>;
+ *
+ *  Set::bucket_type buckets[1024];
+ *  Set set(buckets);
+ */
+template <typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<T>,
+          typename... Options>
+class IntrusiveHashSet {
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+
+    using hasher = Hash;
+    using key_equal = Eq;
+
+    using hook = typename ListOptions<T, Options...>::hook;
+    using size_policy = typename ListOptions<T, Options...>::size_policy;
+
+    using bucket_type = IntrusiveList<T, hook>;
+
+    static_assert(!(size_policy::is_counting && bucket_type::link_mode::is_auto_unlink),
+                  "CountingPolicy needs NormalLink or SafeLink hooks: "
+                  "an AutoUnlink hook would leave the set behind the counter's back");
+
+    /* old buckets migrated by every insert() / erase() while rehashing */
+    static constexpr size_type kRehashStep = 4;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @param buckets Bucket storage, a power of two of them, must outlive the set.
+     */
+    explicit IntrusiveHashSet(std::span<bucket_type> buckets, const Hash& hash = {},
+                              const Eq& eq = {}) noexcept;
+
+    ~IntrusiveHashSet();
+
+    IntrusiveHashSet(const IntrusiveHashSet&) = delete;
+    IntrusiveHashSet& operator=(const IntrusiveHashSet&) = delete;
+
+    IntrusiveHashSet(IntrusiveHashSet&&) noexcept = delete;
+    IntrusiveHashSet& operator=(IntrusiveHashSet&&) noexcept = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief Links element unless an equal one is already in the set.
+     *
+     * @return true if element was inserted.
+     */
+    bool insert(reference element) noexcept;
+
+    /**
+     * @brief Unlinks an element known to be in THIS set.
+     */
+    void erase(reference element) noexcept;
+
+    /**
+     * @brief Unlinks element from whatever set holds it.
+     *
+     * Not available with CountingPolicy (there is no way back to the set's counter).
+     */
+    static void remove(reference element) noexcept;
+
+    /**
+     * @brief Unlinks all elements, one pass per bucket resetting the hooks.
+     * Ends a pending rehash.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Starts moving the elements to buckets (a power of two of them, must outlive the set).
+     *
+     * A rehash still in progress is completed first.
+     */
+    void rehash(std::span<bucket_type> buckets) noexcept;
+
+    /**
+     * @brief Migrates up to n more old buckets, for callers with idle time to spend.
+     *
+     * @return true while old buckets remain.
+     */
+    bool rehash_step(size_type n = kRehashStep) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    template <typename Key>
+    [[nodiscard]]
+    auto find(const Key& key) noexcept -> pointer;
+
+    template <typename Key>
+    [[nodiscard]]
+    auto find(const Key& key) const noexcept -> const_pointer;
+
+    template <typename Key>
+    [[nodiscard]]
+    bool contains(const Key& key) const noexcept;
+
+    [[nodiscard]] bool empty() const noexcept;
+
+    /* O(1) with CountingPolicy, O(buckets + n) otherwise */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type;
+
+    /* the bucket count being rehashed to, if rehashing() */
+    [[nodiscard]]
+    auto bucket_count() const noexcept -> size_type;
+
+    [[nodiscard]] bool rehashing() const noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    /* fibonacci hashing : spreads weak hashes (identity std::hash<int>) over the top bits */
+    [[nodiscard]]
+    static auto bucket_index(std::size_t hash, unsigned bits) noexcept -> size_type;
+
+    /* the bucket that holds (or would hold) key right now, old or new table */
+    template <typename Key>
+    [[nodiscard]]
+    auto bucket_for(const Key& key) const noexcept -> bucket_type&;
+
+    template <typename Visitor>
+    void for_each_bucket(Visitor visit) const noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    std::span<bucket_type> buckets_;
+    unsigned bits_;
+
+    /* old table while rehashing : buckets below cursor_ are already migrated */
+    std::span<bucket_type> old_buckets_;
+    unsigned old_bits_{0};
+    size_type cursor_{0};
+
+    [[no_unique_address]] Hash hash_;
+    [[no_unique_address]] Eq eq_;
+    [[no_unique_address]] size_policy size_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+IntrusiveHashSet<T, Hash, Eq, Options...>::IntrusiveHashSet(std::span<bucket_type> buckets,
+                                                           const Hash& hash,
+                                                           const Eq& eq) noexcept
+    : buckets_(buckets),
+      bits_(static_cast<unsigned>(std::countr_zero(buckets.size()))),
+      hash_(hash),
+      eq_(eq) {
+    assert(std::has_single_bit(buckets.size()) && "bucket count must be a power of two...");
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+IntrusiveHashSet<T, Hash, Eq, Options...>::~IntrusiveHashSet() {
+    clear();
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+auto IntrusiveHashSet<T, Hash, Eq, Options...>::bucket_index(std::size_t hash,
+                                                            unsigned bits) noexcept
+    -> size_type {
+    if (bits == 0) {
+        return 0;
+    }
+
+    constexpr std::uint64_t kGolden = 0x9E3779B97F4A7C15ull;
+
+    return static_cast<size_type>((static_cast<std::uint64_t>(hash) * kGolden) >> (64 - bits));
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+template <typename Key>
+auto IntrusiveHashSet<T, Hash, Eq, Options...>::bucket_for(const Key& key) const noexcept
+    -> bucket_type& {
+    const std::size_t hash = hash_(key);
+
+    if (rehashing()) {
+        const size_type old_index = bucket_index(hash, old_bits_);
+
+        if (old_index >= cursor_) {
+            return old_buckets_[old_index];
+        }
+    }
+
+    return buckets_[bucket_index(hash, bits_)];
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+template <typename Visitor>
+void IntrusiveHashSet<T, Hash, Eq, Options...>::for_each_bucket(Visitor visit) const noexcept {
+    for (const auto& bucket : buckets_) {
+        visit(bucket);
+    }
+
+    if (rehashing()) {
+        for (size_type i = cursor_; i < old_buckets_.size(); ++i) {
+            visit(old_buckets_[i]);
+        }
+    }
+}
+
+/*---*---*---*---*---*---*---* Lookup *---*---*---*---*---*---*---*/
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+template <typename Key>
+auto IntrusiveHashSet<T, Hash, Eq, Options...>::find(const Key& key) noexcept -> pointer {
+    for (auto& element : bucket_for(key)) {
+        if (eq_(key, element)) {
+            return &element;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+template <typename Key>
+auto IntrusiveHashSet<T, Hash, Eq, Options...>::find(const Key& key) const noexcept
+    -> const_pointer {
+    return const_cast<IntrusiveHashSet*>(this)->find(key);
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+template <typename Key>
+bool IntrusiveHashSet<T, Hash, Eq, Options...>::contains(const Key& key) const noexcept {
+    return find(key) != nullptr;
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+bool IntrusiveHashSet<T, Hash, Eq, Options...>::empty() const noexcept {
+    if constexpr (size_policy::is_counting) {
+        return size_.count() == 0;
+    }
+
+    bool all_empty = true;
+
+    for_each_bucket([&all_empty](const bucket_type& bucket) { all_empty &= bucket.empty(); });
+
+    return all_empty;
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+auto IntrusiveHashSet<T, Hash, Eq, Options...>::size() const noexcept -> size_type {
+    if constexpr (size_policy::is_counting) {
+        return size_.count();
+    }
+
+    size_type cnt = 0;
+
+    for_each_bucket([&cnt](const bucket_type& bucket) { cnt += bucket.size(); });
+
+    return cnt;
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+auto IntrusiveHashSet<T, Hash, Eq, Options...>::bucket_count() const noexcept -> size_type {
+    return buckets_.size();
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+bool IntrusiveHashSet<T, Hash, Eq, Options...>::rehashing() const noexcept {
+    return cursor_ < old_buckets_.size();
+}
+
+/*---*---*---*---*---*---*---* Modifiers *---*---*---*---*---*---*---*/
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+bool IntrusiveHashSet<T, Hash, Eq, Options...>::insert(reference element) noexcept {
+    rehash_step();
+
+    bucket_type& bucket = bucket_for(element);
+
+    for (auto& other : bucket) {
+        if (eq_(element, other)) {
+            return false;
+        }
+    }
+
+    /* recently inserted entries tend to be looked up first */
+    bucket.push_front(element);
+    size_.increment();
+
+    return true;
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+void IntrusiveHashSet<T, Hash, Eq, Options...>::erase(reference element) noexcept {
+    bucket_type::remove(element);
+    size_.decrement();
+
+    rehash_step();
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+void IntrusiveHashSet<T, Hash, Eq, Options...>::remove(reference element) noexcept {
+    static_assert(!size_policy::is_counting,
+                  "remove() cannot update the owner's counter, use set.erase(element)");
+
+    bucket_type::remove(element);
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+void IntrusiveHashSet<T, Hash, Eq, Options...>::clear() noexcept {
+    for (auto& bucket : buckets_) {
+        bucket.clear();
+    }
+
+    for (; cursor_ < old_buckets_.size(); ++cursor_) {
+        old_buckets_[cursor_].clear();
+    }
+
+    old_buckets_ = {};
+    cursor_ = 0;
+
+    size_.reset();
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+void IntrusiveHashSet<T, Hash, Eq, Options...>::rehash(std::span<bucket_type> buckets) noexcept {
+    assert(std::has_single_bit(buckets.size()) && "bucket count must be a power of two...");
+    assert(buckets.data() != buckets_.data() && "rehash() onto the current buckets...");
+
+    /* at most one migration in flight */
+    while (rehash_step(old_buckets_.size())) {
+    }
+
+    old_buckets_ = buckets_;
+    old_bits_ = bits_;
+    cursor_ = 0;
+
+    buckets_ = buckets;
+    bits_ = static_cast<unsigned>(std::countr_zero(buckets.size()));
+}
+
+template <typename T, typename Hash, typename Eq, typename... Options>
+bool IntrusiveHashSet<T, Hash, Eq, Options...>::rehash_step(size_type n) noexcept {
+    /**
+     * Before : old[cursor] : a <-> b <-> c          new[i] : x     new[j] : (empty)
+     * After  : old[cursor] : (empty)                new[i] : x <-> a <-> c
+     *                                               new[j] : b
+     */
+    for (; n > 0 && rehashing(); --n, ++cursor_) {
+        bucket_type& from = old_buckets_[cursor_];
+
+        while (!from.empty()) {
+            auto first = from.cbegin();
+            bucket_type& to = buckets_[bucket_index(hash_(*first), bits_)];
+
+            to.splice_cell(to.cend(), from, first);
+        }
+    }
+
+    if (rehashing()) {
+        return true;
+    }
+
+    /* done : the old array is the caller's again */
+    old_buckets_ = {};
+    cursor_ = 0;
+
+    return false;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
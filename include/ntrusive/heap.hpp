@@ -0,0 +1,465 @@
+#pragma once
+
+#include "heap_node.hpp"
+#include "list.hpp"
+#include "policy.hpp"
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Intrusive pairing heap (min-heap w.r.t. Compare).
+ *
+ *  >> push()     : O(1), one comparison
+ *  >> top()      : O(1)
+ *  >> pop()      : O(log n) amortized (two-pass pairing of the root's children)
+ *  >> decrease() : O(log n) amortized, call it AFTER making the key smaller
+ *  >> erase()    : O(log n) amortized, any element, by reference
+ *  >> remove()   : static, the self-removal idiom of IntrusiveList::remove()
+ *
+ * The root hangs below an anchor node owned by the heap, so every linked node
+ * (root included) can be cut from its parent without knowing which heap it is in.
+ *
+ * @tparam Compare Strict weak ordering on T, the smallest element is on top.
+ * @tparam Options Same as IntrusiveList : a hook option (BaseHook<Tag> / MemberHook<&T::hook>,
+ *                 resolved against IntrusiveHeapNode) and/or a size policy.
+ *
+ * >> USAGE :
+ *  struct Timer : IntrusiveHeapNode<> {
+ *    std::uint64_t deadline;
+ *  };
+ *
+ *  struct ByDeadline {
+ *    bool operator()(const Timer& a, const Timer& b) const { return a.deadline < b.deadline; }
+ *  };
+ *
+ *  IntrusivePairingHeap<Timer, ByDeadline> timers;
+ */
+template <typename T, typename Compare = std::less<T>, typename... Options>
+class IntrusivePairingHeap {
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+
+    using value_compare = Compare;
+
+    using hook_traits = HeapHookTraits<T, typename ListOptions<T, Options...>::hook>;
+    using size_policy = typename ListOptions<T, Options...>::size_policy;
+
+    using node_type = typename hook_traits::node_type;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    IntrusivePairingHeap() noexcept = default;
+
+    explicit IntrusivePairingHeap(const Compare& comp) noexcept;
+
+    ~IntrusivePairingHeap();
+
+    IntrusivePairingHeap(const IntrusivePairingHeap&) = delete;
+    IntrusivePairingHeap& operator=(const IntrusivePairingHeap&) = delete;
+
+    IntrusivePairingHeap(IntrusivePairingHeap&&) noexcept = delete;
+    IntrusivePairingHeap& operator=(IntrusivePairingHeap&&) noexcept = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    void push(reference element) noexcept;
+
+    void pop() noexcept;
+
+    [[nodiscard]]
+    auto try_pop() noexcept -> pointer;
+
+    /**
+     * @brief Restores the heap order after element's key was DECREASED.
+     */
+    void decrease(reference element) noexcept;
+
+    /**
+     * @brief Unlinks element, wherever it is in the heap.
+     */
+    void erase(reference element) noexcept;
+
+    /**
+     * @brief Unlinks element without knowing its heap.
+     *
+     * The subtree of element takes its place (its children are all >= element,
+     * so the order still holds). Not available with CountingPolicy nor with
+     * a stateful Compare (a default constructed one is used).
+     */
+    static void remove(reference element) noexcept;
+
+    /**
+     * @brief Moves every element of other into this heap. O(1).
+     */
+    void merge(IntrusivePairingHeap& other) noexcept;
+
+    /**
+     * @brief Unlinks all elements, one pass resetting the hooks.
+     */
+    void clear() noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    [[nodiscard]] bool empty() const noexcept;
+
+    /* O(1) with CountingPolicy, O(n) otherwise */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type;
+
+    [[nodiscard]]
+    auto top() noexcept -> reference;
+
+    [[nodiscard]]
+    auto top() const noexcept -> const_reference;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    /* links two detached subtree roots, returns the new root */
+    [[nodiscard]]
+    static auto meld(HeapNodeBase* a, HeapNodeBase* b, const Compare& comp) noexcept
+        -> HeapNodeBase*;
+
+    /* two-pass pairing of a sibling chain, returns one detached root (or nullptr) */
+    [[nodiscard]]
+    static auto merge_pairs(HeapNodeBase* first, const Compare& comp) noexcept -> HeapNodeBase*;
+
+    [[nodiscard]]
+    auto root() const noexcept -> HeapNodeBase*;
+
+    void set_root(HeapNodeBase* node) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    /* anchor_.child_ is the root */
+    HeapNodeBase anchor_;
+
+    [[no_unique_address]] Compare comp_;
+    [[no_unique_address]] size_policy size_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename Compare, typename... Options>
+IntrusivePairingHeap<T, Compare, Options...>::IntrusivePairingHeap(const Compare& comp) noexcept
+    : comp_(comp) {}
+
+template <typename T, typename Compare, typename... Options>
+IntrusivePairingHeap<T, Compare, Options...>::~IntrusivePairingHeap() {
+    clear();
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusivePairingHeap<T, Compare, Options...>::meld(HeapNodeBase* a, HeapNodeBase* b,
+                                                        const Compare& comp) noexcept
+    -> HeapNodeBase* {
+    if (a == nullptr) {
+        return b;
+    }
+
+    if (b == nullptr) {
+        return a;
+    }
+
+    if (comp(*hook_traits::to_value(b), *hook_traits::to_value(a))) {
+        std::swap(a, b);
+    }
+
+    /**
+     * Before : a      b
+     *          |
+     *          c ...
+     *
+     * After :  a
+     *          |
+     *          b <-> c ...
+     */
+    b->prev_ = a;
+    b->next_ = a->child_;
+
+    if (a->child_ != nullptr) {
+        a->child_->prev_ = b;
+    }
+
+    a->child_ = b;
+
+    return a;
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusivePairingHeap<T, Compare, Options...>::merge_pairs(HeapNodeBase* first,
+                                                               const Compare& comp) noexcept
+    -> HeapNodeBase* {
+    if (first == nullptr) {
+        return nullptr;
+    }
+
+    /* 1st pass, left to right : meld pairs, stack the results through next_ */
+    HeapNodeBase* pairs = nullptr;
+
+    while (first != nullptr) {
+        HeapNodeBase* a = first;
+        HeapNodeBase* b = a->next_;
+
+        first = (b != nullptr) ? b->next_ : nullptr;
+
+        a->prev_ = a->next_ = nullptr;
+
+        if (b != nullptr) {
+            b->prev_ = b->next_ = nullptr;
+        }
+
+        HeapNodeBase* melded = meld(a, b, comp);
+
+        melded->next_ = pairs;
+        pairs = melded;
+    }
+
+    /* 2nd pass, right to left : meld everything into the last pair */
+    HeapNodeBase* result = pairs;
+    pairs = pairs->next_;
+    result->next_ = nullptr;
+
+    while (pairs != nullptr) {
+        HeapNodeBase* next = pairs->next_;
+        pairs->next_ = nullptr;
+
+        result = meld(result, pairs, comp);
+        pairs = next;
+    }
+
+    return result;
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusivePairingHeap<T, Compare, Options...>::root() const noexcept -> HeapNodeBase* {
+    return anchor_.child_;
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusivePairingHeap<T, Compare, Options...>::set_root(HeapNodeBase* node) noexcept {
+    anchor_.child_ = node;
+
+    if (node != nullptr) {
+        node->prev_ = &anchor_;
+        node->next_ = nullptr;
+    }
+}
+
+/*---*---*---*---*---*---*---* Capacity *---*---*---*---*---*---*---*/
+
+template <typename T, typename Compare, typename... Options>
+bool IntrusivePairingHeap<T, Compare, Options...>::empty() const noexcept {
+    return root() == nullptr;
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusivePairingHeap<T, Compare, Options...>::size() const noexcept -> size_type {
+    if constexpr (size_policy::is_counting) {
+        return size_.count();
+    }
+
+    size_type cnt = 0;
+    const HeapNodeBase* node = root();
+
+    /* preorder walk : down through child_, then right, then back up through prev_ */
+    while (node != nullptr) {
+        ++cnt;
+
+        if (node->child_ != nullptr) {
+            node = node->child_;
+            continue;
+        }
+
+        while (node != nullptr && node->next_ == nullptr) {
+            /* climb to the parent : leftmost sibling's prev_ */
+            while (node->prev_->child_ != node) {
+                node = node->prev_;
+            }
+
+            node = node->prev_;
+
+            if (node == &anchor_) {
+                node = nullptr;
+            }
+        }
+
+        if (node != nullptr) {
+            node = node->next_;
+        }
+    }
+
+    return cnt;
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusivePairingHeap<T, Compare, Options...>::top() noexcept -> reference {
+    assert(!empty() && "top() called on empty heap...");
+    return *hook_traits::to_value(root());
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusivePairingHeap<T, Compare, Options...>::top() const noexcept -> const_reference {
+    assert(!empty() && "top() called on empty heap...");
+    return *hook_traits::to_value(root());
+}
+
+/*---*---*---*---*---*---*---* Modifiers *---*---*---*---*---*---*---*/
+
+template <typename T, typename Compare, typename... Options>
+void IntrusivePairingHeap<T, Compare, Options...>::push(reference element) noexcept {
+    HeapNodeBase* node = hook_traits::to_node(&element);
+
+    assert(!node->is_linked_base() && "Element already in a heap!!");
+
+    node->child_ = nullptr;
+
+    set_root(meld(root(), node, comp_));
+    size_.increment();
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusivePairingHeap<T, Compare, Options...>::pop() noexcept {
+    assert(!empty() && "pop() on empty heap!!");
+
+    HeapNodeBase* old = root();
+    HeapNodeBase* children = old->child_;
+
+    old->reset_base();
+
+    set_root(merge_pairs(children, comp_));
+    size_.decrement();
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusivePairingHeap<T, Compare, Options...>::try_pop() noexcept -> pointer {
+    if (empty()) {
+        return nullptr;
+    }
+
+    pointer result = &top();
+    pop();
+
+    return result;
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusivePairingHeap<T, Compare, Options...>::decrease(reference element) noexcept {
+    HeapNodeBase* node = hook_traits::to_node(&element);
+
+    assert(node->is_linked_base() && "Element is not in a heap...");
+
+    if (node == root()) {
+        return;
+    }
+
+    /* the subtree below node is still ordered, only the edge to its parent may not be */
+    node->cut_base();
+    set_root(meld(root(), node, comp_));
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusivePairingHeap<T, Compare, Options...>::erase(reference element) noexcept {
+    HeapNodeBase* node = hook_traits::to_node(&element);
+
+    assert(node->is_linked_base() && "Element is not in a heap...");
+
+    if (node == root()) {
+        pop();
+        return;
+    }
+
+    node->cut_base();
+
+    HeapNodeBase* children = node->child_;
+    node->child_ = nullptr;
+
+    set_root(meld(root(), merge_pairs(children, comp_), comp_));
+    size_.decrement();
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusivePairingHeap<T, Compare, Options...>::remove(reference element) noexcept {
+    static_assert(!size_policy::is_counting,
+                  "remove() cannot update the owner's counter, use heap.erase(element)");
+
+    static_assert(std::is_default_constructible_v<Compare>,
+                  "remove() needs a stateless Compare, use heap.erase(element)");
+
+    HeapNodeBase* node = hook_traits::to_node(&element);
+
+    assert(node->is_linked_base() && "Element is not in a heap...");
+
+    HeapNodeBase* children = node->child_;
+    node->child_ = nullptr;
+
+    HeapNodeBase* sub = merge_pairs(children, Compare{});
+
+    if (sub == nullptr) {
+        node->cut_base();
+    } else {
+        node->replace_base(sub);
+    }
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusivePairingHeap<T, Compare, Options...>::merge(IntrusivePairingHeap& other) noexcept {
+    if (this == &other || other.empty()) {
+        return;
+    }
+
+    HeapNodeBase* theirs = other.root();
+
+    other.anchor_.child_ = nullptr;
+    theirs->prev_ = nullptr;
+
+    set_root(meld(root(), theirs, comp_));
+
+    if constexpr (size_policy::is_counting) {
+        size_.add(other.size_.count());
+        other.size_.reset();
+    }
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusivePairingHeap<T, Compare, Options...>::clear() noexcept {
+    HeapNodeBase* node = root();
+
+    /**
+     * Flatten while walking : the child chain of node is spliced right after it,
+     * so every node is visited once and reset.
+     */
+    while (node != nullptr) {
+        if (node->child_ != nullptr) {
+            HeapNodeBase* last = node->child_;
+
+            while (last->next_ != nullptr) {
+                last = last->next_;
+            }
+
+            last->next_ = node->next_;
+            node->next_ = node->child_;
+        }
+
+        HeapNodeBase* next = node->next_;
+        node->reset_base();
+        node = next;
+    }
+
+    anchor_.child_ = nullptr;
+    size_.reset();
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "hook.hpp"
+#include "node.hpp"
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Link of an intrusive pairing heap : leftmost-child / right-sibling tree.
+ *
+ *  >> prev_  : parent if this is the leftmost child, left sibling otherwise
+ *              (the root's prev_ is the heap's anchor)
+ *  >> next_  : right sibling
+ *  >> child_ : leftmost child
+ *
+ * Unlinked state : prev_ == nullptr.
+ */
+struct HeapNodeBase {
+
+    /*---*---*---*---*---*---*/
+
+    HeapNodeBase* prev_{nullptr};
+    HeapNodeBase* next_{nullptr};
+    HeapNodeBase* child_{nullptr};
+
+    /*---*---*---*---*---*---*/
+
+    [[nodiscard]]
+    bool is_linked_base() const noexcept;
+
+    /**
+     * @brief Is this the leftmost child of prev_ (or the root)?
+     */
+    [[nodiscard]]
+    bool is_leftmost() const noexcept;
+
+    /**
+     * @brief Detaches this node, with its whole subtree, from its parent and siblings.
+     *
+     * Before: prev <-> this <-> next
+     *                   |
+     *                 child ...
+     *
+     * After:  prev <-> next         this
+     *                                |
+     *                              child ...
+     */
+    void cut_base() noexcept;
+
+    /**
+     * @brief Puts other (a detached subtree root) in this node's place, this ends up detached.
+     */
+    void replace_base(HeapNodeBase* other) noexcept;
+
+    void reset_base() noexcept;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Intrusive pairing heap node, three pointers.
+ * Inherit from this class (or embed it as a member) to put objects in an IntrusivePairingHeap.
+ *
+ * >> SAFETY : destroying a linked node is a bug (assert),
+ *             remove it first (IntrusivePairingHeap::remove(element)).
+ *
+ * >> USAGE :
+ *  struct Timer : IntrusiveHeapNode<> {
+ *    std::uint64_t deadline;
+ *  };
+ */
+template <typename Tag = DefaultTag>
+class IntrusiveHeapNode : public HeapNodeBase {
+  public:
+    using tag_type = Tag;
+
+    constexpr IntrusiveHeapNode() noexcept = default;
+
+    ~IntrusiveHeapNode();
+
+    /* non-copyable */
+    IntrusiveHeapNode(const IntrusiveHeapNode&) = delete;
+    IntrusiveHeapNode& operator=(const IntrusiveHeapNode&) = delete;
+
+    /* non-moveble */
+    IntrusiveHeapNode(IntrusiveHeapNode&&) noexcept = delete;
+    IntrusiveHeapNode& operator=(IntrusiveHeapNode&&) noexcept = delete;
+
+    /**
+     * @brief Is this node currently in a heap?
+     */
+    [[nodiscard]]
+    bool is_linked() const noexcept;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Same hook options as IntrusiveList (BaseHook<Tag> / MemberHook<&T::hook>),
+ * resolved against IntrusiveHeapNode<Tag> instead.
+ */
+template <typename T, typename Hook>
+struct HeapHookTraits;
+
+template <typename T, typename Tag>
+struct HeapHookTraits<T, BaseHook<Tag>> {
+    static_assert(std::is_base_of_v<IntrusiveHeapNode<Tag>, T>,
+                  "T must inherit from IntrusiveHeapNode<Tag>");
+
+    using value_type = T;
+    using node_type = IntrusiveHeapNode<Tag>;
+
+    [[nodiscard]]
+    static constexpr node_type* to_node(T* value) noexcept {
+        return static_cast<node_type*>(value);
+    }
+
+    [[nodiscard]]
+    static constexpr T* to_value(HeapNodeBase* node) noexcept {
+        return static_cast<T*>(static_cast<node_type*>(node));
+    }
+};
+
+template <typename T, auto Member>
+struct HeapHookTraits<T, MemberHook<Member>> {
+    using owner_type = typename MemberPointerTraits<decltype(Member)>::owner_type;
+
+    static_assert(std::is_same_v<owner_type, T> || std::is_base_of_v<owner_type, T>,
+                  "MemberHook<&Owner::hook> must point into T");
+
+    using value_type = T;
+    using node_type = typename MemberPointerTraits<decltype(Member)>::field_type;
+
+    static_assert(std::is_base_of_v<HeapNodeBase, node_type>,
+                  "MemberHook<> must point to an IntrusiveHeapNode<...> member");
+
+    [[nodiscard]]
+    static node_type* to_node(T* value) noexcept {
+        return &(static_cast<owner_type*>(value)->*Member);
+    }
+
+    [[nodiscard]]
+    static T* to_value(HeapNodeBase* node) noexcept {
+        auto* bytes = reinterpret_cast<unsigned char*>(static_cast<node_type*>(node));
+
+        return static_cast<T*>(reinterpret_cast<owner_type*>(bytes - member_offset<Member>()));
+    }
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+inline bool HeapNodeBase::is_linked_base() const noexcept {
+    return prev_ != nullptr;
+}
+
+inline bool HeapNodeBase::is_leftmost() const noexcept {
+    return prev_->child_ == this;
+}
+
+inline void HeapNodeBase::cut_base() noexcept {
+    if (is_leftmost()) {
+        prev_->child_ = next_;
+    } else {
+        prev_->next_ = next_;
+    }
+
+    if (next_ != nullptr) {
+        next_->prev_ = prev_;
+    }
+
+    prev_ = nullptr;
+    next_ = nullptr;
+}
+
+inline void HeapNodeBase::replace_base(HeapNodeBase* other) noexcept {
+    other->prev_ = prev_;
+    other->next_ = next_;
+
+    if (is_leftmost()) {
+        prev_->child_ = other;
+    } else {
+        prev_->next_ = other;
+    }
+
+    if (next_ != nullptr) {
+        next_->prev_ = other;
+    }
+
+    prev_ = nullptr;
+    next_ = nullptr;
+}
+
+inline void HeapNodeBase::reset_base() noexcept {
+    prev_ = nullptr;
+    next_ = nullptr;
+    child_ = nullptr;
+}
+
+template <typename Tag>
+IntrusiveHeapNode<Tag>::~IntrusiveHeapNode() {
+    assert(!is_linked() && "destroying node still in a heap...");
+}
+
+template <typename Tag>
+bool IntrusiveHeapNode<Tag>::is_linked() const noexcept {
+    return is_linked_base();
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "base_node.hpp"
+#include "node.hpp"
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Hook options : tell IntrusiveList<T, ...> where the IntrusiveListNode lives inside T.
+ *
+ *  >> BaseHook<Tag>        : T inherits IntrusiveListNode<Tag> (default : BaseHook<DefaultTag>)
+ *
+ *  >> MemberHook<&T::hook> : T has an IntrusiveListNode<...> data member
+ *
+ * HookTraits<T, Hook> turns the option into the two conversions the list and
+ * its iterator need : T* -> node and NodeBase* -> T*.
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Finds the IntrusiveListNode<Tag, Mode> base of T, whatever its Mode.
+ *
+ * Declaration only : used in unevaluated context to deduce Mode.
+ */
+template <typename Tag, typename Mode>
+auto deduce_base_hook(IntrusiveListNode<Tag, Mode>* node) -> IntrusiveListNode<Tag, Mode>*;
+
+/**
+ * @brief Concept to verify T inherits from (exactly one) IntrusiveListNode<Tag, ...>.
+ */
+template <typename T, typename Tag = DefaultTag>
+concept DerivedFromNode = requires(T* value) {
+    deduce_base_hook<Tag>(value);
+};
+
+template <typename Tag = DefaultTag>
+struct BaseHook {};
+
+template <auto Member>
+struct MemberHook {
+    static_assert(std::is_member_object_pointer_v<decltype(Member)>,
+                  "MemberHook<> expects a pointer to data member, like &T::hook_");
+};
+
+template <typename H>
+struct IsHookOption : std::false_type {};
+
+template <typename Tag>
+struct IsHookOption<BaseHook<Tag>> : std::true_type {};
+
+template <auto Member>
+struct IsHookOption<MemberHook<Member>> : std::true_type {};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+template <typename M>
+struct MemberPointerTraits;
+
+template <typename Owner, typename Field>
+struct MemberPointerTraits<Field Owner::*> {
+    using owner_type = Owner;
+    using field_type = Field;
+};
+
+/**
+ * @brief Byte offset of a data member inside its owner.
+ *
+ * offsetof() cannot take a pointer to member, so the member is located on a
+ * dummy (never constructed) object. The whole thing folds into a constant.
+ */
+template <auto Member>
+inline std::ptrdiff_t member_offset() noexcept {
+    using owner_type = typename MemberPointerTraits<decltype(Member)>::owner_type;
+
+    alignas(owner_type) static constexpr unsigned char storage[sizeof(owner_type)]{};
+
+    const auto* owner = reinterpret_cast<const owner_type*>(storage);
+
+    return reinterpret_cast<const unsigned char*>(&(owner->*Member)) - storage;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename Hook>
+struct HookTraits;
+
+template <typename T, typename Tag>
+struct HookTraits<T, BaseHook<Tag>> {
+    static_assert(DerivedFromNode<T, Tag>,
+                  "T must inherit from IntrusiveListNode<Tag>");
+
+    using value_type = T;
+    using node_type = std::remove_pointer_t<decltype(deduce_base_hook<Tag>(static_cast<T*>(nullptr)))>;
+
+    /**
+     *
+     * T* --> node_type* (derived-to-base)
+     *
+     */
+    [[nodiscard]]
+    static constexpr node_type* to_node(T* value) noexcept {
+        return static_cast<node_type*>(value);
+    }
+
+    /**
+     *
+     * NodeBase* --> node_type* --> T*
+     *
+     */
+    [[nodiscard]]
+    static constexpr T* to_value(NodeBase* node) noexcept {
+        return static_cast<T*>(static_cast<node_type*>(node));
+    }
+};
+
+template <typename T, auto Member>
+struct HookTraits<T, MemberHook<Member>> {
+    using owner_type = typename MemberPointerTraits<decltype(Member)>::owner_type;
+
+    static_assert(std::is_same_v<owner_type, T> || std::is_base_of_v<owner_type, T>,
+                  "MemberHook<&Owner::hook> must point into T");
+
+    using value_type = T;
+    using node_type = typename MemberPointerTraits<decltype(Member)>::field_type;
+
+    static_assert(std::is_base_of_v<NodeBase, node_type>,
+                  "MemberHook<> must point to an IntrusiveListNode<...> member");
+
+    [[nodiscard]]
+    static node_type* to_node(T* value) noexcept {
+        return &(static_cast<owner_type*>(value)->*Member);
+    }
+
+    /**
+     *
+     * NodeBase* --> node_type* --(minus member offset)--> owner_type* --> T*
+     *
+     */
+    [[nodiscard]]
+    static T* to_value(NodeBase* node) noexcept {
+        auto* bytes = reinterpret_cast<unsigned char*>(static_cast<node_type*>(node));
+
+        return static_cast<T*>(reinterpret_cast<owner_type*>(bytes - member_offset<Member>()));
+    }
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
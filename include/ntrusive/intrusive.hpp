@@ -1,6 +1,28 @@
 #pragma once
 
+#include "arena.hpp"
 #include "base_node.hpp"
+#include "config.hpp"
+#include "coro_scheduler.hpp"
+#include "hash_set.hpp"
+#include "heap.hpp"
+#include "heap_node.hpp"
+#include "hook.hpp"
 #include "iterator.hpp"
 #include "list.hpp"
+#include "lru_cache.hpp"
+#include "mpsc_queue.hpp"
 #include "node.hpp"
+#include "parallel.hpp"
+#include "policy.hpp"
+#include "pool.hpp"
+#include "prefetch.hpp"
+#include "rbtree.hpp"
+#include "rbtree_node.hpp"
+#include "slist.hpp"
+#include "slist_node.hpp"
+#include "stack.hpp"
+#include "thread_pool.hpp"
+#include "timer_wheel.hpp"
+#include "wait_queue.hpp"
+#include "work_stealing_deque.hpp"
@@ -1,14 +1,18 @@
 #pragma once
 
 #include "base_node.hpp"
-#include "node.hpp"
+#include "hook.hpp"
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
 
 /**
  * @brief Bidirectional Iterator for IntrusiveList<...>
+ *
+ * @tparam Traits HookTraits<...> of the list : how to get from the hook back to T
+ *                (derived-to-base cast for base hooks, member offset for member hooks).
  */
-template <typename T>
+template <typename T, typename Traits = HookTraits<std::remove_const_t<T>, BaseHook<>>>
 class ListIterator {
   public:
     /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -19,7 +23,8 @@ class ListIterator {
     using pointer = T*;
     using reference = T&;
 
-    using node_type = IntrusiveListNode;
+    using hook_traits = Traits;
+    using node_type = typename Traits::node_type;
 
     /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
 
@@ -46,7 +51,7 @@ class ListIterator {
 
     constexpr bool operator!=(const ListIterator& other) const noexcept;
 
-    operator ListIterator<const value_type>() const noexcept;
+    operator ListIterator<const value_type, Traits>() const noexcept;
 
     [[nodiscard]] constexpr NodeBase* base() const noexcept;
 
@@ -54,77 +59,77 @@ class ListIterator {
     NodeBase* current_{nullptr};
 };
 
-template <typename T>
-using ConstListIterator = ListIterator<const T>;
+template <typename T, typename Traits = HookTraits<T, BaseHook<>>>
+using ConstListIterator = ListIterator<const T, Traits>;
 
 /*---*---*---*---*---*---*---*---IMPL---*---*---*---*---*---*---*---*---*/
 
-template <typename T>
-constexpr ListIterator<T>::ListIterator(NodeBase* hook) noexcept
+template <typename T, typename Traits>
+constexpr ListIterator<T, Traits>::ListIterator(NodeBase* hook) noexcept
     : current_(hook) {}
 
-template <typename T>
-constexpr typename ListIterator<T>::reference
-ListIterator<T>::operator*() const noexcept {
+template <typename T, typename Traits>
+constexpr typename ListIterator<T, Traits>::reference
+ListIterator<T, Traits>::operator*() const noexcept {
 
     /**
      *
-     * NodeBase* --> node_type* --> T*
+     * NodeBase* --> T* (see HookTraits<...>::to_value)
      *
      */
 
-    return *static_cast<pointer>(static_cast<node_type*>(current_));
+    return *Traits::to_value(current_);
 }
 
-template <typename T>
-constexpr typename ListIterator<T>::pointer
-ListIterator<T>::operator->() const noexcept {
-    return static_cast<pointer>(static_cast<node_type*>(current_));
+template <typename T, typename Traits>
+constexpr typename ListIterator<T, Traits>::pointer
+ListIterator<T, Traits>::operator->() const noexcept {
+    return Traits::to_value(current_);
 }
 
-template <typename T>
-constexpr ListIterator<T>& ListIterator<T>::operator++() noexcept {
+template <typename T, typename Traits>
+constexpr ListIterator<T, Traits>& ListIterator<T, Traits>::operator++() noexcept {
     current_ = current_->next_node();
     return *this;
 }
 
-template <typename T>
-constexpr ListIterator<T>& ListIterator<T>::operator--() noexcept {
+template <typename T, typename Traits>
+constexpr ListIterator<T, Traits>& ListIterator<T, Traits>::operator--() noexcept {
     current_ = current_->prev_node();
     return *this;
 }
 
-template <typename T>
-constexpr ListIterator<T> ListIterator<T>::operator++(int) noexcept {
+template <typename T, typename Traits>
+constexpr ListIterator<T, Traits> ListIterator<T, Traits>::operator++(int) noexcept {
     auto tmp = *this;
     ++(*this);
     return tmp;
 }
 
-template <typename T>
-constexpr ListIterator<T> ListIterator<T>::operator--(int) noexcept {
+template <typename T, typename Traits>
+constexpr ListIterator<T, Traits> ListIterator<T, Traits>::operator--(int) noexcept {
     auto tmp = *this;
     --(*this);
     return tmp;
 }
 
-template <typename T>
-constexpr bool ListIterator<T>::operator==(const ListIterator& other) const noexcept {
+template <typename T, typename Traits>
+constexpr bool ListIterator<T, Traits>::operator==(const ListIterator& other) const noexcept {
     return current_ == other.current_;
 }
 
-template <typename T>
-constexpr bool ListIterator<T>::operator!=(const ListIterator& other) const noexcept {
+template <typename T, typename Traits>
+constexpr bool ListIterator<T, Traits>::operator!=(const ListIterator& other) const noexcept {
     return current_ != other.current_;
 }
 
-template <typename T>
-ListIterator<T>::operator ListIterator<const value_type>() const noexcept {
-    return ListIterator<const value_type>{current_};
+template <typename T, typename Traits>
+ListIterator<T, Traits>::operator ListIterator<const value_type, Traits>() const noexcept {
+    return ListIterator<const value_type, Traits>{current_};
 }
 
-template <typename T>
-constexpr NodeBase* ListIterator<T>::base() const noexcept {
+template <typename T, typename Traits>
+constexpr NodeBase* ListIterator<T, Traits>::base() const noexcept {
     return current_;
 }
 
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "base_node.hpp"
+#include "hook.hpp"
 #include "iterator.hpp"
 #include "node.hpp"
+#include "policy.hpp"
 #include <cassert>
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include <type_traits>
 
 
@@ -24,17 +28,71 @@
 /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
 
 /**
- * @brief Concept to verify T inherits from IntrusiveListNode .
+ * @brief Resolves the option pack of IntrusiveList<T, Options...>.
+ *
+ * Every option is either a hook option (BaseHook<Tag> / MemberHook<&T::hook>)
+ * or a size policy (NonCountingPolicy / CountingPolicy), in any order.
+ * Whatever is not given falls back to BaseHook<> and NonCountingPolicy.
+ */
+template <template <typename> typename Pred, typename Default, typename... Options>
+struct FindOption {
+    using type = Default;
+};
+
+template <template <typename> typename Pred, typename Default, typename Head, typename... Tail>
+struct FindOption<Pred, Default, Head, Tail...> {
+    using type = std::conditional_t<Pred<Head>::value, Head,
+                                    typename FindOption<Pred, Default, Tail...>::type>;
+};
+
+template <typename P>
+struct IsSizePolicy : std::bool_constant<SizePolicy<P>> {};
+
+template <typename T, typename... Options>
+struct ListOptions {
+    static_assert(((IsHookOption<Options>::value || IsSizePolicy<Options>::value) && ...),
+                  "IntrusiveList options are BaseHook<>, MemberHook<> or a size policy");
+
+    static_assert((IsHookOption<Options>::value + ... + 0) <= 1,
+                  "IntrusiveList takes at most one hook option");
+
+    static_assert((IsSizePolicy<Options>::value + ... + 0) <= 1,
+                  "IntrusiveList takes at most one size policy");
+
+    using hook = typename FindOption<IsHookOption, BaseHook<>, Options...>::type;
+    using size_policy = typename FindOption<IsSizePolicy, NonCountingPolicy, Options...>::type;
+
+    using hook_traits = HookTraits<T, hook>;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Default disposer of IntrusiveList::remove_if() / unique() : the unlinked
+ * element is left to its owner.
  */
-template <typename T>
-concept DerivedFromNode = std::is_base_of_v<IntrusiveListNode, T>;
+struct NoDispose {
+    template <typename T>
+    constexpr void operator()(T&) const noexcept {}
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
 
-template <typename T>
+/**
+ * @brief Intrusive doubly-linked list.
+ *
+ * @tparam Options Any of (order does not matter) :
+ *  >> a hook option   : BaseHook<Tag> (default BaseHook<>) or MemberHook<&T::hook>, see hook.hpp
+ *  >> a size policy   : NonCountingPolicy (default, size() is O(n)) or
+ *                       CountingPolicy (size() is O(1)), see policy.hpp for the trade-offs.
+ *
+ *  IntrusiveList<Task>                                  : Task : IntrusiveListNode<>
+ *  IntrusiveList<Conn, BaseHook<LruTag>, CountingPolicy> : Conn : IntrusiveListNode<LruTag>
+ *  IntrusiveList<Conn, MemberHook<&Conn::timeout_hook_>> : Conn has IntrusiveListNode<> timeout_hook_
+ */
+template <typename T, typename... Options>
 class IntrusiveList {
   public:
-    static_assert(DerivedFromNode<T>,
-                  "T must inherit from IntrusiveListNode<...>");
-
     using value_type = T;
     using pointer = T*;
     using const_pointer = const T*;
@@ -43,11 +101,19 @@ class IntrusiveList {
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
 
-    using node_type = IntrusiveListNode;
-    using sentinel_type = IntrusiveListNode;
+    using hook_traits = typename ListOptions<T, Options...>::hook_traits;
+    using size_policy = typename ListOptions<T, Options...>::size_policy;
+
+    using node_type = typename hook_traits::node_type;
+    using sentinel_type = NodeBase;
+    using link_mode = typename node_type::link_mode;
 
-    using iterator = ListIterator<T>;
-    using const_iterator = ListIterator<const T>;
+    static_assert(!(size_policy::is_counting && link_mode::is_auto_unlink),
+                  "CountingPolicy needs NormalLink or SafeLink hooks: "
+                  "an AutoUnlink hook would leave the list behind the counter's back");
+
+    using iterator = ListIterator<T, hook_traits>;
+    using const_iterator = ListIterator<const T, hook_traits>;
 
     /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
 
@@ -73,16 +139,68 @@ class IntrusiveList {
 
     auto insert(const_iterator pos, reference element) noexcept -> iterator;
 
+    /**
+     * @brief Links every element of [first, last) before pos, in order.
+     *
+     * The range yields T& or T*. The chain is built among the new elements first,
+     * the list itself is touched at the two ends only :
+     *
+     *   before ->  [ e0 <-> e1 <-> ... <-> ek ]  <- pos
+     *
+     * and the counter of a CountingPolicy list is bumped once.
+     *
+     * @return Iterator to the first inserted element, pos if the range is empty.
+     */
+    template <typename InputIt>
+    auto insert_range(const_iterator pos, InputIt first, InputIt last) noexcept -> iterator;
+
+    /**
+     * @brief insert_range(end(), first, last).
+     */
+    template <typename InputIt>
+    void push_back_range(InputIt first, InputIt last) noexcept;
+
     void pop_front() noexcept;
 
     void pop_back() noexcept;
 
     auto erase(const_iterator pos) noexcept -> iterator;
 
+    /**
+     * @brief Unlinks an element known to be in THIS list.
+     *
+     * Unlike static remove() it goes through the list, so it keeps the counter of
+     * a CountingPolicy list in sync.
+     *
+     * @return Iterator to the element that followed the erased one.
+     */
+    auto erase(reference element) noexcept -> iterator;
+
     auto erase_range(const_iterator first, const_iterator last) noexcept -> iterator;
 
+    /**
+     * @brief Unlinks all elements. Same as detach_all().
+     */
     void clear() noexcept;
 
+    /**
+     * @brief Empties the list, leaving every element unlinked.
+     *
+     * Walks the chain once and only resets the hooks, the neighbors are never
+     * rewired since they are leaving as well (2 stores per node instead of the 4 of pop_front()).
+     * O(1) for NormalLink hooks, which have nothing to reset.
+     */
+    void detach_all() noexcept;
+
+    /**
+     * @brief Empties the list in O(1) by resetting the sentinel only.
+     *
+     * The elements keep stale hooks, they must be relinked or dropped without
+     * asking their hook anything. Only for NormalLink hooks : safe hooks would
+     * still report is_linked() and AutoUnlink ones would unlink into freed memory.
+     */
+    void release_all() noexcept;
+
     /**
      * @brief Transfer all elements from outer list before specific position.
      */
@@ -109,15 +227,137 @@ class IntrusiveList {
     [[nodiscard]]
     auto extract_front(IntrusiveList& out, size_type max_cnt) noexcept -> size_type;
 
+    /**
+     * @brief Moves up to max_cnt elements from the back to the end of out, in list order.
+     *
+     * Walks max_cnt nodes from the tail, never the whole list.
+     *
+     * @return Number of elements moved.
+     */
+    [[nodiscard]]
+    auto extract_back(IntrusiveList& out, size_type max_cnt) noexcept -> size_type;
+
+    /**
+     * @brief Cuts the list before pos : [pos, end()) moves to the end of out.
+     *
+     * O(1) without a counter. A CountingPolicy list has to count one side of the cut :
+     * both sides are walked in lockstep until the shorter one ends, O(min(k, n - k)).
+     */
+    void split_at(const_iterator pos, IntrusiveList& out) noexcept;
+
+    /**
+     * @brief Cuts the list after pos : everything after pos moves to the end of out.
+     *
+     * pos must be an element, not end(). Same cost as split_at().
+     */
+    void split_after(const_iterator pos, IntrusiveList& out) noexcept;
+
+    /**
+     * @brief Detaches up to max_cnt elements from the front at once, then calls
+     * fn(element) on each of them in order.
+     *
+     * Each element is unlinked (its hook reset) before fn sees it, and never touched
+     * after : fn may free it, or link it again. The batch is the elements present at
+     * the call, up to the tail of that moment :
+     *  >> elements fn links at the back of this list are not visited again
+     *  >> fn may erase other elements (not destroy them) : the batch ends early once
+     *     the list runs empty, or, with safe hooks, once the original tail is unlinked
+     *  >> fn must NOT link elements at the front of this list, they would join the batch
+     *
+     * No intermediate list : one pass that only moves the head of the list forward.
+     *
+     * @return Number of elements consumed.
+     */
+    template <typename Fn>
+    auto consume_front(size_type max_cnt, Fn fn) noexcept -> size_type;
+
+    /**
+     * @brief consume_front() of the whole list : the list is emptied in O(1) first,
+     * fn may link elements anywhere in it.
+     *
+     * The elements still waiting in the batch are no longer in the list : fn must
+     * not unlink them.
+     */
+    template <typename Fn>
+    auto consume_all(Fn fn) noexcept -> size_type;
+
     /**
      * @brief Self removal of an element from ANY list.
      * This method enables objects to remove themselves without needing a ref to their containing list.
      *
      * @param Reference to the element to remove.
+     *
+     * Not available with CountingPolicy: there is no way back from the node to the
+     * owning list's counter (use erase(element) on the list instead).
      */
     static void remove(reference element) noexcept;
 
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+    /**
+     * Algorithms : they only rewire hooks, nothing is allocated, copied or moved.
+     * Comparators and predicates must not throw.
+     */
+
+    /**
+     * @brief Stable bottom-up merge sort, O(n log n) comparisons and O(1) extra memory.
+     *
+     * Runs are merged over the next pointers alone, the prev pointers are rebuilt
+     * in one final pass :
+     *
+     *   bins : [ run of 1 ] [ run of 2 ] [ run of 4 ] ...   (at most 64 heads)
+     *   each node enters as a run of 1 and carries through the bins like a binary counter.
+     */
+    template <typename Compare = std::less<>>
+    void sort(Compare comp = {}) noexcept;
+
+    /**
+     * @brief Merges the sorted list other into this sorted list, other is left empty.
+     *
+     * Stable : of equal elements, the ones of this list come first. O(n + m).
+     */
+    template <typename Compare = std::less<>>
+    void merge(IntrusiveList& other, Compare comp = {}) noexcept;
+
+    /**
+     * @brief Unlinks every element that pred(previous kept, element) calls equal
+     * to the one before it, and hands it to dispose.
+     *
+     * @return Number of elements removed.
+     */
+    template <typename BinaryPred = std::equal_to<>, typename Dispose = NoDispose>
+    auto unique(BinaryPred pred = {}, Dispose dispose = {}) noexcept -> size_type;
+
+    /**
+     * @brief Unlinks every element for which pred(element) holds, and hands it to dispose.
+     *
+     * @return Number of elements removed.
+     */
+    template <typename Pred, typename Dispose = NoDispose>
+    auto remove_if(Pred pred, Dispose dispose = {}) noexcept -> size_type;
+
+    /**
+     * @brief Reverses the order in place by swapping the two links of every node. O(n).
+     */
+    void reverse() noexcept;
+
   private:
+    /* merges two null-terminated chains linked through next only, ties go to a */
+    template <typename Compare>
+    static auto merge_chains(NodeBase* a, NodeBase* b, Compare& comp) noexcept -> NodeBase*;
+
+    /* links the null-terminated chain head as the whole list, prev pointers included */
+    void adopt_chain(NodeBase* head) noexcept;
+
+    /**
+     * @brief splice_range() for a range whose length is already known.
+     */
+    void transfer(const_iterator pos, IntrusiveList& other,
+                  const_iterator first, const_iterator last, size_type cnt) noexcept;
+
+    /* number of elements in [pos, end()), counting lists only */
+    auto count_tail(const_iterator pos) const noexcept -> size_type;
+
     void insert_after(NodeBase* after, reference value) noexcept;
 
     void insert_before(NodeBase* before, reference value) noexcept;
@@ -160,39 +400,53 @@ class IntrusiveList {
 
   private:
     NodeBase sentinel_;
+
+    [[no_unique_address]] size_policy size_;
+
+    /* moves whole chains in and out without going through the hooks' plain stores */
+    template <typename, typename...>
+    friend class IntrusiveStack;
+
+    /* evict_n() hands over a tail it has already counted */
+    template <typename, typename, typename, typename, typename>
+    friend class IntrusiveLruCache;
 };
 
 /*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
 
-template <typename T>
-IntrusiveList<T>::IntrusiveList() noexcept {
+template <typename T, typename... Options>
+IntrusiveList<T, Options...>::IntrusiveList() noexcept {
     init_sentinel();
 }
 
-template <typename T>
-IntrusiveList<T>::~IntrusiveList() {
+template <typename T, typename... Options>
+IntrusiveList<T, Options...>::~IntrusiveList() {
     /**
      * assert(empty() && "Destroying non-empty IntrusiveList. Unlink elements first!!");
      */
     clear();
 }
 
-template <typename T>
-void IntrusiveList<T>::init_sentinel() noexcept {
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::init_sentinel() noexcept {
     sentinel_.set_next(&sentinel_);
     sentinel_.set_prev(&sentinel_);
 }
 
 /*---*---*---*---*---*---*---* Capacity *---*---*---*---*---*---*---*/
 
-template <typename T>
-bool IntrusiveList<T>::empty() const noexcept {
+template <typename T, typename... Options>
+bool IntrusiveList<T, Options...>::empty() const noexcept {
     return sentinel_.next_node() == &sentinel_;
 }
 
-/* O(n) */
-template <typename T>
-auto IntrusiveList<T>::size() const noexcept -> size_type {
+/* O(1) with CountingPolicy, O(n) otherwise */
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::size() const noexcept -> size_type {
+    if constexpr (size_policy::is_counting) {
+        return size_.count();
+    }
+
     size_type cnt = 0;
 
     for (auto it = cbegin(); it != cend(); ++it) {
@@ -204,20 +458,20 @@ auto IntrusiveList<T>::size() const noexcept -> size_type {
 
 /*---*---*---*---*---*---*---* Iterators *---*---*---*---*---*---*---*/
 
-template <typename T>
-auto IntrusiveList<T>::front() noexcept -> reference {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::front() noexcept -> reference {
     assert(!empty() && "front() called on empty list...");
     return *begin();
 }
 
-template <typename T>
-auto IntrusiveList<T>::front() const noexcept -> const_reference {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::front() const noexcept -> const_reference {
     assert(!empty() && "front() called on empty list...");
     return *cbegin();
 }
 
-template <typename T>
-auto IntrusiveList<T>::back() noexcept -> reference {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::back() noexcept -> reference {
     assert(!empty() && "back() called on empty list...");
     /**
      * end() points to -> sentinel => sentinel.prev_ is the last element
@@ -225,14 +479,14 @@ auto IntrusiveList<T>::back() noexcept -> reference {
     return *(--end());
 }
 
-template <typename T>
-auto IntrusiveList<T>::back() const noexcept -> const_reference {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::back() const noexcept -> const_reference {
     assert(!empty() && "back() called on empty list...");
     return *(--cend());
 }
 
-template <typename T>
-auto IntrusiveList<T>::begin() noexcept -> iterator {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::begin() noexcept -> iterator {
     /**
      * First element is sentinel.next
      * If list is empty, sentinel.next == &sentinel, so begin() == end()
@@ -240,45 +494,50 @@ auto IntrusiveList<T>::begin() noexcept -> iterator {
     return iterator(sentinel_.next_node());
 }
 
-template <typename T>
-auto IntrusiveList<T>::cbegin() const noexcept -> const_iterator {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::cbegin() const noexcept -> const_iterator {
     return const_iterator(const_cast<NodeBase*>(sentinel_.next_node()));
 }
 
-template <typename T>
-auto IntrusiveList<T>::end() noexcept -> iterator {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::end() noexcept -> iterator {
     /**
      * end() points to the sentinel
      */
     return iterator(&sentinel_);
 }
 
-template <typename T>
-auto IntrusiveList<T>::cend() const noexcept -> const_iterator {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::cend() const noexcept -> const_iterator {
     return const_iterator(const_cast<NodeBase*>(&sentinel_));
 }
 
 /*---*---*---*---*---*---*---* Modifiers *---*---*---*---*---*---*---*/
 
-template <typename T>
-void IntrusiveList<T>::insert_after(NodeBase* after, reference value) noexcept {
-    auto& node = value;
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::insert_after(NodeBase* after, reference value) noexcept {
+    node_type& node = *hook_traits::to_node(&value);
 
-    assert(!node.is_linked() && "Element already in a list!!");
+    if constexpr (link_mode::is_safe) {
+        assert(!node.is_linked() && "Element already in a list!!");
+    }
 
     /**
      * Before : after <-> next
      * After : afetr <-> node <-> next
      */
     node.link_between(after, after->next_node());
+    size_.increment();
 }
 
-template <typename T>
-void IntrusiveList<T>::insert_before(NodeBase* before,
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::insert_before(NodeBase* before,
                                      reference value) noexcept {
-    auto& node = value;
+    node_type& node = *hook_traits::to_node(&value);
 
-    assert(!node.is_linked() && "Element already in a list!!");
+    if constexpr (link_mode::is_safe) {
+        assert(!node.is_linked() && "Element already in a list!!");
+    }
 
     /**
      * Before : prev <-> before
@@ -286,10 +545,11 @@ void IntrusiveList<T>::insert_before(NodeBase* before,
      */
 
     node.link_between(before->prev_node(), before);
+    size_.increment();
 }
 
-template <typename T>
-void IntrusiveList<T>::push_back(reference element) noexcept {
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::push_back(reference element) noexcept {
     /**
      * Before : ... <-> last <-> sentinel
      * After : ... <-> last' <-> element <-> sentinel
@@ -297,8 +557,8 @@ void IntrusiveList<T>::push_back(reference element) noexcept {
     insert_before(&sentinel_, element);
 }
 
-template <typename T>
-void IntrusiveList<T>::push_front(reference element) noexcept {
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::push_front(reference element) noexcept {
     /**
      * Before : sentinel <-> first <-> ...
      * After : sentinel <-> element <-> first' <-> ...
@@ -306,52 +566,114 @@ void IntrusiveList<T>::push_front(reference element) noexcept {
     insert_after(&sentinel_, element);
 }
 
-template <typename T>
-auto IntrusiveList<T>::insert(
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::insert(
     const_iterator pos, reference element) noexcept -> iterator {
     /**
      * insert before pos (because inserted node position will become new pos)
      */
     insert_before(pos.base(), element);
 
-    return iterator(static_cast<node_type*>(&static_cast<node_type&>(element)));
+    return iterator(hook_traits::to_node(&element));
 }
 
-template <typename T>
-void IntrusiveList<T>::pop_front() noexcept {
+template <typename T, typename... Options>
+template <typename InputIt>
+auto IntrusiveList<T, Options...>::insert_range(const_iterator pos, InputIt first,
+                                    InputIt last) noexcept -> iterator {
+    NodeBase* before = pos.base()->prev_node();
+    NodeBase* tail = before;
+    size_type cnt = 0;
+
+    for (; first != last; ++first) {
+        pointer value;
+
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<decltype(*first)>>) {
+            value = *first;
+        } else {
+            reference element = *first;
+            value = std::addressof(element);
+        }
+
+        node_type& node = *hook_traits::to_node(value);
+
+        if constexpr (link_mode::is_safe) {
+            assert(!node.is_linked() && "Element already in a list!!");
+        }
+
+        /* only the chain is written, pos keeps its prev until the end */
+        node.link_after(tail);
+        tail = &node;
+        ++cnt;
+    }
+
+    if (cnt == 0) {
+        return iterator(pos.base());
+    }
+
+    /* close the chain : tail <-> pos */
+    tail->set_next(pos.base());
+    pos.base()->set_prev(tail);
+    size_.add(cnt);
+
+    return iterator(before->next_node());
+}
+
+template <typename T, typename... Options>
+template <typename InputIt>
+void IntrusiveList<T, Options...>::push_back_range(InputIt first, InputIt last) noexcept {
+    insert_range(cend(), first, last);
+}
+
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::pop_front() noexcept {
     assert(!empty() && "pop_front() on empty list!!");
 
     /**
      * unlink the first element
      */
     static_cast<node_type*>(sentinel_.next_node())->unlink();
+    size_.decrement();
 }
 
-template <typename T>
-void IntrusiveList<T>::pop_back() noexcept {
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::pop_back() noexcept {
     assert(!empty() && "pop_front() on empty list!!");
 
     /**
      * unlink the last element
      */
     static_cast<node_type*>(sentinel_.prev_node())->unlink();
+    size_.decrement();
 }
 
-template <typename T>
-auto IntrusiveList<T>::erase(const_iterator pos) noexcept -> iterator {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::erase(const_iterator pos) noexcept -> iterator {
     assert(pos != end() && "Cannot erase sentinel...");
 
     NodeBase* node = pos.base();
     NodeBase* next = node->next_node();
 
     static_cast<node_type*>(node)->unlink();
+    size_.decrement();
 
     /* return the iterator to the element that followed the erased one */
     return iterator(next);
 }
 
-template <typename T>
-auto IntrusiveList<T>::erase_range(const_iterator first,
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::erase(reference element) noexcept -> iterator {
+    node_type& node = *hook_traits::to_node(&element);
+
+    if constexpr (link_mode::is_safe) {
+        assert(node.is_linked() && "Element is not in a list...");
+    }
+
+    return erase(const_iterator(&node));
+}
+
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::erase_range(const_iterator first,
                                    const_iterator last) noexcept -> iterator {
 
     auto it = iterator(first.base());
@@ -364,18 +686,41 @@ auto IntrusiveList<T>::erase_range(const_iterator first,
     return iterator(stop);
 }
 
-template <typename T>
-void IntrusiveList<T>::clear() noexcept {
-    /*
-     * remove all elements one by one
-     */
-    while (!empty()) {
-        pop_front();
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::clear() noexcept {
+    detach_all();
+}
+
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::detach_all() noexcept {
+    if constexpr (link_mode::is_safe) {
+        /*
+         * reset the hooks one by one, nobody stays behind to be rewired
+         */
+        NodeBase* node = sentinel_.next_node();
+
+        while (node != &sentinel_) {
+            NodeBase* next = node->next_node();
+            static_cast<node_type*>(node)->reset_hook();
+            node = next;
+        }
     }
+
+    init_sentinel();
+    size_.reset();
 }
 
-template <typename T>
-auto IntrusiveList<T>::extract_front(IntrusiveList& out,
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::release_all() noexcept {
+    static_assert(!link_mode::is_safe,
+                  "release_all() leaves stale hooks behind, only NormalLink hooks allow it (use detach_all())");
+
+    init_sentinel();
+    size_.reset();
+}
+
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::extract_front(IntrusiveList& out,
                                      size_type max_cnt) noexcept -> size_type {
     /*
      * Extract up max_cnt elements from the front to the end of outer list
@@ -392,31 +737,192 @@ auto IntrusiveList<T>::extract_front(IntrusiveList& out,
 
     /* transfer [begin, split_point) to the outer list */
     if (count > 0) {
-        splice_range(out.end(), *this, begin(), split_point);
+        out.transfer(out.end(), *this, begin(), split_point, count);
+    }
+
+    return count;
+}
+
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::extract_back(IntrusiveList& out,
+                                    size_type max_cnt) noexcept -> size_type {
+    assert(&out != this && "extract_back() into the same list...");
+
+    size_type count = 0;
+    auto split_point = end();
+
+    /* walk back from the tail */
+    while (split_point != begin() && count < max_cnt) {
+        --split_point;
+        ++count;
+    }
+
+    /* transfer [split_point, end) to the outer list */
+    if (count > 0) {
+        out.transfer(out.end(), *this, split_point, end(), count);
     }
 
     return count;
 }
 
-template <typename T>
-void IntrusiveList<T>::remove(reference element) noexcept {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::count_tail(const_iterator pos) const noexcept -> size_type {
+    static_assert(size_policy::is_counting, "count_tail() relies on the size counter");
+
     /*
-     * derived-to-base conversion : T& -> IntrusiveListNode<...>&
-     * [T must inherit from IntrusiveListNode<>]
+     * head : begin() --> pos       (n - k steps)
+     * tail : pos     --> end()     (k steps)
+     * whichever arrives first settles k
+     */
+    const NodeBase* head = sentinel_.next_node();
+    const NodeBase* tail = pos.base();
+    const NodeBase* stop = pos.base();
+    size_type steps = 0;
+
+    for (;;) {
+        if (tail == &sentinel_) {
+            return steps;
+        }
+
+        if (head == stop) {
+            return size_.count() - steps;
+        }
+
+        head = head->next_node();
+        tail = tail->next_node();
+        ++steps;
+    }
+}
+
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::split_at(const_iterator pos, IntrusiveList& out) noexcept {
+    assert(&out != this && "split_at() into the same list...");
+
+    if (pos == cend()) {
+        return;
+    }
+
+    size_type cnt = 0;
+
+    if constexpr (size_policy::is_counting) {
+        cnt = count_tail(pos);
+    }
+
+    out.transfer(out.cend(), *this, pos, cend(), cnt);
+}
+
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::split_after(const_iterator pos, IntrusiveList& out) noexcept {
+    assert(pos != cend() && "split_after() the sentinel...");
+
+    split_at(++pos, out);
+}
+
+template <typename T, typename... Options>
+template <typename Fn>
+auto IntrusiveList<T, Options...>::consume_front(size_type max_cnt, Fn fn) noexcept -> size_type {
+    if (empty() || max_cnt == 0) {
+        return 0;
+    }
+
+    /* what fn requeues at the back lands after last : never visited */
+    const NodeBase* last = sentinel_.prev_node();
+    size_type count = 0;
+    bool done = false;
+
+    while (!done) {
+        NodeBase* node = sentinel_.next_node();
+
+        /* fn erased the rest of the batch */
+        if (node == &sentinel_) {
+            break;
+        }
+
+        NodeBase* next = node->next_node();
+
+        /* advance the head only : the node leaves without rewiring itself */
+        sentinel_.set_next(next);
+        next->set_prev(&sentinel_);
+        size_.decrement();
+
+        if constexpr (link_mode::is_safe) {
+            static_cast<node_type*>(node)->reset_hook();
+        }
+
+        ++count;
+        done = (node == last || count == max_cnt);
+
+        fn(*hook_traits::to_value(node));
+
+        /* fn erased the original tail : what follows now was linked during the call */
+        if constexpr (link_mode::is_safe) {
+            if (!done && !static_cast<const node_type*>(last)->is_linked()) {
+                done = true;
+            }
+        }
+    }
+
+    return count;
+}
+
+template <typename T, typename... Options>
+template <typename Fn>
+auto IntrusiveList<T, Options...>::consume_all(Fn fn) noexcept -> size_type {
+    if (empty()) {
+        return 0;
+    }
+
+    NodeBase* node = sentinel_.next_node();
+    size_type count = 0;
+
+    /* the detached chain still ends at the sentinel */
+    init_sentinel();
+    size_.reset();
+
+    while (node != &sentinel_) {
+        /* read before fn : the node may be gone or relinked after it */
+        NodeBase* next = node->next_node();
+
+        if constexpr (link_mode::is_safe) {
+            static_cast<node_type*>(node)->reset_hook();
+        }
+
+        fn(*hook_traits::to_value(node));
+
+        node = next;
+        ++count;
+    }
+
+    return count;
+}
+
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::remove(reference element) noexcept {
+    /*
+     * hook conversion : T& -> IntrusiveListNode<...>&
+     * [derived-to-base for BaseHook<>, member access for MemberHook<>]
      *
      * Magic : this conversion unlocks self-removal because
      * any T can access its embedded list node without knowing specific list containing it.
      * => IntrusiveList<Task>::remove(*this);
      */
-    node_type& node = element;
+    static_assert(!size_policy::is_counting,
+                  "static remove() would desynchronize the size counter, use list.erase(element)");
+
+    node_type& node = *hook_traits::to_node(&element);
 
-    if (node.is_linked()) {
+    if constexpr (link_mode::is_safe) {
+        if (node.is_linked()) {
+            node.unlink();
+        }
+    } else {
+        /* NormalLink hooks cannot tell, the element must be linked */
         node.unlink();
     }
 }
 
-template <typename T>
-void IntrusiveList<T>::splice_range(
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::splice_range(
     const_iterator position, IntrusiveList& other,
     const_iterator first, const_iterator last) noexcept {
 
@@ -432,11 +938,35 @@ void IntrusiveList<T>::splice_range(
      *    this list : ... <-> before' <-> [first <-> ... <-> last] <-> position <-> after' <-> ...
      */
 
+    size_type cnt = 0;
+
+    /* the range has to be counted only when it changes owner */
+    if constexpr (size_policy::is_counting) {
+        if (this != &other) {
+            for (auto it = first; it != last; ++it) {
+                ++cnt;
+            }
+        }
+    }
+
+    transfer(position, other, first, last, cnt);
+}
+
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::transfer(
+    const_iterator position, IntrusiveList& other,
+    const_iterator first, const_iterator last, size_type cnt) noexcept {
+
+    if (this != &other) {
+        other.size_.subtract(cnt);
+        size_.add(cnt);
+    }
+
     NodeBase::transfer_range(position.base(), first.base(), last.base());
 }
 
-template <typename T>
-void IntrusiveList<T>::splice(const_iterator position,
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::splice(const_iterator position,
                               IntrusiveList& other) noexcept {
     if (other.empty()) {
         return;
@@ -446,11 +976,18 @@ void IntrusiveList<T>::splice(const_iterator position,
         return;
     }
 
-    splice_range(position, other, other.begin(), other.end());
+    /* whole list: the size is already known (or not needed) */
+    size_type cnt = 0;
+
+    if constexpr (size_policy::is_counting) {
+        cnt = other.size();
+    }
+
+    transfer(position, other, other.begin(), other.end(), cnt);
 }
 
-template <typename T>
-void IntrusiveList<T>::splice_cell(const_iterator position,
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::splice_cell(const_iterator position,
                                    IntrusiveList& other,
                                    const_iterator element) noexcept {
 
@@ -461,13 +998,18 @@ void IntrusiveList<T>::splice_cell(const_iterator position,
     auto next = element;
     ++next;
 
-    splice_range(position, other, element, next);
+    /* already in place : moving a cell before itself would unlink it for good */
+    if (position == element || position == next) {
+        return;
+    }
+
+    transfer(position, other, element, next, 1);
 }
 
 /*---*---*---*---*---*---*---*---* TRY *---*---*---*---*---*---*---*---*/
 
-template <typename T>
-auto IntrusiveList<T>::try_pop_front() noexcept -> pointer {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::try_pop_front() noexcept -> pointer {
     if (empty()) {
         return nullptr;
     }
@@ -478,8 +1020,8 @@ auto IntrusiveList<T>::try_pop_front() noexcept -> pointer {
     return result;
 }
 
-template <typename T>
-auto IntrusiveList<T>::try_pop_back() noexcept -> pointer {
+template <typename T, typename... Options>
+auto IntrusiveList<T, Options...>::try_pop_back() noexcept -> pointer {
     if (empty()) {
         return nullptr;
     }
@@ -490,4 +1032,188 @@ auto IntrusiveList<T>::try_pop_back() noexcept -> pointer {
     return res;
 }
 
+/*---*---*---*---*---*---*---*---* Algorithms *---*---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+template <typename Compare>
+auto IntrusiveList<T, Options...>::merge_chains(NodeBase* a, NodeBase* b,
+                                    Compare& comp) noexcept -> NodeBase* {
+    NodeBase head;
+    NodeBase* tail = &head;
+
+    while (a != nullptr && b != nullptr) {
+        /* take b only when strictly smaller : keeps the sort stable */
+        if (comp(*hook_traits::to_value(b), *hook_traits::to_value(a))) {
+            tail->set_next(b);
+            b = b->next_node();
+        } else {
+            tail->set_next(a);
+            a = a->next_node();
+        }
+
+        tail = tail->next_node();
+    }
+
+    tail->set_next(a != nullptr ? a : b);
+
+    return head.next_node();
+}
+
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::adopt_chain(NodeBase* head) noexcept {
+    NodeBase* prev = &sentinel_;
+
+    for (NodeBase* node = head; node != nullptr; node = node->next_node()) {
+        prev->set_next(node);
+        node->set_prev(prev);
+        prev = node;
+    }
+
+    prev->set_next(&sentinel_);
+    sentinel_.set_prev(prev);
+}
+
+template <typename T, typename... Options>
+template <typename Compare>
+void IntrusiveList<T, Options...>::sort(Compare comp) noexcept {
+    if (sentinel_.next_node() == sentinel_.prev_node()) {
+        return;
+    }
+
+    /* bins[i] : sorted run of 2^i nodes, or empty */
+    NodeBase* bins[64] = {};
+    std::size_t used = 0;
+
+    NodeBase* rest = sentinel_.next_node();
+    sentinel_.prev_node()->set_next(nullptr);
+
+    while (rest != nullptr) {
+        NodeBase* run = rest;
+        rest = rest->next_node();
+        run->set_next(nullptr);
+
+        std::size_t i = 0;
+
+        /* the older run goes first : ties keep their order */
+        for (; bins[i] != nullptr; ++i) {
+            run = merge_chains(bins[i], run, comp);
+            bins[i] = nullptr;
+        }
+
+        bins[i] = run;
+        used = (i + 1 > used) ? i + 1 : used;
+    }
+
+    /* higher bins hold earlier nodes */
+    NodeBase* sorted = nullptr;
+
+    for (std::size_t i = 0; i < used; ++i) {
+        if (bins[i] != nullptr) {
+            sorted = (sorted == nullptr) ? bins[i] : merge_chains(bins[i], sorted, comp);
+        }
+    }
+
+    adopt_chain(sorted);
+}
+
+template <typename T, typename... Options>
+template <typename Compare>
+void IntrusiveList<T, Options...>::merge(IntrusiveList& other, Compare comp) noexcept {
+    if (this == &other || other.empty()) {
+        return;
+    }
+
+    /*
+     * Walk this list, and splice in front of each position the run of other
+     * that sorts strictly before it : one transfer per run, not per element.
+     */
+    auto pos = begin();
+
+    while (pos != end() && !other.empty()) {
+        auto first = other.begin();
+
+        if (!comp(*first, *pos)) {
+            ++pos;
+            continue;
+        }
+
+        auto last = first;
+        size_type cnt = 0;
+
+        do {
+            ++last;
+            ++cnt;
+        } while (last != other.end() && comp(*last, *pos));
+
+        transfer(pos, other, first, last, cnt);
+    }
+
+    /* what is left of other sorts after everything */
+    splice(end(), other);
+}
+
+template <typename T, typename... Options>
+template <typename BinaryPred, typename Dispose>
+auto IntrusiveList<T, Options...>::unique(BinaryPred pred, Dispose dispose) noexcept -> size_type {
+    size_type removed = 0;
+
+    if (empty()) {
+        return removed;
+    }
+
+    auto kept = begin();
+    auto it = kept;
+    ++it;
+
+    while (it != end()) {
+        if (pred(*kept, *it)) {
+            reference element = *it;
+            it = erase(it);
+            dispose(element);
+            ++removed;
+        } else {
+            kept = it;
+            ++it;
+        }
+    }
+
+    return removed;
+}
+
+template <typename T, typename... Options>
+template <typename Pred, typename Dispose>
+auto IntrusiveList<T, Options...>::remove_if(Pred pred, Dispose dispose) noexcept -> size_type {
+    size_type removed = 0;
+    auto it = begin();
+
+    while (it != end()) {
+        if (pred(*it)) {
+            reference element = *it;
+            it = erase(it);
+            dispose(element);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+
+    return removed;
+}
+
+template <typename T, typename... Options>
+void IntrusiveList<T, Options...>::reverse() noexcept {
+    /*
+     * Before : sentinel <-> a <-> b <-> c <-> sentinel
+     * After  : sentinel <-> c <-> b <-> a <-> sentinel
+     */
+    NodeBase* node = &sentinel_;
+
+    do {
+        NodeBase* next = node->next_node();
+        node->set_next(node->prev_node());
+        node->set_prev(next);
+        node = next;
+    } while (node != &sentinel_);
+}
+
 /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "hash_set.hpp"
+#include "list.hpp"
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <span>
+
+/**
+ * @brief Hook tags of IntrusiveLruCache : one hook for the recency list, one for the index.
+ */
+struct LruOrderTag {};
+struct LruIndexTag {};
+
+/**
+ * @brief Default key accessor of IntrusiveLruCache : reads element.key.
+ */
+struct MemberKey {
+    template <typename T>
+    [[nodiscard]]
+    constexpr auto operator()(const T& element) const noexcept -> const auto& {
+        return element.key;
+    }
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Intrusive LRU cache : an IntrusiveHashSet index + an IntrusiveList recency order,
+ * both threaded through hooks inside T. Nothing is ever allocated.
+ *
+ *   MRU                                                 LRU
+ *   front <-> ...  <-> ... <-> ...  <-> ... <-> ... <-> back    (LruOrderTag hook)
+ *
+ *   bucket[0] <-> ...                                            (LruIndexTag hook)
+ *   bucket[1] <-> ... <-> ...
+ *
+ *  >> find()     : O(1) average, lookup only
+ *  >> get()      : find() + touch()
+ *  >> touch()    : O(1), relinks the element at the MRU end
+ *  >> insert()   : O(1) average, the new element is the MRU one
+ *  >> erase()    : O(1), both hooks
+ *  >> evict_n()  : one walk over the n LRU elements (index unlink), then one range transfer
+ *
+ * The cache has no capacity of its own : the caller decides when to evict (size() is O(1))
+ * and what to do with the evicted objects, which come back unlinked from both hooks.
+ *
+ * @tparam K      Key type
+ * @tparam T      Element : IntrusiveListNode<LruOrderTag, SafeLink>, IntrusiveListNode<LruIndexTag, ...>
+ *                (the recency list counts, so its hook cannot be AutoUnlink)
+ * @tparam KeyOf  Functor returning the key of an element, default MemberKey (element.key)
+ * @tparam KeyHash, KeyEq Hash and equality of K
+ *
+ * >> USAGE :
+ *  struct Blob : IntrusiveListNode<LruOrderTag, SafeLink>, IntrusiveListNode<LruIndexTag> {
+ *    std::uint64_t key;
+ *  };
+ *
+ *  using Cache = IntrusiveLruCache<std::uint64_t, Blob>;
+ *
+ *  Cache::bucket_type buckets[1 << 20];
+ *  Cache cache(buckets);
+ */
+template <typename K, typename T, typename KeyOf = MemberKey, typename KeyHash = std::hash<K>,
+          typename KeyEq = std::equal_to<K>>
+class IntrusiveLruCache {
+  public:
+    using key_type = K;
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using size_type = std::size_t;
+
+    using order_type = IntrusiveList<T, BaseHook<LruOrderTag>, CountingPolicy>;
+
+  private:
+    /* hash / equality of the index : on keys and on elements */
+    struct IndexHash {
+        [[no_unique_address]] KeyOf key_of;
+        [[no_unique_address]] KeyHash hash;
+
+        std::size_t operator()(const K& key) const noexcept { return hash(key); }
+        std::size_t operator()(const T& element) const noexcept { return hash(key_of(element)); }
+    };
+
+    struct IndexEq {
+        [[no_unique_address]] KeyOf key_of;
+        [[no_unique_address]] KeyEq eq;
+
+        bool operator()(const K& key, const T& element) const noexcept {
+            return eq(key, key_of(element));
+        }
+
+        bool operator()(const T& a, const T& b) const noexcept {
+            return eq(key_of(a), key_of(b));
+        }
+    };
+
+  public:
+    using index_type = IntrusiveHashSet<T, IndexHash, IndexEq, BaseHook<LruIndexTag>>;
+    using bucket_type = typename index_type::bucket_type;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @param buckets Index storage, a power of two of them, must outlive the cache.
+     */
+    explicit IntrusiveLruCache(std::span<bucket_type> buckets) noexcept;
+
+    ~IntrusiveLruCache();
+
+    IntrusiveLruCache(const IntrusiveLruCache&) = delete;
+    IntrusiveLruCache& operator=(const IntrusiveLruCache&) = delete;
+
+    IntrusiveLruCache(IntrusiveLruCache&&) noexcept = delete;
+    IntrusiveLruCache& operator=(IntrusiveLruCache&&) noexcept = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief Adds element as the most recently used one.
+     *
+     * @return false (and nothing is linked) if an element with the same key is cached.
+     */
+    bool insert(reference element) noexcept;
+
+    /**
+     * @brief Marks a cached element as the most recently used one.
+     */
+    void touch(reference element) noexcept;
+
+    void erase(reference element) noexcept;
+
+    /**
+     * @brief Moves up to n least recently used elements to the back of out,
+     * most recent first, unlinked from the index.
+     *
+     * @return Number of elements evicted.
+     */
+    auto evict_n(size_type n, order_type& out) noexcept -> size_type;
+
+    /**
+     * @brief Forgets every element, hooks reset.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Grows (or shrinks) the index to buckets, incrementally : see IntrusiveHashSet::rehash().
+     */
+    void rehash(std::span<bucket_type> buckets) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief Lookup without changing the recency order.
+     */
+    [[nodiscard]]
+    auto find(const K& key) noexcept -> pointer;
+
+    /**
+     * @brief Lookup, a hit becomes the most recently used element.
+     */
+    [[nodiscard]]
+    auto get(const K& key) noexcept -> pointer;
+
+    /* the old index buckets are still in use while true */
+    [[nodiscard]] bool rehashing() const noexcept;
+
+    /**
+     * @brief Least recently used element.
+     */
+    [[nodiscard]]
+    auto lru() noexcept -> reference;
+
+    /**
+     * @brief Most recently used element.
+     */
+    [[nodiscard]]
+    auto mru() noexcept -> reference;
+
+    [[nodiscard]] bool empty() const noexcept;
+
+    [[nodiscard]]
+    auto size() const noexcept -> size_type;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    index_type index_;
+    order_type order_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::IntrusiveLruCache(
+    std::span<bucket_type> buckets) noexcept
+    : index_(buckets) {}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::~IntrusiveLruCache() {
+    clear();
+}
+
+/*---*---*---*---*---*---*---* Lookup *---*---*---*---*---*---*---*/
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+auto IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::find(const K& key) noexcept -> pointer {
+    return index_.find(key);
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+auto IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::get(const K& key) noexcept -> pointer {
+    pointer element = index_.find(key);
+
+    if (element != nullptr) {
+        touch(*element);
+    }
+
+    return element;
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+auto IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::lru() noexcept -> reference {
+    assert(!empty() && "lru() called on empty cache...");
+    return order_.back();
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+auto IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::mru() noexcept -> reference {
+    assert(!empty() && "mru() called on empty cache...");
+    return order_.front();
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+bool IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::rehashing() const noexcept {
+    return index_.rehashing();
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+bool IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::empty() const noexcept {
+    return order_.empty();
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+auto IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::size() const noexcept -> size_type {
+    return order_.size();
+}
+
+/*---*---*---*---*---*---*---* Modifiers *---*---*---*---*---*---*---*/
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+bool IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::insert(reference element) noexcept {
+    if (!index_.insert(element)) {
+        return false;
+    }
+
+    order_.push_front(element);
+
+    return true;
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+void IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::touch(reference element) noexcept {
+    /**
+     * Before : front <-> ... <-> prev <-> element <-> next <-> ...
+     * After  : element <-> front <-> ... <-> prev <-> next <-> ...
+     */
+    using order_iterator = typename order_type::const_iterator;
+
+    order_.splice_cell(order_.cbegin(), order_,
+                       order_iterator(order_type::hook_traits::to_node(&element)));
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+void IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::erase(reference element) noexcept {
+    index_.erase(element);
+    order_.erase(element);
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+auto IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::evict_n(size_type n,
+                                                             order_type& out) noexcept
+    -> size_type {
+    if (n == 0 || order_.empty()) {
+        return 0;
+    }
+
+    /* ONE walk : find the first element of the evicted tail, dropping the index links on the way */
+    auto first = order_.end();
+    size_type count = 0;
+
+    while (count < n && first != order_.begin()) {
+        --first;
+        ++count;
+
+        index_.erase(*first);
+    }
+
+    /* detach the whole tail at once, already counted : no recount of the range */
+    out.transfer(out.cend(), order_, first, order_.cend(), count);
+
+    return count;
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+void IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::clear() noexcept {
+    index_.clear();
+    order_.clear();
+}
+
+template <typename K, typename T, typename KeyOf, typename KeyHash, typename KeyEq>
+void IntrusiveLruCache<K, T, KeyOf, KeyHash, KeyEq>::rehash(std::span<bucket_type> buckets) noexcept {
+    index_.rehash(buckets);
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
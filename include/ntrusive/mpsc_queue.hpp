@@ -0,0 +1,260 @@
+#pragma once
+
+#include "base_node.hpp"
+#include "config.hpp"
+#include "list.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief Lock-free intrusive multi-producer / single-consumer queue (Vyukov).
+ *
+ * Reuses the IntrusiveListNode<...> hook of T (the same hook options as IntrusiveList),
+ * only its next_ pointer is used, through std::atomic_ref.
+ *
+ *  >> push()     : wait-free, any thread, one exchange + one store
+ *  >> try_pop()  : consumer only, lock-free
+ *  >> pop_all()  : consumer only, takes everything pushed so far with ONE exchange
+ *                  and hands it over as an IntrusiveList<T, Options...>
+ *
+ * >> OWNERSHIP : while queued, the hook belongs to the queue. Do not link the element
+ *    anywhere else and do not destroy it. Popped elements come out with a reset hook.
+ *    is_linked() is meaningless while queued, TrackedLink hooks are rejected at compile time.
+ *
+ * >> CAVEAT : a producer preempted between its exchange and its store hides the
+ *    elements pushed after it until it resumes, try_pop() then returns nullptr
+ *    although the queue is not empty (inherent to the algorithm).
+ *
+ * >> USAGE :
+ *  IntrusiveMpscQueue<Task> queue;
+ *
+ *  queue.push(task);                  // producers
+ *
+ *  IntrusiveList<Task> batch;
+ *  queue.pop_all(batch);              // consumer
+ */
+template <typename T, typename... Options>
+class IntrusiveMpscQueue {
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using size_type = std::size_t;
+
+    using hook_traits = typename ListOptions<T, Options...>::hook_traits;
+    using node_type = typename hook_traits::node_type;
+
+    using list_type = IntrusiveList<T, Options...>;
+
+    /* the last queued node has a null next_ : a TrackedLink flag could not agree with it */
+    static_assert(!node_type::link_mode::is_tracked,
+                  "IntrusiveMpscQueue does not maintain the flag of TrackedLink hooks");
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    IntrusiveMpscQueue() noexcept;
+
+    ~IntrusiveMpscQueue();
+
+    IntrusiveMpscQueue(const IntrusiveMpscQueue&) = delete;
+    IntrusiveMpscQueue& operator=(const IntrusiveMpscQueue&) = delete;
+
+    IntrusiveMpscQueue(IntrusiveMpscQueue&&) = delete;
+    IntrusiveMpscQueue& operator=(IntrusiveMpscQueue&&) = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief Enqueues an element. Wait-free, callable from any thread.
+     */
+    void push(reference element) noexcept;
+
+    /**
+     * @brief Dequeues the oldest element, nullptr if nothing is visible yet.
+     * Consumer thread only.
+     */
+    [[nodiscard]]
+    auto try_pop() noexcept -> pointer;
+
+    /**
+     * @brief Moves every visible element to the back of out, in FIFO order.
+     * Consumer thread only.
+     *
+     * @return Number of elements moved.
+     */
+    auto pop_all(list_type& out) noexcept -> size_type;
+
+    /**
+     * @brief Consumer side view : true if nothing is visible to pop.
+     */
+    [[nodiscard]]
+    bool empty() const noexcept;
+
+  private:
+    void push_node(NodeBase* node) noexcept;
+
+    [[nodiscard]]
+    static NodeBase* load_next(NodeBase* node) noexcept;
+
+    /* resets the hook and converts back to T* */
+    [[nodiscard]]
+    static pointer release(NodeBase* node) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    /* producers : last pushed node */
+    alignas(kCacheLineSize) std::atomic<NodeBase*> tail_;
+
+    /* consumer : oldest node, may be the stub */
+    alignas(kCacheLineSize) NodeBase* head_;
+
+    NodeBase stub_;
+
+    /* consumer only : is stub_ currently somewhere in the chain? */
+    bool stub_queued_{true};
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+IntrusiveMpscQueue<T, Options...>::IntrusiveMpscQueue() noexcept
+    : tail_(&stub_), head_(&stub_) {}
+
+template <typename T, typename... Options>
+IntrusiveMpscQueue<T, Options...>::~IntrusiveMpscQueue() {
+    /**
+     * elements are not owned : whatever is still queued is simply forgotten
+     */
+    assert(empty() && "destroying non-empty IntrusiveMpscQueue...");
+}
+
+template <typename T, typename... Options>
+NodeBase* IntrusiveMpscQueue<T, Options...>::load_next(NodeBase* node) noexcept {
+    return std::atomic_ref<NodeBase*>(node->next_).load(std::memory_order_acquire);
+}
+
+template <typename T, typename... Options>
+auto IntrusiveMpscQueue<T, Options...>::release(NodeBase* node) noexcept -> pointer {
+    node->reset_base();
+    return hook_traits::to_value(node);
+}
+
+template <typename T, typename... Options>
+void IntrusiveMpscQueue<T, Options...>::push_node(NodeBase* node) noexcept {
+    std::atomic_ref<NodeBase*>(node->next_).store(nullptr, std::memory_order_relaxed);
+
+    /**
+     * Before : ... <-> prev
+     * After  : ... <-> prev -> node    (the arrow appears at the store below)
+     */
+    NodeBase* prev = tail_.exchange(node, std::memory_order_acq_rel);
+
+    std::atomic_ref<NodeBase*>(prev->next_).store(node, std::memory_order_release);
+}
+
+template <typename T, typename... Options>
+void IntrusiveMpscQueue<T, Options...>::push(reference element) noexcept {
+    push_node(hook_traits::to_node(&element));
+}
+
+template <typename T, typename... Options>
+auto IntrusiveMpscQueue<T, Options...>::try_pop() noexcept -> pointer {
+    NodeBase* head = head_;
+    NodeBase* next = load_next(head);
+
+    /* skip the stub */
+    if (head == &stub_) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+
+        head_ = next;
+        head = next;
+        next = load_next(next);
+        stub_queued_ = false;
+    }
+
+    if (next != nullptr) {
+        head_ = next;
+        return release(head);
+    }
+
+    if (head != tail_.load(std::memory_order_acquire)) {
+        /* a producer is between its exchange and its store */
+        return nullptr;
+    }
+
+    /* head is the only node : put the stub behind it so it can be detached */
+    push_node(&stub_);
+    stub_queued_ = true;
+
+    next = load_next(head);
+
+    if (next != nullptr) {
+        head_ = next;
+        return release(head);
+    }
+
+    return nullptr;
+}
+
+template <typename T, typename... Options>
+auto IntrusiveMpscQueue<T, Options...>::pop_all(list_type& out) noexcept -> size_type {
+    size_type count = 0;
+
+    /**
+     * Everything pushed before the stub is ours, so :
+     *   1. get the stub out of the chain (it may have been queued by try_pop())
+     *   2. push it : ONE exchange closes the batch
+     *   3. walk [head_, stub) into out
+     */
+    for (;;) {
+        if (head_ == &stub_) {
+            NodeBase* next = load_next(&stub_);
+
+            if (next == nullptr) {
+                return count;
+            }
+
+            head_ = next;
+            stub_queued_ = false;
+        }
+
+        bool closed = false;
+
+        if (!stub_queued_) {
+            push_node(&stub_);
+            stub_queued_ = true;
+            closed = true;
+        }
+
+        while (head_ != &stub_) {
+            NodeBase* next = load_next(head_);
+
+            if (next == nullptr) {
+                /* a producer has not linked its node yet, leave the rest for later */
+                return count;
+            }
+
+            out.push_back(*release(std::exchange(head_, next)));
+            ++count;
+        }
+
+        if (closed) {
+            return count;
+        }
+    }
+}
+
+template <typename T, typename... Options>
+bool IntrusiveMpscQueue<T, Options...>::empty() const noexcept {
+    return head_ == &stub_ &&
+           std::atomic_ref<NodeBase*>(const_cast<NodeBase&>(stub_).next_).load(std::memory_order_acquire) == nullptr;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -1,24 +1,80 @@
 #pragma once
 
 #include "base_node.hpp"
+#include "policy.hpp"
 #include <cassert>
 #include <cstdio>
 
+/**
+ * @brief Default tag of IntrusiveListNode<>.
+ */
+struct DefaultTag {};
+
+/**
+ * @brief Explicit linked flag, only stored by TrackedLink hooks.
+ *
+ * The other modes derive linked-ness from the pointers and keep an empty
+ * LinkedFlag<false>, which takes no space as a [[no_unique_address]] member.
+ */
+template <bool Tracked>
+struct LinkedFlag {
+    constexpr void set(bool) noexcept {}
+
+    /* @param derived Linked state read from the hook pointers */
+    [[nodiscard]]
+    constexpr bool get(bool derived) const noexcept { return derived; }
+};
+
+template <>
+struct LinkedFlag<true> {
+    constexpr void set(bool linked) noexcept { linked_ = linked; }
+
+    [[nodiscard]]
+    constexpr bool get([[maybe_unused]] bool derived) const noexcept {
+        assert(linked_ == derived && "linked flag out of sync with the hook pointers...");
+        return linked_;
+    }
+
+  private:
+    bool linked_{false};
+};
+
 /**
  * @brief Intrusive List Node.
- * Inherit from this class to make your object linkable.
+ * Inherit from this class (or embed it as a member) to make your object linkable.
  *
- * >> SAFETY : Automatically unlinks on destruction.
+ * >> SAFETY : Automatically unlinks on destruction (default AutoUnlink mode,
+ *             see policy.hpp for NormalLink / SafeLink / TrackedLink).
+ *
+ * >> LAYOUT : two pointers (16 bytes), linked-ness is next_ != nullptr.
+ *             TrackedLink adds an explicit flag for debugging (24 bytes).
  *
  * >> USAGE :
- *  struct Task : IntrusiveListNode {
+ *  struct Task : IntrusiveListNode<> {
  *    void whatever(...);
  *  };
  *
+ * >> MULTIPLE LISTS : every distinct Tag is a distinct hook, so one object can
+ *    sit in as many lists as it has hooks (base or member ones) :
+ *
+ *  struct LruTag {};
+ *  struct ReadyTag {};
+ *
+ *  struct Conn : IntrusiveListNode<LruTag>, IntrusiveListNode<ReadyTag> {
+ *    IntrusiveListNode<> timeout_hook_;
+ *  };
+ *
+ *  IntrusiveList<Conn, BaseHook<LruTag>> lru;
+ *  IntrusiveList<Conn, BaseHook<ReadyTag>> ready;
+ *  IntrusiveList<Conn, MemberHook<&Conn::timeout_hook_>> timeouts;
  *
  */
+template <typename Tag = DefaultTag, LinkMode Mode = AutoUnlink>
 class IntrusiveListNode : public NodeBase {
   public:
+    using tag_type = Tag;
+    using link_mode = Mode;
+
     constexpr IntrusiveListNode() noexcept = default;
 
     ~IntrusiveListNode();
@@ -35,6 +91,8 @@ class IntrusiveListNode : public NodeBase {
 
     /**
      * @brief Is this node currently in a list?
+     *
+     * Not tracked by NormalLink hooks.
      */
     [[nodiscard]]
     constexpr bool is_linked() const noexcept;
@@ -46,71 +104,100 @@ class IntrusiveListNode : public NodeBase {
 
   private:
     /**
-     * @brief marks node as linked.
+     * @brief Link this node this with two others
      */
-    constexpr void set_linked() noexcept;
+    void link_between(NodeBase* prev, NodeBase* next) noexcept;
 
-  private:
     /**
-     * @brief Link this node this with two others
+     * @brief Hangs this node after prev, one side only (prev -> this, this -> prev).
+     *
+     * For building a chain node by node : next_ is written by whoever comes next.
      */
-    void link_between(NodeBase* prev, NodeBase* next) noexcept;
+    void link_after(NodeBase* prev) noexcept;
+
+    /**
+     * @brief Forget the list without touching the neighbors (bulk detach).
+     */
+    void reset_hook() noexcept;
 
     /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
 
   private:
-    bool is_linked_{false};
+    [[no_unique_address]] LinkedFlag<Mode::is_tracked> linked_;
 
-    template <typename>
+    template <typename, typename...>
     friend class IntrusiveList;
-
-    template <typename>
-    friend class ListIterator;
 };
 
-/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+static_assert(sizeof(IntrusiveListNode<>) == sizeof(NodeBase), "untracked hook must stay two pointers");
 
-IntrusiveListNode::~IntrusiveListNode() {
-    /* Warn!!! */
-    if (is_linked_) {
-        #ifndef NDEBUG
-        fprintf(stderr,
-                        "[ntrusive] : WARNING : destroying node still in list.. auto-unlinking..\n");
-        #endif
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
 
-        unlink();
+template <typename Tag, LinkMode Mode>
+IntrusiveListNode<Tag, Mode>::~IntrusiveListNode() {
+    if constexpr (Mode::is_auto_unlink) {
+        /* Warn!!! */
+        if (is_linked()) {
+            #ifndef NDEBUG
+            fprintf(stderr,
+                            "[ntrusive] : WARNING : destroying node still in list.. auto-unlinking..\n");
+            #endif
+
+            unlink();
+        }
+    } else if constexpr (Mode::is_safe) {
+        assert(!is_linked() && "destroying node still in list...");
     }
 }
 
-constexpr bool IntrusiveListNode::is_linked() const noexcept {
-    return is_linked_;
-}
+template <typename Tag, LinkMode Mode>
+constexpr bool IntrusiveListNode<Tag, Mode>::is_linked() const noexcept {
+    static_assert(Mode::is_safe, "NormalLink hooks do not track whether they are linked");
 
-void IntrusiveListNode::unlink() noexcept {
+    return linked_.get(is_linked_base());
+}
 
-    assert(is_linked_ && "attempting to unlink node not in a list...");
+template <typename Tag, LinkMode Mode>
+void IntrusiveListNode<Tag, Mode>::unlink() noexcept {
 
     /* ................... */
 
-    unlink_base();
-    is_linked_ = false;
+    if constexpr (Mode::is_safe) {
+        assert(is_linked() && "attempting to unlink node not in a list...");
 
-    /* ................... */
-}
+        unlink_base();
+        linked_.set(false);
+    } else {
+        /* NormalLink : nobody looks at this hook until it is linked again */
+        unlink_base_fast();
+    }
 
-constexpr void IntrusiveListNode::set_linked() noexcept {
-    is_linked_ = true;
+    /* ................... */
 }
 
-void IntrusiveListNode::link_between(NodeBase* prev,
-                                     NodeBase* next) noexcept {
+template <typename Tag, LinkMode Mode>
+void IntrusiveListNode<Tag, Mode>::link_between(NodeBase* prev,
+                                                NodeBase* next) noexcept {
 
     /* ................... */
 
     link_between_base(prev, next);
-    set_linked();
+    linked_.set(true);
 
     /* ................... */
 }
 
+template <typename Tag, LinkMode Mode>
+void IntrusiveListNode<Tag, Mode>::link_after(NodeBase* prev) noexcept {
+    set_prev(prev);
+    prev->set_next(this);
+    linked_.set(true);
+}
+
+template <typename Tag, LinkMode Mode>
+void IntrusiveListNode<Tag, Mode>::reset_hook() noexcept {
+    reset_base();
+    linked_.set(false);
+}
+
 /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "list.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Fewest elements a part of a parallel call gets : below that the
+ * list is processed on the calling thread.
+ */
+inline constexpr std::size_t kParallelGrain = 4096;
+
+/**
+ * @brief Stable sort of list on pool, relinking only.
+ *
+ *   list ----split--------->  [ part 0 ] [ part 1 ] ... [ part k-1 ]    one walk
+ *                                 | sort()    | sort()       | sort()    k tasks
+ *                                 +-merge()---+     ...      |          log2(k) rounds of
+ *                                       +------merge()-------+          pairwise merges
+ *                                              |
+ *   list <-------------splice()----------------+
+ *
+ * k is the thread count of pool, fewer when a part would hold less than kParallelGrain
+ * elements. The parts are local lists : moving them costs one transfer each, only the
+ * walk to find the split points and the final merges stay O(n) on one thread.
+ * The split is a single walk for counting and non-counting lists alike, the latter
+ * get parts equal up to a few percent.
+ *
+ * comp is called concurrently and must not throw. The calling thread blocks until
+ * the pool is done : never call it from a task of the same pool.
+ */
+template <typename T, typename... Options, typename Compare = std::less<>>
+void parallel_sort(IntrusiveList<T, Options...>& list, ThreadPool& pool, Compare comp = {});
+
+/**
+ * @brief Calls fn(element) on every element of list, the parts running on pool.
+ *
+ * Split as parallel_sort() does, then spliced back in the same order. fn is called
+ * concurrently (on different elements), must not throw, and must not link or unlink
+ * elements of list. Same blocking rule as parallel_sort().
+ */
+template <typename T, typename... Options, typename Fn>
+void parallel_for_each(IntrusiveList<T, Options...>& list, Fn fn, ThreadPool& pool);
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+/* one part of a parallel call, as a pool task */
+template <typename Body>
+struct ParallelPart : PoolTask {
+    Body* body{nullptr};
+    std::size_t index{0};
+    std::latch* done{nullptr};
+
+    void run() noexcept override {
+        (*body)(index);
+        done->count_down();
+    }
+};
+
+/*
+ * Runs body(0) ... body(parts - 1) on pool and waits for all of them.
+ * The parts array is heap-allocated on every call (parts is only known at run time) :
+ * one allocation per parallel call, negligible next to kParallelGrain elements per part.
+ */
+template <typename Body>
+void parallel_run(ThreadPool& pool, std::size_t parts, Body& body) {
+    std::latch done(static_cast<std::ptrdiff_t>(parts));
+    auto tasks = std::make_unique<ParallelPart<Body>[]>(parts);
+
+    ThreadPool::task_list batch;
+
+    for (std::size_t i = 0; i < parts; ++i) {
+        tasks[i].body = &body;
+        tasks[i].index = i;
+        tasks[i].done = &done;
+        batch.push_back(tasks[i]);
+    }
+
+    pool.submit_batch(batch);
+    done.wait();
+}
+
+/*
+ * Moves list into parts local lists of (almost) equal length, in one walk.
+ * Returns nullptr, list untouched, when it is not worth splitting.
+ *
+ *  >> counting list     : size() is O(1), the extract_front()s walk the list once
+ *  >> non-counting list : one walk counts it and drops a mark every stride nodes
+ *     (at most 2 * kSplitMarks marks, stride doubles when they run out), the cuts go
+ *     to the nearest marks with O(1) split_at()s : parts are equal up to stride / 2
+ *     on each side, under 1/16 of a part
+ */
+template <typename List>
+auto parallel_split(List& list, ThreadPool& pool, std::size_t& parts) -> std::unique_ptr<List[]> {
+    const std::size_t threads = pool.thread_count();
+
+    if (threads < 2) {
+        parts = 1;
+        return nullptr;
+    }
+
+    if constexpr (List::size_policy::is_counting) {
+        const std::size_t n = list.size();
+        parts = std::min(threads, n / kParallelGrain);
+
+        if (parts < 2) {
+            return nullptr;
+        }
+
+        auto sub = std::make_unique<List[]>(parts);
+
+        const std::size_t base = n / parts;
+        const std::size_t extra = n % parts;
+
+        for (std::size_t i = 0; i + 1 < parts; ++i) {
+            const std::size_t want = base + (i < extra ? 1 : 0);
+
+            [[maybe_unused]] const std::size_t moved = list.extract_front(sub[i], want);
+            assert(moved == want && "list changed while being split...");
+        }
+
+        sub[parts - 1].splice(sub[parts - 1].end(), list);
+
+        return sub;
+    } else {
+        const std::size_t kSplitMarks = 8 * threads;
+
+        /* marks[j] is the node at position j * stride */
+        std::vector<typename List::iterator> marks;
+        marks.reserve(2 * kSplitMarks);
+
+        std::size_t stride = 1;
+        std::size_t n = 0;
+
+        for (auto it = list.begin(); it != list.end(); ++it, ++n) {
+            if (n != marks.size() * stride) {
+                continue;
+            }
+
+            if (marks.size() == 2 * kSplitMarks) {
+                /* keep every other mark : n is still the next one at twice the stride */
+                for (std::size_t j = 0; j < kSplitMarks; ++j) {
+                    marks[j] = marks[2 * j];
+                }
+
+                marks.resize(kSplitMarks);
+                stride *= 2;
+            }
+
+            marks.push_back(it);
+        }
+
+        parts = std::min(threads, n / kParallelGrain);
+
+        if (parts < 2) {
+            return nullptr;
+        }
+
+        auto sub = std::make_unique<List[]>(parts);
+
+        /* back to front : every split_at() leaves the marks in front of it valid */
+        for (std::size_t i = parts - 1; i > 0; --i) {
+            const std::size_t want = i * n / parts;
+            const std::size_t mark = std::min((want + stride / 2) / stride, marks.size() - 1);
+
+            list.split_at(marks[mark], sub[i]);
+        }
+
+        sub[0].splice(sub[0].end(), list);
+
+        return sub;
+    }
+}
+
+template <typename T, typename... Options, typename Compare>
+void parallel_sort(IntrusiveList<T, Options...>& list, ThreadPool& pool, Compare comp) {
+    std::size_t parts = 0;
+    auto sub = parallel_split(list, pool, parts);
+
+    if (sub == nullptr) {
+        list.sort(comp);
+        return;
+    }
+
+    auto sort_part = [&](std::size_t i) { sub[i].sort(comp); };
+    parallel_run(pool, parts, sort_part);
+
+    /* round with step s merges part i + s into part i, for every i multiple of 2s */
+    for (std::size_t step = 1; step < parts; step *= 2) {
+        const std::size_t pairs = (parts - step + 2 * step - 1) / (2 * step);
+
+        auto merge_pair = [&](std::size_t j) {
+            const std::size_t i = j * 2 * step;
+            sub[i].merge(sub[i + step], comp);
+        };
+
+        if (pairs == 1) {
+            merge_pair(0);
+        } else {
+            parallel_run(pool, pairs, merge_pair);
+        }
+    }
+
+    list.splice(list.end(), sub[0]);
+}
+
+template <typename T, typename... Options, typename Fn>
+void parallel_for_each(IntrusiveList<T, Options...>& list, Fn fn, ThreadPool& pool) {
+    std::size_t parts = 0;
+    auto sub = parallel_split(list, pool, parts);
+
+    if (sub == nullptr) {
+        for (T& element : list) {
+            fn(element);
+        }
+
+        return;
+    }
+
+    auto visit_part = [&](std::size_t i) {
+        for (T& element : sub[i]) {
+            fn(element);
+        }
+    };
+
+    parallel_run(pool, parts, visit_part);
+
+    for (std::size_t i = 0; i < parts; ++i) {
+        list.splice(list.end(), sub[i]);
+    }
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
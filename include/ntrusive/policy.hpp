@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+
+/**
+ * @brief Size policies for IntrusiveList<T, SizePolicy>.
+ *
+ * The policy is stored inside the list as [[no_unique_address]], so the
+ * default one costs neither memory nor instructions.
+ *
+ *  >> NonCountingPolicy : (default) no counter, size() walks the chain in O(n)
+ *
+ *  >> CountingPolicy    : keeps a counter, size() is O(1)
+ *
+ * @section TRADE-OFFS of CountingPolicy
+ *
+ *  >> Every push/insert/erase/pop does one extra increment/decrement.
+ *
+ *  >> splice_range() from ANOTHER list has to walk the moved range to count it (O(k)).
+ *     Splicing inside the same list, splice(), splice_cell() and extract_front() stay cheap.
+ *
+ *  >> Static IntrusiveList::remove() cannot reach the owning list's counter,
+ *     so it does not compile for counting lists. Use list.erase(element) instead.
+ *
+ *  >> node.unlink() bypasses the list as well: unlinking a node behind the list's
+ *     back desynchronizes the counter. For the same reason a counting list does
+ *     not compile with AutoUnlink hooks (~IntrusiveListNode() would unlink silently).
+ */
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+template <typename P>
+concept SizePolicy = requires(P p, const P cp, std::size_t n) {
+    { P::is_counting } -> std::convertible_to<bool>;
+    p.increment();
+    p.decrement();
+    p.add(n);
+    p.subtract(n);
+    p.reset();
+    { cp.count() } -> std::same_as<std::size_t>;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+struct NonCountingPolicy {
+    static constexpr bool is_counting = false;
+
+    constexpr void increment() noexcept {}
+    constexpr void decrement() noexcept {}
+    constexpr void add(std::size_t) noexcept {}
+    constexpr void subtract(std::size_t) noexcept {}
+    constexpr void reset() noexcept {}
+
+    /* never called by IntrusiveList, present only to satisfy SizePolicy */
+    [[nodiscard]]
+    constexpr std::size_t count() const noexcept { return 0; }
+};
+
+struct CountingPolicy {
+    static constexpr bool is_counting = true;
+
+    constexpr void increment() noexcept {
+        ++count_;
+    }
+
+    constexpr void decrement() noexcept {
+        assert(count_ > 0 && "size counter underflow...");
+        --count_;
+    }
+
+    constexpr void add(std::size_t n) noexcept {
+        count_ += n;
+    }
+
+    constexpr void subtract(std::size_t n) noexcept {
+        assert(count_ >= n && "size counter underflow...");
+        count_ -= n;
+    }
+
+    constexpr void reset() noexcept {
+        count_ = 0;
+    }
+
+    [[nodiscard]]
+    constexpr std::size_t count() const noexcept {
+        return count_;
+    }
+
+  private:
+    std::size_t count_{0};
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Link modes of IntrusiveListNode<Tag, Mode>.
+ *
+ *  >> NormalLink  : unlink only rewires the neighbors, the hook keeps stale pointers.
+ *                   No is_linked(), no checks in the destructor.
+ *                   clear() is O(1) and release_all() is available.
+ *
+ *  >> SafeLink    : unlink resets the hook, is_linked() is reliable,
+ *                   destroying a linked node is a bug (assert).
+ *                   clear() walks once, resetting hooks only.
+ *
+ *  >> AutoUnlink  : (default) SafeLink + the destructor unlinks a still linked node.
+ *                   clear() walks once, resetting hooks only.
+ *                   Does not combine with CountingPolicy.
+ *
+ *  >> TrackedLink : debug variant of AutoUnlink. Keeps an explicit linked flag next
+ *                   to the pointers and asserts on every check that both agree.
+ *                   The hook grows from 16 to 24 bytes and every link/unlink pays one more store.
+ *
+ * All modes but TrackedLink keep the hook at two pointers : a safe hook is linked
+ * iff its next_ is non-null (unlinked hooks are reset to null).
+ */
+
+template <typename M>
+concept LinkMode = requires {
+    { M::is_safe } -> std::convertible_to<bool>;
+    { M::is_auto_unlink } -> std::convertible_to<bool>;
+    { M::is_tracked } -> std::convertible_to<bool>;
+};
+
+struct NormalLink {
+    static constexpr bool is_safe = false;
+    static constexpr bool is_auto_unlink = false;
+    static constexpr bool is_tracked = false;
+};
+
+struct SafeLink {
+    static constexpr bool is_safe = true;
+    static constexpr bool is_auto_unlink = false;
+    static constexpr bool is_tracked = false;
+};
+
+struct AutoUnlink {
+    static constexpr bool is_safe = true;
+    static constexpr bool is_auto_unlink = true;
+    static constexpr bool is_tracked = false;
+};
+
+struct TrackedLink {
+    static constexpr bool is_safe = true;
+    static constexpr bool is_auto_unlink = true;
+    static constexpr bool is_tracked = true;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
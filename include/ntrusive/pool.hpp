@@ -0,0 +1,465 @@
+#pragma once
+
+#include "list.hpp"
+#include "policy.hpp"
+#include "slist.hpp"
+#include "slist_node.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Hook tag of the free slots of IntrusivePool.
+ */
+struct PoolFreeTag {};
+
+/**
+ * @brief Slab allocator of T objects whose free-list runs through the free objects themselves.
+ *
+ * Memory comes in slabs of SlabObjects slots. A free slot holds an IntrusiveSListNode
+ * in place of the T it will become, so the free-list costs no memory at all :
+ *
+ *   slab : [ header | T (live) | free -> | T (live) | free -> | ... ]
+ *                                  \____________________/
+ *
+ *  >> acquire() / release()       : O(1), one lock of the shared depot
+ *  >> acquire_batch(n, list)      : n objects for one lock, linked into an IntrusiveList
+ *  >> release_batch(list)         : the whole list for one lock (one splice)
+ *  >> LocalCache                  : per-thread front-end, no lock at all until it has to
+ *                                   refill (extract_front) or spill (splice) kCacheBatch slots
+ *
+ * Slabs are only returned to the system by the destructor, every object must have
+ * been released by then.
+ *
+ * @tparam SlabObjects Slots carved at once when the depot runs dry.
+ *
+ * >> USAGE :
+ *  IntrusivePool<Request> pool;
+ *
+ *  // per worker thread
+ *  IntrusivePool<Request>::LocalCache cache(pool);
+ *
+ *  Request* r = cache.acquire(args...);
+ *  ...
+ *  cache.release(r);
+ */
+template <typename T, std::size_t SlabObjects = 256>
+class IntrusivePool {
+    static_assert(SlabObjects > 0, "a slab holds at least one object");
+
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using size_type = std::size_t;
+
+    static constexpr size_type kSlabObjects = SlabObjects;
+
+    /* slots moved between a LocalCache and the depot at once */
+    static constexpr size_type kCacheBatch = 32;
+
+    class LocalCache;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    IntrusivePool() noexcept = default;
+
+    /**
+     * @brief Carves enough slabs for n objects up front.
+     */
+    explicit IntrusivePool(size_type n);
+
+    ~IntrusivePool();
+
+    IntrusivePool(const IntrusivePool&) = delete;
+    IntrusivePool& operator=(const IntrusivePool&) = delete;
+
+    IntrusivePool(IntrusivePool&&) = delete;
+    IntrusivePool& operator=(IntrusivePool&&) = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief Constructs a T(args...) in a free slot.
+     *
+     * @throws std::bad_alloc when a new slab cannot be allocated, or what T throws.
+     */
+    template <typename... Args>
+    [[nodiscard]]
+    auto acquire(Args&&... args) -> pointer;
+
+    /**
+     * @brief Destroys object and gives its slot back.
+     */
+    void release(pointer object) noexcept;
+
+    /**
+     * @brief Default-constructs n objects and appends them to out, for one lock.
+     *
+     * @return n.
+     */
+    template <typename... Options>
+    auto acquire_batch(size_type n, IntrusiveList<T, Options...>& out) -> size_type;
+
+    /**
+     * @brief Destroys every object of in and gives their slots back, for one lock.
+     */
+    template <typename... Options>
+    void release_batch(IntrusiveList<T, Options...>& in) noexcept;
+
+    /**
+     * @brief Makes sure n free slots are available.
+     */
+    void reserve(size_type n);
+
+    /**
+     * @brief Slots carved so far.
+     */
+    [[nodiscard]]
+    auto capacity() noexcept -> size_type;
+
+    /**
+     * @brief Free slots in the depot (not counting those held by LocalCaches).
+     */
+    [[nodiscard]]
+    auto available() noexcept -> size_type;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    struct FreeSlot : IntrusiveSListNode<PoolFreeTag> {};
+
+    using free_list = IntrusiveSList<FreeSlot, BaseHook<PoolFreeTag>, CountingPolicy>;
+
+    /* one slot : big and aligned enough for a T or a FreeSlot */
+    static constexpr size_type kSlotAlign = std::max(alignof(T), alignof(FreeSlot));
+    static constexpr size_type kSlotSize =
+        (std::max(sizeof(T), sizeof(FreeSlot)) + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+
+    struct Slab {
+        Slab* next;
+    };
+
+    /* the slots start one slot-aligned header after the slab */
+    static constexpr size_type kHeaderSize =
+        (sizeof(Slab) + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+    static constexpr size_type kSlabAlign = std::max(kSlotAlign, alignof(Slab));
+
+    template <typename... Args>
+    static auto construct(free_list& free, Args&&... args) -> pointer;
+
+    /* destroys object, returns its slot as a fresh FreeSlot */
+    static auto destroy(pointer object) noexcept -> FreeSlot&;
+
+    /* moves exactly n free slots to out, carving slabs if needed */
+    void take(free_list& out, size_type n);
+
+    /* moves every slot of in to the depot */
+    void give(free_list& in) noexcept;
+
+    /* depot lock held */
+    void carve_slab();
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    std::mutex mutex_;
+    free_list depot_;
+    Slab* slabs_{nullptr};
+    size_type capacity_{0};
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Front-end of an IntrusivePool owned by one thread : a private free-list,
+ * refilled from and spilled to the depot kCacheBatch slots at a time.
+ *
+ * Everything it holds goes back to the depot in its destructor.
+ */
+template <typename T, std::size_t SlabObjects>
+class IntrusivePool<T, SlabObjects>::LocalCache {
+  public:
+    explicit LocalCache(IntrusivePool& pool) noexcept;
+
+    ~LocalCache();
+
+    LocalCache(const LocalCache&) = delete;
+    LocalCache& operator=(const LocalCache&) = delete;
+
+    template <typename... Args>
+    [[nodiscard]]
+    auto acquire(Args&&... args) -> pointer;
+
+    void release(pointer object) noexcept;
+
+    template <typename... Options>
+    auto acquire_batch(size_type n, IntrusiveList<T, Options...>& out) -> size_type;
+
+    template <typename... Options>
+    void release_batch(IntrusiveList<T, Options...>& in) noexcept;
+
+    /**
+     * @brief Gives every cached slot back to the depot.
+     */
+    void flush() noexcept;
+
+    [[nodiscard]]
+    auto cached() const noexcept -> size_type;
+
+  private:
+    /* keeps at most 2 * kCacheBatch slots */
+    void trim() noexcept;
+
+    IntrusivePool& pool_;
+    free_list free_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, std::size_t SlabObjects>
+IntrusivePool<T, SlabObjects>::IntrusivePool(size_type n) {
+    reserve(n);
+}
+
+template <typename T, std::size_t SlabObjects>
+IntrusivePool<T, SlabObjects>::~IntrusivePool() {
+    assert(depot_.size() == capacity_ && "destroying IntrusivePool with objects still acquired...");
+
+    /* forget the free-list before its nodes' memory goes away */
+    depot_.clear();
+
+    while (slabs_ != nullptr) {
+        Slab* next = slabs_->next;
+        ::operator delete(static_cast<void*>(slabs_), std::align_val_t{kSlabAlign});
+        slabs_ = next;
+    }
+}
+
+/*---*---*---*---*---*---*---* Slots *---*---*---*---*---*---*---*/
+
+template <typename T, std::size_t SlabObjects>
+template <typename... Args>
+auto IntrusivePool<T, SlabObjects>::construct(free_list& free, Args&&... args) -> pointer {
+    FreeSlot* slot = free.try_pop_front();
+    assert(slot != nullptr && "construct() : no free slot...");
+
+    slot->~FreeSlot();
+    void* storage = static_cast<void*>(slot);
+
+    try {
+        return ::new (storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+        free.push_front(*::new (storage) FreeSlot);
+        throw;
+    }
+}
+
+template <typename T, std::size_t SlabObjects>
+auto IntrusivePool<T, SlabObjects>::destroy(pointer object) noexcept -> FreeSlot& {
+    assert(object != nullptr && "release() of nullptr...");
+
+    object->~T();
+
+    return *::new (static_cast<void*>(object)) FreeSlot;
+}
+
+template <typename T, std::size_t SlabObjects>
+void IntrusivePool<T, SlabObjects>::carve_slab() {
+    void* raw = ::operator new(kHeaderSize + SlabObjects * kSlotSize, std::align_val_t{kSlabAlign});
+
+    Slab* slab = ::new (raw) Slab{slabs_};
+    slabs_ = slab;
+
+    auto* slots = static_cast<std::byte*>(raw) + kHeaderSize;
+
+    /* pushed in reverse : acquired in address order */
+    for (size_type i = SlabObjects; i-- > 0;) {
+        depot_.push_front(*::new (static_cast<void*>(slots + i * kSlotSize)) FreeSlot);
+    }
+
+    capacity_ += SlabObjects;
+}
+
+template <typename T, std::size_t SlabObjects>
+void IntrusivePool<T, SlabObjects>::take(free_list& out, size_type n) {
+    std::lock_guard lock(mutex_);
+
+    while (depot_.size() < n) {
+        carve_slab();
+    }
+
+    const size_type taken = depot_.extract_front(out, n);
+    assert(taken == n && "take() : depot came up short...");
+    (void)taken;
+}
+
+template <typename T, std::size_t SlabObjects>
+void IntrusivePool<T, SlabObjects>::give(free_list& in) noexcept {
+    std::lock_guard lock(mutex_);
+
+    /* in front : the most recently used slots are the warmest */
+    depot_.splice_after(depot_.cbefore_begin(), in);
+}
+
+/*---*---*---*---*---*---*---* Depot *---*---*---*---*---*---*---*/
+
+template <typename T, std::size_t SlabObjects>
+template <typename... Args>
+auto IntrusivePool<T, SlabObjects>::acquire(Args&&... args) -> pointer {
+    free_list one;
+    take(one, 1);
+
+    try {
+        return construct(one, std::forward<Args>(args)...);
+    } catch (...) {
+        give(one);
+        throw;
+    }
+}
+
+template <typename T, std::size_t SlabObjects>
+void IntrusivePool<T, SlabObjects>::release(pointer object) noexcept {
+    FreeSlot& slot = destroy(object);
+
+    std::lock_guard lock(mutex_);
+    depot_.push_front(slot);
+}
+
+template <typename T, std::size_t SlabObjects>
+template <typename... Options>
+auto IntrusivePool<T, SlabObjects>::acquire_batch(size_type n, IntrusiveList<T, Options...>& out)
+    -> size_type {
+    free_list slots;
+    take(slots, n);
+
+    try {
+        while (!slots.empty()) {
+            out.push_back(*construct(slots));
+        }
+    } catch (...) {
+        give(slots);
+        throw;
+    }
+
+    return n;
+}
+
+template <typename T, std::size_t SlabObjects>
+template <typename... Options>
+void IntrusivePool<T, SlabObjects>::release_batch(IntrusiveList<T, Options...>& in) noexcept {
+    free_list slots;
+
+    while (pointer object = in.try_pop_front()) {
+        slots.push_front(destroy(object));
+    }
+
+    give(slots);
+}
+
+template <typename T, std::size_t SlabObjects>
+void IntrusivePool<T, SlabObjects>::reserve(size_type n) {
+    std::lock_guard lock(mutex_);
+
+    while (depot_.size() < n) {
+        carve_slab();
+    }
+}
+
+template <typename T, std::size_t SlabObjects>
+auto IntrusivePool<T, SlabObjects>::capacity() noexcept -> size_type {
+    std::lock_guard lock(mutex_);
+    return capacity_;
+}
+
+template <typename T, std::size_t SlabObjects>
+auto IntrusivePool<T, SlabObjects>::available() noexcept -> size_type {
+    std::lock_guard lock(mutex_);
+    return depot_.size();
+}
+
+/*---*---*---*---*---*---*---* LocalCache *---*---*---*---*---*---*---*/
+
+template <typename T, std::size_t SlabObjects>
+IntrusivePool<T, SlabObjects>::LocalCache::LocalCache(IntrusivePool& pool) noexcept
+    : pool_(pool) {}
+
+template <typename T, std::size_t SlabObjects>
+IntrusivePool<T, SlabObjects>::LocalCache::~LocalCache() {
+    flush();
+}
+
+template <typename T, std::size_t SlabObjects>
+template <typename... Args>
+auto IntrusivePool<T, SlabObjects>::LocalCache::acquire(Args&&... args) -> pointer {
+    if (free_.empty()) {
+        pool_.take(free_, kCacheBatch);
+    }
+
+    return construct(free_, std::forward<Args>(args)...);
+}
+
+template <typename T, std::size_t SlabObjects>
+void IntrusivePool<T, SlabObjects>::LocalCache::release(pointer object) noexcept {
+    free_.push_front(destroy(object));
+    trim();
+}
+
+template <typename T, std::size_t SlabObjects>
+template <typename... Options>
+auto IntrusivePool<T, SlabObjects>::LocalCache::acquire_batch(size_type n,
+                                                              IntrusiveList<T, Options...>& out)
+    -> size_type {
+    if (free_.size() < n) {
+        pool_.take(free_, n - free_.size());
+    }
+
+    for (size_type i = 0; i < n; ++i) {
+        out.push_back(*construct(free_));
+    }
+
+    return n;
+}
+
+template <typename T, std::size_t SlabObjects>
+template <typename... Options>
+void IntrusivePool<T, SlabObjects>::LocalCache::release_batch(
+    IntrusiveList<T, Options...>& in) noexcept {
+    while (pointer object = in.try_pop_front()) {
+        free_.push_front(destroy(object));
+    }
+
+    trim();
+}
+
+template <typename T, std::size_t SlabObjects>
+void IntrusivePool<T, SlabObjects>::LocalCache::trim() noexcept {
+    if (free_.size() < 2 * kCacheBatch) {
+        return;
+    }
+
+    /* keep the warm front, spill the rest in one splice */
+    free_list spill;
+    spill.splice_after(spill.cbefore_begin(), free_);
+
+    const size_type kept = spill.extract_front(free_, kCacheBatch);
+    (void)kept;
+
+    pool_.give(spill);
+}
+
+template <typename T, std::size_t SlabObjects>
+void IntrusivePool<T, SlabObjects>::LocalCache::flush() noexcept {
+    pool_.give(free_);
+}
+
+template <typename T, std::size_t SlabObjects>
+auto IntrusivePool<T, SlabObjects>::LocalCache::cached() const noexcept -> size_type {
+    return free_.size();
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
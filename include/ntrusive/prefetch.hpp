@@ -0,0 +1,117 @@
+#pragma once
+
+#include "list.hpp"
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Default lookahead of for_each_prefetch(), in nodes.
+ */
+inline constexpr std::size_t kDefaultPrefetchDistance = 8;
+
+/**
+ * @brief Hint the line holding p into the cache for reading, no-op where unsupported.
+ */
+inline void prefetch_read(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 3);
+#else
+    (void)p;
+#endif
+}
+
+/**
+ * @brief Calls fn(element) on every element of list, in order, while a second cursor
+ * runs distance nodes ahead and prefetches each node (hook and object) it reaches.
+ *
+ *   it ---------------> ahead
+ *   [ fn(*it) ] ... [ in flight ] ... [ prefetch(ahead) ] -> ahead->next
+ *
+ * The ahead cursor still chases pointers one by one, but its misses overlap with
+ * fn() on the nodes behind it : the more work fn() does per node, the more of the
+ * memory latency disappears. For an empty fn() there is nothing to overlap with,
+ * relayout() is the cure there.
+ *
+ * fn may unlink or destroy the element it is given, not the ones after it.
+ */
+template <typename T, typename... Options, typename Fn>
+void for_each_prefetch(IntrusiveList<T, Options...>& list, Fn fn,
+                       std::size_t distance = kDefaultPrefetchDistance);
+
+/**
+ * @brief Moves every element of list into one contiguous buffer, in list order,
+ * and links the copies in place of the originals.
+ *
+ * Traversal then walks memory sequentially, which the hardware prefetcher follows.
+ *
+ * The buffer comes from std::allocator_traits<Alloc>::allocate(alloc, list.size()), the
+ * caller destroys and deallocates it when done with the elements. Each original is
+ * unlinked, then handed to dispose(T&) (delete it, give it back to its pool, ...).
+ *
+ * T needs a noexcept move constructor that leaves the hooks of the new object
+ * default-constructed (hooks are never moved). Only the linkage in list is carried
+ * over : the originals must not be linked in any other list.
+ *
+ * @return The buffer, list.size() elements long.
+ */
+template <typename T, typename... Options, typename Alloc, typename Dispose>
+auto relayout(IntrusiveList<T, Options...>& list, Alloc& alloc, Dispose dispose) ->
+    typename std::allocator_traits<Alloc>::pointer;
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options, typename Fn>
+void for_each_prefetch(IntrusiveList<T, Options...>& list, Fn fn, std::size_t distance) {
+    auto it = list.begin();
+    auto ahead = it;
+    const auto end = list.end();
+
+    for (std::size_t i = 0; i < distance && ahead != end; ++i) {
+        ++ahead;
+    }
+
+    while (it != end) {
+        if (ahead != end) {
+            prefetch_read(ahead.base());
+            prefetch_read(std::addressof(*ahead));
+            ++ahead;
+        }
+
+        /* step first : fn may unlink *current */
+        auto current = it++;
+        fn(*current);
+    }
+}
+
+template <typename T, typename... Options, typename Alloc, typename Dispose>
+auto relayout(IntrusiveList<T, Options...>& list, Alloc& alloc, Dispose dispose) ->
+    typename std::allocator_traits<Alloc>::pointer {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "relayout() needs a noexcept move constructor of T (hooks default-constructed)");
+
+    using traits = std::allocator_traits<Alloc>;
+
+    const std::size_t n = list.size();
+    auto buffer = traits::allocate(alloc, n);
+
+    T* slot = std::to_address(buffer);
+    auto it = list.begin();
+
+    while (it != list.end()) {
+        T& original = *it;
+        T* moved = slot++;
+        traits::construct(alloc, moved, std::move(original));
+
+        /* moved takes the place of original : insert before it, then unlink it */
+        list.insert(it, *moved);
+        it = list.erase(it);
+
+        dispose(original);
+    }
+
+    return buffer;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
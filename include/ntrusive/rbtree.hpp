@@ -0,0 +1,627 @@
+#pragma once
+
+#include "list.hpp"
+#include "policy.hpp"
+#include "rbtree_node.hpp"
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+/**
+ * @brief Intrusive red-black tree : an ordered (multi)set of T threaded through
+ * IntrusiveRbTreeNode hooks, nothing is ever allocated.
+ *
+ *  >> insert()        : O(log n), equal elements are kept in insertion order
+ *  >> insert_unique() : O(log n), refuses an element equal to one in the tree
+ *  >> find() / lower_bound() / upper_bound() : O(log n), heterogeneous : any Key
+ *                       Compare can order against T
+ *  >> erase()         : O(1) amortized rebalancing, by reference or iterator
+ *  >> remove()        : static, the self-removal idiom of IntrusiveList::remove()
+ *                       (O(log n) : climbs to the tree's header first)
+ *  >> unlink_leftmost_without_rebalance() : O(1) amortized, bulk teardown
+ *
+ * @tparam Compare Strict weak ordering on T (and between T and lookup keys).
+ * @tparam Options Same as IntrusiveList : a hook option (BaseHook<Tag> / MemberHook<&T::hook>,
+ *                 resolved against IntrusiveRbTreeNode) and/or a size policy.
+ *
+ * >> USAGE :
+ *  struct Level : IntrusiveRbTreeNode<> {
+ *    std::int64_t price;
+ *  };
+ *
+ *  struct ByPrice {
+ *    bool operator()(const Level& a, const Level& b) const { return a.price < b.price; }
+ *    bool operator()(const Level& a, std::int64_t p) const { return a.price < p; }
+ *    bool operator()(std::int64_t p, const Level& b) const { return p < b.price; }
+ *  };
+ *
+ *  IntrusiveRbTree<Level, ByPrice> asks;
+ *  auto best = asks.begin();
+ *  auto at = asks.find(std::int64_t{10'050});
+ */
+template <typename T, typename Compare = std::less<T>, typename... Options>
+class IntrusiveRbTree {
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+
+    using value_compare = Compare;
+
+    using hook_traits = RbHookTraits<T, typename ListOptions<T, Options...>::hook>;
+    using size_policy = typename ListOptions<T, Options...>::size_policy;
+
+    using node_type = typename hook_traits::node_type;
+
+    using iterator = RbTreeIterator<T, hook_traits>;
+    using const_iterator = RbTreeIterator<const T, hook_traits>;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    IntrusiveRbTree() noexcept;
+
+    explicit IntrusiveRbTree(const Compare& comp) noexcept;
+
+    ~IntrusiveRbTree();
+
+    IntrusiveRbTree(const IntrusiveRbTree&) = delete;
+    IntrusiveRbTree& operator=(const IntrusiveRbTree&) = delete;
+
+    IntrusiveRbTree(IntrusiveRbTree&&) noexcept = delete;
+    IntrusiveRbTree& operator=(IntrusiveRbTree&&) noexcept = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    [[nodiscard]]
+    auto begin() noexcept -> iterator;
+
+    [[nodiscard]]
+    auto begin() const noexcept -> const_iterator;
+
+    [[nodiscard]]
+    auto cbegin() const noexcept -> const_iterator;
+
+    [[nodiscard]]
+    auto end() noexcept -> iterator;
+
+    [[nodiscard]]
+    auto end() const noexcept -> const_iterator;
+
+    [[nodiscard]]
+    auto cend() const noexcept -> const_iterator;
+
+    /**
+     * @brief Iterator to an element known to be in THIS tree. O(1).
+     */
+    [[nodiscard]]
+    auto iterator_to(reference element) noexcept -> iterator;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief Links element after every element equal to it.
+     */
+    auto insert(reference element) noexcept -> iterator;
+
+    /**
+     * @brief Links element unless an equal one is already in the tree.
+     *
+     * @return {position of element, true} or {position of the equal element, false}.
+     */
+    auto insert_unique(reference element) noexcept -> std::pair<iterator, bool>;
+
+    /**
+     * @return Iterator following the erased element.
+     */
+    auto erase(const_iterator pos) noexcept -> iterator;
+
+    void erase(reference element) noexcept;
+
+    /**
+     * @brief Unlinks element without knowing its tree.
+     *
+     * Not available with CountingPolicy (there is no way back to the tree's counter).
+     */
+    static void remove(reference element) noexcept;
+
+    /**
+     * @brief Unlinks and returns the smallest element WITHOUT rebalancing, nullptr when empty.
+     *
+     * Meant for tearing a tree down :
+     *
+     *  while (auto* p = tree.unlink_leftmost_without_rebalance()) {
+     *    delete p;
+     *  }
+     *
+     * Once called, the tree is no longer balanced (nor a valid red-black tree) :
+     * only unlink_leftmost_without_rebalance(), clear() and empty() may follow
+     * until the tree is empty again.
+     */
+    [[nodiscard]]
+    auto unlink_leftmost_without_rebalance() noexcept -> pointer;
+
+    /**
+     * @brief Unlinks all elements, one pass resetting the hooks.
+     */
+    void clear() noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    template <typename Key>
+    [[nodiscard]]
+    auto find(const Key& key) noexcept -> iterator;
+
+    template <typename Key>
+    [[nodiscard]]
+    auto find(const Key& key) const noexcept -> const_iterator;
+
+    template <typename Key>
+    [[nodiscard]]
+    bool contains(const Key& key) const noexcept;
+
+    /* first element not less than key */
+    template <typename Key>
+    [[nodiscard]]
+    auto lower_bound(const Key& key) noexcept -> iterator;
+
+    template <typename Key>
+    [[nodiscard]]
+    auto lower_bound(const Key& key) const noexcept -> const_iterator;
+
+    /* first element greater than key */
+    template <typename Key>
+    [[nodiscard]]
+    auto upper_bound(const Key& key) noexcept -> iterator;
+
+    template <typename Key>
+    [[nodiscard]]
+    auto upper_bound(const Key& key) const noexcept -> const_iterator;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    [[nodiscard]] bool empty() const noexcept;
+
+    /* O(1) with CountingPolicy, O(n) otherwise */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type;
+
+    /* smallest element */
+    [[nodiscard]]
+    auto front() noexcept -> reference;
+
+    [[nodiscard]]
+    auto front() const noexcept -> const_reference;
+
+    /* largest element */
+    [[nodiscard]]
+    auto back() noexcept -> reference;
+
+    [[nodiscard]]
+    auto back() const noexcept -> const_reference;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    void init_header() noexcept;
+
+    [[nodiscard]]
+    auto root() const noexcept -> RbNodeBase*;
+
+    [[nodiscard]]
+    auto header() const noexcept -> RbNodeBase*;
+
+    [[nodiscard]]
+    static auto value_of(RbNodeBase* node) noexcept -> reference;
+
+    template <typename Key>
+    [[nodiscard]]
+    auto lower_bound_node(const Key& key) const noexcept -> RbNodeBase*;
+
+    template <typename Key>
+    [[nodiscard]]
+    auto upper_bound_node(const Key& key) const noexcept -> RbNodeBase*;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    /* header_.parent_ : root, header_.left_ / right_ : leftmost / rightmost */
+    RbNodeBase header_;
+
+    [[no_unique_address]] Compare comp_;
+    [[no_unique_address]] size_policy size_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename Compare, typename... Options>
+IntrusiveRbTree<T, Compare, Options...>::IntrusiveRbTree() noexcept {
+    init_header();
+}
+
+template <typename T, typename Compare, typename... Options>
+IntrusiveRbTree<T, Compare, Options...>::IntrusiveRbTree(const Compare& comp) noexcept
+    : comp_(comp) {
+    init_header();
+}
+
+template <typename T, typename Compare, typename... Options>
+IntrusiveRbTree<T, Compare, Options...>::~IntrusiveRbTree() {
+    clear();
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusiveRbTree<T, Compare, Options...>::init_header() noexcept {
+    /* the only red node that will ever be its own grandparent */
+    header_.red_ = true;
+    header_.parent_ = nullptr;
+    header_.left_ = &header_;
+    header_.right_ = &header_;
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::root() const noexcept -> RbNodeBase* {
+    return header_.parent_;
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::header() const noexcept -> RbNodeBase* {
+    return const_cast<RbNodeBase*>(&header_);
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::value_of(RbNodeBase* node) noexcept -> reference {
+    return *hook_traits::to_value(node);
+}
+
+/*---*---*---*---*---*---*---* Iterators *---*---*---*---*---*---*---*/
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::begin() noexcept -> iterator {
+    return iterator(header_.left_);
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::begin() const noexcept -> const_iterator {
+    return const_iterator(header_.left_);
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::cbegin() const noexcept -> const_iterator {
+    return begin();
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::end() noexcept -> iterator {
+    return iterator(&header_);
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::end() const noexcept -> const_iterator {
+    return const_iterator(header());
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::cend() const noexcept -> const_iterator {
+    return end();
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::iterator_to(reference element) noexcept
+    -> iterator {
+    return iterator(hook_traits::to_node(&element));
+}
+
+/*---*---*---*---*---*---*---* Capacity *---*---*---*---*---*---*---*/
+
+template <typename T, typename Compare, typename... Options>
+bool IntrusiveRbTree<T, Compare, Options...>::empty() const noexcept {
+    return root() == nullptr;
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::size() const noexcept -> size_type {
+    if constexpr (size_policy::is_counting) {
+        return size_.count();
+    }
+
+    size_type cnt = 0;
+
+    for (auto it = begin(); it != end(); ++it) {
+        ++cnt;
+    }
+
+    return cnt;
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::front() noexcept -> reference {
+    assert(!empty() && "front() called on empty tree...");
+    return value_of(header_.left_);
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::front() const noexcept -> const_reference {
+    assert(!empty() && "front() called on empty tree...");
+    return value_of(header_.left_);
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::back() noexcept -> reference {
+    assert(!empty() && "back() called on empty tree...");
+    return value_of(header_.right_);
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::back() const noexcept -> const_reference {
+    assert(!empty() && "back() called on empty tree...");
+    return value_of(header_.right_);
+}
+
+/*---*---*---*---*---*---*---* Lookup *---*---*---*---*---*---*---*/
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+auto IntrusiveRbTree<T, Compare, Options...>::lower_bound_node(const Key& key) const noexcept
+    -> RbNodeBase* {
+    RbNodeBase* node = root();
+    RbNodeBase* bound = header();
+
+    while (node != nullptr) {
+        if (!comp_(value_of(node), key)) {
+            bound = node;
+            node = node->left_;
+        } else {
+            node = node->right_;
+        }
+    }
+
+    return bound;
+}
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+auto IntrusiveRbTree<T, Compare, Options...>::upper_bound_node(const Key& key) const noexcept
+    -> RbNodeBase* {
+    RbNodeBase* node = root();
+    RbNodeBase* bound = header();
+
+    while (node != nullptr) {
+        if (comp_(key, value_of(node))) {
+            bound = node;
+            node = node->left_;
+        } else {
+            node = node->right_;
+        }
+    }
+
+    return bound;
+}
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+auto IntrusiveRbTree<T, Compare, Options...>::lower_bound(const Key& key) noexcept -> iterator {
+    return iterator(lower_bound_node(key));
+}
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+auto IntrusiveRbTree<T, Compare, Options...>::lower_bound(const Key& key) const noexcept
+    -> const_iterator {
+    return const_iterator(lower_bound_node(key));
+}
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+auto IntrusiveRbTree<T, Compare, Options...>::upper_bound(const Key& key) noexcept -> iterator {
+    return iterator(upper_bound_node(key));
+}
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+auto IntrusiveRbTree<T, Compare, Options...>::upper_bound(const Key& key) const noexcept
+    -> const_iterator {
+    return const_iterator(upper_bound_node(key));
+}
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+auto IntrusiveRbTree<T, Compare, Options...>::find(const Key& key) noexcept -> iterator {
+    RbNodeBase* node = lower_bound_node(key);
+
+    if (node == &header_ || comp_(key, value_of(node))) {
+        return end();
+    }
+
+    return iterator(node);
+}
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+auto IntrusiveRbTree<T, Compare, Options...>::find(const Key& key) const noexcept
+    -> const_iterator {
+    return const_cast<IntrusiveRbTree*>(this)->find(key);
+}
+
+template <typename T, typename Compare, typename... Options>
+template <typename Key>
+bool IntrusiveRbTree<T, Compare, Options...>::contains(const Key& key) const noexcept {
+    return find(key) != end();
+}
+
+/*---*---*---*---*---*---*---* Modifiers *---*---*---*---*---*---*---*/
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::insert(reference element) noexcept -> iterator {
+    RbNodeBase* node = hook_traits::to_node(&element);
+
+    assert(!node->is_linked_base() && "Element already in a tree!!");
+
+    RbNodeBase* parent = &header_;
+    RbNodeBase* cur = root();
+
+    /* equal elements go right : after the ones already there */
+    while (cur != nullptr) {
+        parent = cur;
+        cur = comp_(element, value_of(cur)) ? cur->left_ : cur->right_;
+    }
+
+    const bool insert_left = (parent == &header_) || comp_(element, value_of(parent));
+
+    RbNodeBase::insert_and_rebalance(insert_left, node, parent, header_);
+    size_.increment();
+
+    return iterator(node);
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::insert_unique(reference element) noexcept
+    -> std::pair<iterator, bool> {
+    RbNodeBase* node = hook_traits::to_node(&element);
+
+    assert(!node->is_linked_base() && "Element already in a tree!!");
+
+    RbNodeBase* parent = &header_;
+    RbNodeBase* cur = root();
+    bool less = true;
+
+    while (cur != nullptr) {
+        parent = cur;
+        less = comp_(element, value_of(cur));
+        cur = less ? cur->left_ : cur->right_;
+    }
+
+    /* the only candidate for an equal element is the in-order predecessor of the slot */
+    RbNodeBase* before = parent;
+
+    if (less) {
+        if (before == header_.left_) {
+            RbNodeBase::insert_and_rebalance(true, node, parent, header_);
+            size_.increment();
+
+            return {iterator(node), true};
+        }
+
+        before = RbNodeBase::decrement(before);
+    }
+
+    if (!comp_(value_of(before), element)) {
+        return {iterator(before), false};
+    }
+
+    const bool insert_left = (parent == &header_) || comp_(element, value_of(parent));
+
+    RbNodeBase::insert_and_rebalance(insert_left, node, parent, header_);
+    size_.increment();
+
+    return {iterator(node), true};
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::erase(const_iterator pos) noexcept -> iterator {
+    assert(pos != end() && "erase(end())...");
+
+    RbNodeBase* node = pos.base();
+    RbNodeBase* next = RbNodeBase::increment(node);
+
+    RbNodeBase::erase_and_rebalance(node, header_);
+    node->reset_base();
+    size_.decrement();
+
+    return iterator(next);
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusiveRbTree<T, Compare, Options...>::erase(reference element) noexcept {
+    RbNodeBase* node = hook_traits::to_node(&element);
+
+    assert(node->is_linked_base() && "Element is not in a tree...");
+
+    RbNodeBase::erase_and_rebalance(node, header_);
+    node->reset_base();
+    size_.decrement();
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusiveRbTree<T, Compare, Options...>::remove(reference element) noexcept {
+    static_assert(!size_policy::is_counting,
+                  "remove() cannot update the owner's counter, use tree.erase(element)");
+
+    RbNodeBase* node = hook_traits::to_node(&element);
+
+    if (!node->is_linked_base()) {
+        return;
+    }
+
+    /* climb to the header : the root's parent */
+    RbNodeBase* header = node->parent_;
+
+    while (!header->is_header()) {
+        header = header->parent_;
+    }
+
+    RbNodeBase::erase_and_rebalance(node, *header);
+    node->reset_base();
+}
+
+template <typename T, typename Compare, typename... Options>
+auto IntrusiveRbTree<T, Compare, Options...>::unlink_leftmost_without_rebalance() noexcept
+    -> pointer {
+    RbNodeBase* leftmost = header_.left_;
+
+    if (leftmost == &header_) {
+        return nullptr;
+    }
+
+    /**
+     * The leftmost node has no left child : its right subtree (if any) takes its place.
+     *
+     * Before :      parent              After :      parent
+     *              /                                /
+     *         leftmost                          right ...
+     *              \
+     *             right ...
+     */
+    RbNodeBase* parent = leftmost->parent_;
+    RbNodeBase* right = leftmost->right_;
+
+    if (right != nullptr) {
+        right->parent_ = parent;
+        header_.left_ = RbNodeBase::minimum(right);
+
+        if (parent == &header_) {
+            header_.parent_ = right;
+        } else {
+            parent->left_ = right;
+        }
+    } else if (parent == &header_) {
+        init_header();
+    } else {
+        parent->left_ = nullptr;
+        header_.left_ = parent;
+    }
+
+    leftmost->reset_base();
+    size_.decrement();
+
+    return hook_traits::to_value(leftmost);
+}
+
+template <typename T, typename Compare, typename... Options>
+void IntrusiveRbTree<T, Compare, Options...>::clear() noexcept {
+    while (unlink_leftmost_without_rebalance() != nullptr) {
+    }
+
+    init_header();
+    size_.reset();
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
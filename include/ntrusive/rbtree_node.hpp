@@ -0,0 +1,652 @@
+#pragma once
+
+#include "hook.hpp"
+#include "node.hpp"
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief Link of an intrusive red-black tree.
+ *
+ * The tree owns a header node (never a T) :
+ *
+ *  >> header.parent_ : root            root.parent_ : header
+ *  >> header.left_   : leftmost node   (header itself when empty)
+ *  >> header.right_  : rightmost node  (header itself when empty)
+ *
+ * The header is the only red node that is its own grandparent, that is how
+ * iterators and the self-removal find their way back to it.
+ *
+ * Unlinked state : parent_ == nullptr.
+ */
+struct RbNodeBase {
+
+    /*---*---*---*---*---*---*/
+
+    RbNodeBase* parent_{nullptr};
+    RbNodeBase* left_{nullptr};
+    RbNodeBase* right_{nullptr};
+    bool red_{false};
+
+    /*---*---*---*---*---*---*/
+
+    [[nodiscard]]
+    bool is_linked_base() const noexcept;
+
+    [[nodiscard]]
+    bool is_header() const noexcept;
+
+    void reset_base() noexcept;
+
+    /* in-order successor / predecessor, header included (end()) */
+    [[nodiscard]]
+    static RbNodeBase* increment(RbNodeBase* node) noexcept;
+
+    [[nodiscard]]
+    static RbNodeBase* decrement(RbNodeBase* node) noexcept;
+
+    [[nodiscard]]
+    static RbNodeBase* minimum(RbNodeBase* node) noexcept;
+
+    [[nodiscard]]
+    static RbNodeBase* maximum(RbNodeBase* node) noexcept;
+
+    /**
+     * Before:      x                 After:       y
+     *            /   \                          /   \
+     *           a     y                        x     c
+     *               /   \                    /   \
+     *              b     c                  a     b
+     */
+    static void rotate_left(RbNodeBase* x, RbNodeBase*& root) noexcept;
+
+    /* mirror of rotate_left() */
+    static void rotate_right(RbNodeBase* x, RbNodeBase*& root) noexcept;
+
+    /**
+     * @brief Links node as the left (insert_left) or right child of parent, then recolors / rotates.
+     */
+    static void insert_and_rebalance(bool insert_left, RbNodeBase* node, RbNodeBase* parent,
+                                     RbNodeBase& header) noexcept;
+
+    /**
+     * @brief Unlinks node (hook left untouched), then recolors / rotates.
+     */
+    static void erase_and_rebalance(RbNodeBase* node, RbNodeBase& header) noexcept;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Intrusive red-black tree node, three pointers and a color.
+ * Inherit from this class (or embed it as a member) to put objects in an IntrusiveRbTree.
+ *
+ * >> SAFETY : destroying a linked node is a bug (assert),
+ *             remove it first (IntrusiveRbTree::remove(element)).
+ *
+ * >> USAGE :
+ *  struct Order : IntrusiveRbTreeNode<> {
+ *    std::int64_t price;
+ *  };
+ */
+template <typename Tag = DefaultTag>
+class IntrusiveRbTreeNode : public RbNodeBase {
+  public:
+    using tag_type = Tag;
+
+    constexpr IntrusiveRbTreeNode() noexcept = default;
+
+    ~IntrusiveRbTreeNode();
+
+    /* non-copyable */
+    IntrusiveRbTreeNode(const IntrusiveRbTreeNode&) = delete;
+    IntrusiveRbTreeNode& operator=(const IntrusiveRbTreeNode&) = delete;
+
+    /* non-moveble */
+    IntrusiveRbTreeNode(IntrusiveRbTreeNode&&) noexcept = delete;
+    IntrusiveRbTreeNode& operator=(IntrusiveRbTreeNode&&) noexcept = delete;
+
+    /**
+     * @brief Is this node currently in a tree?
+     */
+    [[nodiscard]]
+    bool is_linked() const noexcept;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Same hook options as IntrusiveList (BaseHook<Tag> / MemberHook<&T::hook>),
+ * resolved against IntrusiveRbTreeNode<Tag> instead.
+ */
+template <typename T, typename Hook>
+struct RbHookTraits;
+
+template <typename T, typename Tag>
+struct RbHookTraits<T, BaseHook<Tag>> {
+    static_assert(std::is_base_of_v<IntrusiveRbTreeNode<Tag>, T>,
+                  "T must inherit from IntrusiveRbTreeNode<Tag>");
+
+    using value_type = T;
+    using node_type = IntrusiveRbTreeNode<Tag>;
+
+    [[nodiscard]]
+    static constexpr node_type* to_node(T* value) noexcept {
+        return static_cast<node_type*>(value);
+    }
+
+    [[nodiscard]]
+    static constexpr T* to_value(RbNodeBase* node) noexcept {
+        return static_cast<T*>(static_cast<node_type*>(node));
+    }
+};
+
+template <typename T, auto Member>
+struct RbHookTraits<T, MemberHook<Member>> {
+    using owner_type = typename MemberPointerTraits<decltype(Member)>::owner_type;
+
+    static_assert(std::is_same_v<owner_type, T> || std::is_base_of_v<owner_type, T>,
+                  "MemberHook<&Owner::hook> must point into T");
+
+    using value_type = T;
+    using node_type = typename MemberPointerTraits<decltype(Member)>::field_type;
+
+    static_assert(std::is_base_of_v<RbNodeBase, node_type>,
+                  "MemberHook<> must point to an IntrusiveRbTreeNode<...> member");
+
+    [[nodiscard]]
+    static node_type* to_node(T* value) noexcept {
+        return &(static_cast<owner_type*>(value)->*Member);
+    }
+
+    [[nodiscard]]
+    static T* to_value(RbNodeBase* node) noexcept {
+        auto* bytes = reinterpret_cast<unsigned char*>(static_cast<node_type*>(node));
+
+        return static_cast<T*>(reinterpret_cast<owner_type*>(bytes - member_offset<Member>()));
+    }
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Bidirectional in-order iterator of IntrusiveRbTree<...>, modeled on ListIterator.
+ *
+ * @tparam Traits RbHookTraits<...> of the tree.
+ */
+template <typename T, typename Traits>
+class RbTreeIterator {
+  public:
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    using hook_traits = Traits;
+    using node_type = typename Traits::node_type;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+    constexpr RbTreeIterator() noexcept = default;
+
+    /* @param hook Pointer to the node (may be the header) */
+    constexpr explicit RbTreeIterator(RbNodeBase* hook) noexcept;
+
+    [[nodiscard]]
+    constexpr reference operator*() const noexcept;
+
+    [[nodiscard]]
+    constexpr pointer operator->() const noexcept;
+
+    RbTreeIterator& operator++() noexcept;
+
+    RbTreeIterator operator++(int) noexcept;
+
+    RbTreeIterator& operator--() noexcept;
+
+    RbTreeIterator operator--(int) noexcept;
+
+    constexpr bool operator==(const RbTreeIterator& other) const noexcept;
+
+    constexpr bool operator!=(const RbTreeIterator& other) const noexcept;
+
+    operator RbTreeIterator<const value_type, Traits>() const noexcept;
+
+    [[nodiscard]] constexpr RbNodeBase* base() const noexcept;
+
+  private:
+    RbNodeBase* current_{nullptr};
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+inline bool RbNodeBase::is_linked_base() const noexcept {
+    return parent_ != nullptr;
+}
+
+inline bool RbNodeBase::is_header() const noexcept {
+    return red_ && parent_ != nullptr && parent_->parent_ == this;
+}
+
+inline void RbNodeBase::reset_base() noexcept {
+    parent_ = nullptr;
+    left_ = nullptr;
+    right_ = nullptr;
+    red_ = false;
+}
+
+inline RbNodeBase* RbNodeBase::minimum(RbNodeBase* node) noexcept {
+    while (node->left_ != nullptr) {
+        node = node->left_;
+    }
+
+    return node;
+}
+
+inline RbNodeBase* RbNodeBase::maximum(RbNodeBase* node) noexcept {
+    while (node->right_ != nullptr) {
+        node = node->right_;
+    }
+
+    return node;
+}
+
+inline RbNodeBase* RbNodeBase::increment(RbNodeBase* node) noexcept {
+    if (node->right_ != nullptr) {
+        return minimum(node->right_);
+    }
+
+    RbNodeBase* parent = node->parent_;
+
+    while (node == parent->right_) {
+        node = parent;
+        parent = parent->parent_;
+    }
+
+    /* climbing from the rightmost node ends on the header : header.right_ != root */
+    return (node->right_ != parent) ? parent : node;
+}
+
+inline RbNodeBase* RbNodeBase::decrement(RbNodeBase* node) noexcept {
+    /* end() - 1 */
+    if (node->is_header()) {
+        return node->right_;
+    }
+
+    if (node->left_ != nullptr) {
+        return maximum(node->left_);
+    }
+
+    RbNodeBase* parent = node->parent_;
+
+    while (node == parent->left_) {
+        node = parent;
+        parent = parent->parent_;
+    }
+
+    return parent;
+}
+
+inline void RbNodeBase::rotate_left(RbNodeBase* x, RbNodeBase*& root) noexcept {
+    RbNodeBase* y = x->right_;
+
+    x->right_ = y->left_;
+
+    if (y->left_ != nullptr) {
+        y->left_->parent_ = x;
+    }
+
+    y->parent_ = x->parent_;
+
+    if (x == root) {
+        root = y;
+    } else if (x == x->parent_->left_) {
+        x->parent_->left_ = y;
+    } else {
+        x->parent_->right_ = y;
+    }
+
+    y->left_ = x;
+    x->parent_ = y;
+}
+
+inline void RbNodeBase::rotate_right(RbNodeBase* x, RbNodeBase*& root) noexcept {
+    RbNodeBase* y = x->left_;
+
+    x->left_ = y->right_;
+
+    if (y->right_ != nullptr) {
+        y->right_->parent_ = x;
+    }
+
+    y->parent_ = x->parent_;
+
+    if (x == root) {
+        root = y;
+    } else if (x == x->parent_->right_) {
+        x->parent_->right_ = y;
+    } else {
+        x->parent_->left_ = y;
+    }
+
+    y->right_ = x;
+    x->parent_ = y;
+}
+
+inline void RbNodeBase::insert_and_rebalance(bool insert_left, RbNodeBase* node,
+                                             RbNodeBase* parent, RbNodeBase& header) noexcept {
+    RbNodeBase*& root = header.parent_;
+
+    node->parent_ = parent;
+    node->left_ = nullptr;
+    node->right_ = nullptr;
+    node->red_ = true;
+
+    if (insert_left) {
+        /* also makes header.left_ = node when parent is the header (first node) */
+        parent->left_ = node;
+
+        if (parent == &header) {
+            root = node;
+            header.right_ = node;
+        } else if (parent == header.left_) {
+            header.left_ = node;
+        }
+    } else {
+        parent->right_ = node;
+
+        if (parent == header.right_) {
+            header.right_ = node;
+        }
+    }
+
+    /* red parent : recolor while the uncle is red, rotate once it is black */
+    while (node != root && node->parent_->red_) {
+        RbNodeBase* grandparent = node->parent_->parent_;
+
+        if (node->parent_ == grandparent->left_) {
+            RbNodeBase* uncle = grandparent->right_;
+
+            if (uncle != nullptr && uncle->red_) {
+                node->parent_->red_ = false;
+                uncle->red_ = false;
+                grandparent->red_ = true;
+                node = grandparent;
+            } else {
+                if (node == node->parent_->right_) {
+                    node = node->parent_;
+                    rotate_left(node, root);
+                }
+
+                node->parent_->red_ = false;
+                grandparent->red_ = true;
+                rotate_right(grandparent, root);
+            }
+        } else {
+            RbNodeBase* uncle = grandparent->left_;
+
+            if (uncle != nullptr && uncle->red_) {
+                node->parent_->red_ = false;
+                uncle->red_ = false;
+                grandparent->red_ = true;
+                node = grandparent;
+            } else {
+                if (node == node->parent_->left_) {
+                    node = node->parent_;
+                    rotate_right(node, root);
+                }
+
+                node->parent_->red_ = false;
+                grandparent->red_ = true;
+                rotate_left(grandparent, root);
+            }
+        }
+    }
+
+    root->red_ = false;
+}
+
+inline void RbNodeBase::erase_and_rebalance(RbNodeBase* node, RbNodeBase& header) noexcept {
+    RbNodeBase*& root = header.parent_;
+    RbNodeBase*& leftmost = header.left_;
+    RbNodeBase*& rightmost = header.right_;
+
+    /* y : node actually spliced out of its position, x : its only child (may be null) */
+    RbNodeBase* y = node;
+    RbNodeBase* x = nullptr;
+    RbNodeBase* x_parent = nullptr;
+
+    if (y->left_ == nullptr) {
+        x = y->right_;
+    } else if (y->right_ == nullptr) {
+        x = y->left_;
+    } else {
+        y = minimum(y->right_);
+        x = y->right_;
+    }
+
+    if (y != node) {
+        /* two children : the successor y takes node's place (and color) */
+        node->left_->parent_ = y;
+        y->left_ = node->left_;
+
+        if (y != node->right_) {
+            x_parent = y->parent_;
+
+            if (x != nullptr) {
+                x->parent_ = y->parent_;
+            }
+
+            y->parent_->left_ = x;
+            y->right_ = node->right_;
+            node->right_->parent_ = y;
+        } else {
+            x_parent = y;
+        }
+
+        if (root == node) {
+            root = y;
+        } else if (node->parent_->left_ == node) {
+            node->parent_->left_ = y;
+        } else {
+            node->parent_->right_ = y;
+        }
+
+        y->parent_ = node->parent_;
+
+        const bool color = y->red_;
+        y->red_ = node->red_;
+        node->red_ = color;
+    } else {
+        /* at most one child : x replaces node */
+        x_parent = node->parent_;
+
+        if (x != nullptr) {
+            x->parent_ = node->parent_;
+        }
+
+        if (root == node) {
+            root = x;
+        } else if (node->parent_->left_ == node) {
+            node->parent_->left_ = x;
+        } else {
+            node->parent_->right_ = x;
+        }
+
+        if (leftmost == node) {
+            leftmost = (node->right_ == nullptr) ? node->parent_ : minimum(x);
+        }
+
+        if (rightmost == node) {
+            rightmost = (node->left_ == nullptr) ? node->parent_ : maximum(x);
+        }
+    }
+
+    /* node now holds the color that left the tree : a black one leaves x "doubly black" */
+    if (node->red_) {
+        return;
+    }
+
+    while (x != root && (x == nullptr || !x->red_)) {
+        if (x == x_parent->left_) {
+            RbNodeBase* sibling = x_parent->right_;
+
+            if (sibling->red_) {
+                sibling->red_ = false;
+                x_parent->red_ = true;
+                rotate_left(x_parent, root);
+                sibling = x_parent->right_;
+            }
+
+            const bool left_black = sibling->left_ == nullptr || !sibling->left_->red_;
+            const bool right_black = sibling->right_ == nullptr || !sibling->right_->red_;
+
+            if (left_black && right_black) {
+                sibling->red_ = true;
+                x = x_parent;
+                x_parent = x_parent->parent_;
+                continue;
+            }
+
+            if (right_black) {
+                sibling->left_->red_ = false;
+                sibling->red_ = true;
+                rotate_right(sibling, root);
+                sibling = x_parent->right_;
+            }
+
+            sibling->red_ = x_parent->red_;
+            x_parent->red_ = false;
+
+            if (sibling->right_ != nullptr) {
+                sibling->right_->red_ = false;
+            }
+
+            rotate_left(x_parent, root);
+            break;
+        }
+
+        RbNodeBase* sibling = x_parent->left_;
+
+        if (sibling->red_) {
+            sibling->red_ = false;
+            x_parent->red_ = true;
+            rotate_right(x_parent, root);
+            sibling = x_parent->left_;
+        }
+
+        const bool right_black = sibling->right_ == nullptr || !sibling->right_->red_;
+        const bool left_black = sibling->left_ == nullptr || !sibling->left_->red_;
+
+        if (right_black && left_black) {
+            sibling->red_ = true;
+            x = x_parent;
+            x_parent = x_parent->parent_;
+            continue;
+        }
+
+        if (left_black) {
+            sibling->right_->red_ = false;
+            sibling->red_ = true;
+            rotate_left(sibling, root);
+            sibling = x_parent->left_;
+        }
+
+        sibling->red_ = x_parent->red_;
+        x_parent->red_ = false;
+
+        if (sibling->left_ != nullptr) {
+            sibling->left_->red_ = false;
+        }
+
+        rotate_right(x_parent, root);
+        break;
+    }
+
+    if (x != nullptr) {
+        x->red_ = false;
+    }
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+template <typename Tag>
+IntrusiveRbTreeNode<Tag>::~IntrusiveRbTreeNode() {
+    assert(!is_linked() && "destroying node still in a tree...");
+}
+
+template <typename Tag>
+bool IntrusiveRbTreeNode<Tag>::is_linked() const noexcept {
+    return is_linked_base();
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename Traits>
+constexpr RbTreeIterator<T, Traits>::RbTreeIterator(RbNodeBase* hook) noexcept
+    : current_(hook) {}
+
+template <typename T, typename Traits>
+constexpr typename RbTreeIterator<T, Traits>::reference
+RbTreeIterator<T, Traits>::operator*() const noexcept {
+    return *Traits::to_value(current_);
+}
+
+template <typename T, typename Traits>
+constexpr typename RbTreeIterator<T, Traits>::pointer
+RbTreeIterator<T, Traits>::operator->() const noexcept {
+    return Traits::to_value(current_);
+}
+
+template <typename T, typename Traits>
+RbTreeIterator<T, Traits>& RbTreeIterator<T, Traits>::operator++() noexcept {
+    current_ = RbNodeBase::increment(current_);
+    return *this;
+}
+
+template <typename T, typename Traits>
+RbTreeIterator<T, Traits>& RbTreeIterator<T, Traits>::operator--() noexcept {
+    current_ = RbNodeBase::decrement(current_);
+    return *this;
+}
+
+template <typename T, typename Traits>
+RbTreeIterator<T, Traits> RbTreeIterator<T, Traits>::operator++(int) noexcept {
+    auto tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+template <typename T, typename Traits>
+RbTreeIterator<T, Traits> RbTreeIterator<T, Traits>::operator--(int) noexcept {
+    auto tmp = *this;
+    --(*this);
+    return tmp;
+}
+
+template <typename T, typename Traits>
+constexpr bool RbTreeIterator<T, Traits>::operator==(const RbTreeIterator& other) const noexcept {
+    return current_ == other.current_;
+}
+
+template <typename T, typename Traits>
+constexpr bool RbTreeIterator<T, Traits>::operator!=(const RbTreeIterator& other) const noexcept {
+    return current_ != other.current_;
+}
+
+template <typename T, typename Traits>
+RbTreeIterator<T, Traits>::operator RbTreeIterator<const value_type, Traits>() const noexcept {
+    return RbTreeIterator<const value_type, Traits>{current_};
+}
+
+template <typename T, typename Traits>
+constexpr RbNodeBase* RbTreeIterator<T, Traits>::base() const noexcept {
+    return current_;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -0,0 +1,558 @@
+#pragma once
+
+#include "list.hpp"
+#include "policy.hpp"
+#include "slist_node.hpp"
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief Forward Iterator for IntrusiveSList<...>
+ */
+template <typename T, typename Traits>
+class SListIterator {
+  public:
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    using hook_traits = Traits;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+    constexpr SListIterator() noexcept = default;
+
+    /* @param hook Pointer to the node (may be sentinel) */
+    constexpr explicit SListIterator(SListNodeBase* hook) noexcept;
+
+    [[nodiscard]]
+    constexpr reference operator*() const noexcept;
+
+    [[nodiscard]]
+    constexpr pointer operator->() const noexcept;
+
+    constexpr SListIterator& operator++() noexcept;
+
+    constexpr SListIterator operator++(int) noexcept;
+
+    constexpr bool operator==(const SListIterator& other) const noexcept;
+
+    constexpr bool operator!=(const SListIterator& other) const noexcept;
+
+    operator SListIterator<const value_type, Traits>() const noexcept;
+
+    [[nodiscard]] constexpr SListNodeBase* base() const noexcept;
+
+  private:
+    SListNodeBase* current_{nullptr};
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Intrusive singly-linked list with O(1) push_front / push_back / pop_front.
+ *
+ * One pointer (8 bytes) per hook (IntrusiveSListNode<Tag>) instead of the two (16 bytes)
+ * of IntrusiveListNode : for strictly FIFO / LIFO queues that never erase from the middle.
+ *
+ * Layout : circular through the sentinel, plus a tail pointer.
+ *
+ *   sentinel -> first -> ... -> last -> sentinel
+ *   tail_ == last (== &sentinel when empty)
+ *
+ * As a consequence before_begin() and end() are the same position (the sentinel).
+ *
+ * @tparam Options Same as IntrusiveList : a hook option (BaseHook<Tag> / MemberHook<&T::hook>,
+ *                 resolved against IntrusiveSListNode) and/or a size policy.
+ */
+template <typename T, typename... Options>
+class IntrusiveSList {
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using hook_traits = SListHookTraits<T, typename ListOptions<T, Options...>::hook>;
+    using size_policy = typename ListOptions<T, Options...>::size_policy;
+
+    using node_type = typename hook_traits::node_type;
+    using sentinel_type = SListNodeBase;
+
+    using iterator = SListIterator<T, hook_traits>;
+    using const_iterator = SListIterator<const T, hook_traits>;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    IntrusiveSList() noexcept;
+
+    ~IntrusiveSList();
+
+    IntrusiveSList(const IntrusiveSList&) = delete;
+    IntrusiveSList& operator=(const IntrusiveSList&) = delete;
+
+    IntrusiveSList(IntrusiveSList&&) noexcept = delete;
+    IntrusiveSList& operator=(IntrusiveSList&&) noexcept = delete;
+
+  private:
+    void init_sentinel() noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+  public:
+    void push_front(reference element) noexcept;
+
+    void push_back(reference element) noexcept;
+
+    /**
+     * @brief Inserts element right after pos (pos may be before_begin()).
+     */
+    auto insert_after(const_iterator pos, reference element) noexcept -> iterator;
+
+    void pop_front() noexcept;
+
+    /**
+     * @brief Unlinks the element right after pos.
+     *
+     * @return Iterator to the element that followed the erased one.
+     */
+    auto erase_after(const_iterator pos) noexcept -> iterator;
+
+    /**
+     * @brief Unlinks all elements, one pass resetting the hooks.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Transfer all elements from other after pos. O(1).
+     */
+    void splice_after(const_iterator pos, IntrusiveSList& other) noexcept;
+
+    /**
+     * @brief Transfer the open range (before_first, last) from other after pos.
+     *
+     * O(k) : the range has to be walked to find its last element.
+     */
+    void splice_after(const_iterator pos, IntrusiveSList& other,
+                      const_iterator before_first, const_iterator last) noexcept;
+
+    [[nodiscard]]
+    auto try_pop_front() noexcept -> pointer;
+
+    [[nodiscard]]
+    auto extract_front(IntrusiveSList& out, size_type max_cnt) noexcept -> size_type;
+
+  private:
+    /* moves the closed chain [first, last] of other after pos, cnt elements */
+    void transfer_after(SListNodeBase* pos, IntrusiveSList& other, SListNodeBase* before_first,
+                        SListNodeBase* last, size_type cnt) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    [[nodiscard]] bool empty() const noexcept;
+
+    [[nodiscard]]
+    auto size() const noexcept -> size_type;
+
+    [[nodiscard]]
+    auto front() noexcept -> reference;
+
+    [[nodiscard]]
+    auto front() const noexcept -> const_reference;
+
+    [[nodiscard]]
+    auto back() noexcept -> reference;
+
+    [[nodiscard]]
+    auto back() const noexcept -> const_reference;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+    [[nodiscard]]
+    auto before_begin() noexcept -> iterator;
+
+    [[nodiscard]]
+    auto cbefore_begin() const noexcept -> const_iterator;
+
+    [[nodiscard]]
+    auto begin() noexcept -> iterator;
+
+    [[nodiscard]]
+    auto cbegin() const noexcept -> const_iterator;
+
+    [[nodiscard]]
+    auto end() noexcept -> iterator;
+
+    [[nodiscard]]
+    auto cend() const noexcept -> const_iterator;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    SListNodeBase sentinel_;
+    SListNodeBase* tail_;
+
+    [[no_unique_address]] size_policy size_;
+};
+
+template <typename T, typename... Options>
+using IntrusiveForwardList = IntrusiveSList<T, Options...>;
+
+/*---*---*---*---*---*---*---*---IMPL---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename Traits>
+constexpr SListIterator<T, Traits>::SListIterator(SListNodeBase* hook) noexcept
+    : current_(hook) {}
+
+template <typename T, typename Traits>
+constexpr typename SListIterator<T, Traits>::reference
+SListIterator<T, Traits>::operator*() const noexcept {
+    return *Traits::to_value(current_);
+}
+
+template <typename T, typename Traits>
+constexpr typename SListIterator<T, Traits>::pointer
+SListIterator<T, Traits>::operator->() const noexcept {
+    return Traits::to_value(current_);
+}
+
+template <typename T, typename Traits>
+constexpr SListIterator<T, Traits>& SListIterator<T, Traits>::operator++() noexcept {
+    current_ = current_->next_node();
+    return *this;
+}
+
+template <typename T, typename Traits>
+constexpr SListIterator<T, Traits> SListIterator<T, Traits>::operator++(int) noexcept {
+    auto tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+template <typename T, typename Traits>
+constexpr bool SListIterator<T, Traits>::operator==(const SListIterator& other) const noexcept {
+    return current_ == other.current_;
+}
+
+template <typename T, typename Traits>
+constexpr bool SListIterator<T, Traits>::operator!=(const SListIterator& other) const noexcept {
+    return current_ != other.current_;
+}
+
+template <typename T, typename Traits>
+SListIterator<T, Traits>::operator SListIterator<const value_type, Traits>() const noexcept {
+    return SListIterator<const value_type, Traits>{current_};
+}
+
+template <typename T, typename Traits>
+constexpr SListNodeBase* SListIterator<T, Traits>::base() const noexcept {
+    return current_;
+}
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+IntrusiveSList<T, Options...>::IntrusiveSList() noexcept {
+    init_sentinel();
+}
+
+template <typename T, typename... Options>
+IntrusiveSList<T, Options...>::~IntrusiveSList() {
+    clear();
+}
+
+template <typename T, typename... Options>
+void IntrusiveSList<T, Options...>::init_sentinel() noexcept {
+    sentinel_.set_next(&sentinel_);
+    tail_ = &sentinel_;
+}
+
+/*---*---*---*---*---*---*---* Capacity *---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+bool IntrusiveSList<T, Options...>::empty() const noexcept {
+    return sentinel_.next_node() == &sentinel_;
+}
+
+/* O(1) with CountingPolicy, O(n) otherwise */
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::size() const noexcept -> size_type {
+    if constexpr (size_policy::is_counting) {
+        return size_.count();
+    }
+
+    size_type cnt = 0;
+
+    for (auto it = cbegin(); it != cend(); ++it) {
+        ++cnt;
+    }
+
+    return cnt;
+}
+
+/*---*---*---*---*---*---*---* Iterators *---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::front() noexcept -> reference {
+    assert(!empty() && "front() called on empty list...");
+    return *begin();
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::front() const noexcept -> const_reference {
+    assert(!empty() && "front() called on empty list...");
+    return *cbegin();
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::back() noexcept -> reference {
+    assert(!empty() && "back() called on empty list...");
+    return *hook_traits::to_value(tail_);
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::back() const noexcept -> const_reference {
+    assert(!empty() && "back() called on empty list...");
+    return *hook_traits::to_value(tail_);
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::before_begin() noexcept -> iterator {
+    /**
+     * the sentinel precedes the first element (and is also end())
+     */
+    return iterator(&sentinel_);
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::cbefore_begin() const noexcept -> const_iterator {
+    return const_iterator(const_cast<SListNodeBase*>(&sentinel_));
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::begin() noexcept -> iterator {
+    return iterator(sentinel_.next_node());
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::cbegin() const noexcept -> const_iterator {
+    return const_iterator(const_cast<SListNodeBase*>(sentinel_.next_node()));
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::end() noexcept -> iterator {
+    return iterator(&sentinel_);
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::cend() const noexcept -> const_iterator {
+    return const_iterator(const_cast<SListNodeBase*>(&sentinel_));
+}
+
+/*---*---*---*---*---*---*---* Modifiers *---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::insert_after(const_iterator pos,
+                                                 reference element) noexcept -> iterator {
+    node_type& node = *hook_traits::to_node(&element);
+
+    assert(!node.is_linked() && "Element already in a list!!");
+
+    /**
+     * Before : pos -> next
+     * After : pos -> node -> next
+     */
+    SListNodeBase* prev = pos.base();
+
+    node.link_after_base(prev);
+
+    if (prev == tail_) {
+        tail_ = &node;
+    }
+
+    size_.increment();
+
+    return iterator(&node);
+}
+
+template <typename T, typename... Options>
+void IntrusiveSList<T, Options...>::push_front(reference element) noexcept {
+    insert_after(cbefore_begin(), element);
+}
+
+template <typename T, typename... Options>
+void IntrusiveSList<T, Options...>::push_back(reference element) noexcept {
+    /**
+     * Before : ... -> tail -> sentinel
+     * After : ... -> tail' -> element -> sentinel
+     */
+    insert_after(const_iterator(tail_), element);
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::erase_after(const_iterator pos) noexcept -> iterator {
+    SListNodeBase* prev = pos.base();
+    SListNodeBase* node = prev->next_node();
+
+    assert(node != &sentinel_ && "Cannot erase sentinel...");
+
+    /**
+     * Before : prev -> node -> next
+     * After : prev -> next
+     */
+    prev->set_next(node->next_node());
+    node->set_next(nullptr);
+
+    if (node == tail_) {
+        tail_ = prev;
+    }
+
+    size_.decrement();
+
+    return iterator(prev->next_node());
+}
+
+template <typename T, typename... Options>
+void IntrusiveSList<T, Options...>::pop_front() noexcept {
+    assert(!empty() && "pop_front() on empty list!!");
+
+    erase_after(cbefore_begin());
+}
+
+template <typename T, typename... Options>
+void IntrusiveSList<T, Options...>::clear() noexcept {
+    SListNodeBase* node = sentinel_.next_node();
+
+    while (node != &sentinel_) {
+        SListNodeBase* next = node->next_node();
+        node->set_next(nullptr);
+        node = next;
+    }
+
+    init_sentinel();
+    size_.reset();
+}
+
+template <typename T, typename... Options>
+void IntrusiveSList<T, Options...>::transfer_after(SListNodeBase* pos, IntrusiveSList& other,
+                                                   SListNodeBase* before_first,
+                                                   SListNodeBase* last, size_type cnt) noexcept {
+    /*
+     * Before :
+     *    other list : ... -> before_first -> [first -> ... -> last] -> after -> ...
+     *
+     *    this list : ... -> pos -> next -> ...
+     *
+     * After :
+     *    other list : ... -> before_first -> after -> ...
+     *
+     *    this list : ... -> pos -> [first -> ... -> last] -> next -> ...
+     */
+    SListNodeBase* first = before_first->next_node();
+
+    before_first->set_next(last->next_node());
+
+    if (last == other.tail_) {
+        other.tail_ = before_first;
+    }
+
+    last->set_next(pos->next_node());
+    pos->set_next(first);
+
+    if (pos == tail_) {
+        tail_ = last;
+    }
+
+    if (this != &other) {
+        other.size_.subtract(cnt);
+        size_.add(cnt);
+    }
+}
+
+template <typename T, typename... Options>
+void IntrusiveSList<T, Options...>::splice_after(const_iterator pos,
+                                                 IntrusiveSList& other) noexcept {
+    if (other.empty() || this == &other) {
+        return;
+    }
+
+    size_type cnt = 0;
+
+    if constexpr (size_policy::is_counting) {
+        cnt = other.size();
+    }
+
+    transfer_after(pos.base(), other, &other.sentinel_, other.tail_, cnt);
+}
+
+template <typename T, typename... Options>
+void IntrusiveSList<T, Options...>::splice_after(const_iterator pos, IntrusiveSList& other,
+                                                 const_iterator before_first,
+                                                 const_iterator last) noexcept {
+    SListNodeBase* first = before_first.base()->next_node();
+
+    if (first == last.base()) {
+        return; /* Empty range */
+    }
+
+    /* find the last element IN the range */
+    SListNodeBase* actual_last = first;
+    size_type cnt = 1;
+
+    while (actual_last->next_node() != last.base()) {
+        actual_last = actual_last->next_node();
+        ++cnt;
+    }
+
+    transfer_after(pos.base(), other, before_first.base(), actual_last, cnt);
+}
+
+/*---*---*---*---*---*---*---*---* TRY *---*---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::try_pop_front() noexcept -> pointer {
+    if (empty()) {
+        return nullptr;
+    }
+
+    pointer result = &(front());
+    pop_front();
+
+    return result;
+}
+
+template <typename T, typename... Options>
+auto IntrusiveSList<T, Options...>::extract_front(IntrusiveSList& out,
+                                                  size_type max_cnt) noexcept -> size_type {
+    /*
+     * Extract up max_cnt elements from the front to the end of outer list
+     */
+    if (max_cnt == 0 || empty()) {
+        return 0;
+    }
+
+    size_type count = 1;
+    SListNodeBase* last = sentinel_.next_node();
+
+    /* find the last element to move */
+    while (count < max_cnt && last->next_node() != &sentinel_) {
+        last = last->next_node();
+        ++count;
+    }
+
+    out.transfer_after(out.tail_, *this, &sentinel_, last, count);
+
+    return count;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "hook.hpp"
+#include "node.hpp"
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Link of a singly-linked intrusive list : one pointer.
+ *
+ * Unlinked state : next_ == nullptr.
+ * The last element of a list points back to the list's sentinel, so a linked
+ * node is never null and linked-ness costs no extra field.
+ */
+struct SListNodeBase {
+
+    /*---*---*---*---*---*---*/
+
+    SListNodeBase* next_{nullptr};
+
+    /*---*---*---*---*---*---*/
+
+    [[nodiscard]]
+    SListNodeBase* next_node() noexcept;
+
+    [[nodiscard]]
+    const SListNodeBase* next_node() const noexcept;
+
+    void set_next(SListNodeBase* n) noexcept;
+
+    [[nodiscard]]
+    bool is_linked_base() const noexcept;
+
+    /**
+     * @brief Links this node right after prev.
+     *
+     * Before: prev -> next
+     * After:  prev -> this -> next
+     */
+    void link_after_base(SListNodeBase* prev) noexcept;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Intrusive singly-linked list node, 8 bytes.
+ * Inherit from this class (or embed it as a member) to put objects in an IntrusiveSList.
+ *
+ * >> SAFETY : there is no prev pointer, so a node cannot unlink itself.
+ *    Destroying a linked node is a bug (assert).
+ *
+ * >> USAGE :
+ *  struct Job : IntrusiveSListNode<> {
+ *    void whatever(...);
+ *  };
+ */
+template <typename Tag = DefaultTag>
+class IntrusiveSListNode : public SListNodeBase {
+  public:
+    using tag_type = Tag;
+
+    constexpr IntrusiveSListNode() noexcept = default;
+
+    ~IntrusiveSListNode();
+
+    /* non-copyable */
+    IntrusiveSListNode(const IntrusiveSListNode&) = delete;
+    IntrusiveSListNode& operator=(const IntrusiveSListNode&) = delete;
+
+    /* non-moveble */
+    IntrusiveSListNode(IntrusiveSListNode&&) noexcept = delete;
+    IntrusiveSListNode& operator=(IntrusiveSListNode&&) noexcept = delete;
+
+    /**
+     * @brief Is this node currently in a list?
+     */
+    [[nodiscard]]
+    bool is_linked() const noexcept;
+};
+
+static_assert(sizeof(IntrusiveSListNode<>) == sizeof(void*), "slist hook must stay one pointer");
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Same hook options as IntrusiveList (BaseHook<Tag> / MemberHook<&T::hook>),
+ * resolved against IntrusiveSListNode<Tag> instead.
+ */
+template <typename T, typename Hook>
+struct SListHookTraits;
+
+template <typename T, typename Tag>
+struct SListHookTraits<T, BaseHook<Tag>> {
+    static_assert(std::is_base_of_v<IntrusiveSListNode<Tag>, T>,
+                  "T must inherit from IntrusiveSListNode<Tag>");
+
+    using value_type = T;
+    using node_type = IntrusiveSListNode<Tag>;
+
+    [[nodiscard]]
+    static constexpr node_type* to_node(T* value) noexcept {
+        return static_cast<node_type*>(value);
+    }
+
+    [[nodiscard]]
+    static constexpr T* to_value(SListNodeBase* node) noexcept {
+        return static_cast<T*>(static_cast<node_type*>(node));
+    }
+};
+
+template <typename T, auto Member>
+struct SListHookTraits<T, MemberHook<Member>> {
+    using owner_type = typename MemberPointerTraits<decltype(Member)>::owner_type;
+
+    static_assert(std::is_same_v<owner_type, T> || std::is_base_of_v<owner_type, T>,
+                  "MemberHook<&Owner::hook> must point into T");
+
+    using value_type = T;
+    using node_type = typename MemberPointerTraits<decltype(Member)>::field_type;
+
+    static_assert(std::is_base_of_v<SListNodeBase, node_type>,
+                  "MemberHook<> must point to an IntrusiveSListNode<...> member");
+
+    [[nodiscard]]
+    static node_type* to_node(T* value) noexcept {
+        return &(static_cast<owner_type*>(value)->*Member);
+    }
+
+    [[nodiscard]]
+    static T* to_value(SListNodeBase* node) noexcept {
+        auto* bytes = reinterpret_cast<unsigned char*>(static_cast<node_type*>(node));
+
+        return static_cast<T*>(reinterpret_cast<owner_type*>(bytes - member_offset<Member>()));
+    }
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+inline SListNodeBase* SListNodeBase::next_node() noexcept {
+    return next_;
+}
+
+inline const SListNodeBase* SListNodeBase::next_node() const noexcept {
+    return next_;
+}
+
+inline void SListNodeBase::set_next(SListNodeBase* n) noexcept {
+    next_ = n;
+}
+
+inline bool SListNodeBase::is_linked_base() const noexcept {
+    return next_ != nullptr;
+}
+
+inline void SListNodeBase::link_after_base(SListNodeBase* prev) noexcept {
+    next_ = prev->next_;
+    prev->next_ = this;
+}
+
+template <typename Tag>
+IntrusiveSListNode<Tag>::~IntrusiveSListNode() {
+    assert(!is_linked() && "destroying node still in a list...");
+}
+
+template <typename Tag>
+bool IntrusiveSListNode<Tag>::is_linked() const noexcept {
+    return is_linked_base();
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
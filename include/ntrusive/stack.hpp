@@ -0,0 +1,274 @@
+#pragma once
+
+#include "base_node.hpp"
+#include "config.hpp"
+#include "list.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Lock-free intrusive stack (Treiber) with ABA protection.
+ *
+ * Reuses the IntrusiveListNode<...> hook of T (the same hook options as IntrusiveList),
+ * only its next_ pointer is used, through std::atomic_ref.
+ *
+ *  >> push()      : lock-free, any thread
+ *  >> try_pop()   : lock-free, any thread
+ *  >> pop_all()   : takes the whole stack with ONE atomic RMW, hands it over as an IntrusiveList
+ *  >> push_all()  : gives a whole IntrusiveList back, published with one successful CAS
+ *
+ * @section ABA
+ * The top pointer is tagged : the upper 16 bits of the 64-bit word carry a counter
+ * bumped by every push/pop, so a pop that read (X, tag) fails its CAS when X was
+ * popped and pushed back in the meantime. Needs 48-bit user space addresses (x86-64, aarch64).
+ *
+ * The tag wraps after 65536 operations, an ABA would need exactly that many
+ * push/pops between a reader's load and its CAS.
+ *
+ * >> MEMORY : try_pop() may read the next_ of an element that another thread has
+ *    just popped (the value is then discarded by the failing CAS). Elements must stay
+ *    readable while the stack is in use (type-stable storage : pools, free-lists),
+ *    never return them to the allocator.
+ *
+ * >> OWNERSHIP : while stacked, the hook belongs to the stack. Popped elements
+ *    come out with a reset hook. is_linked() is meaningless while stacked (the bottom
+ *    element keeps a null next_) : push() catches elements linked in a list, not ones
+ *    already on a stack. Every write of the stack to a next_ is a relaxed
+ *    atomic one, push_all() / pop_all() move whole chains without the list's plain stores.
+ *    Linking a popped element elsewhere is still a plain store that a late try_pop()
+ *    may race with (and discard) : the price of a lock-free stack without hazard pointers.
+ */
+template <typename T, typename... Options>
+class IntrusiveStack {
+    static_assert(sizeof(std::uintptr_t) == 8, "IntrusiveStack packs an ABA tag into 64-bit pointers");
+
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using size_type = std::size_t;
+
+    using hook_traits = typename ListOptions<T, Options...>::hook_traits;
+    using node_type = typename hook_traits::node_type;
+
+    using list_type = IntrusiveList<T, Options...>;
+
+    static_assert(!node_type::link_mode::is_tracked,
+                  "IntrusiveStack does not maintain the flag of TrackedLink hooks");
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    IntrusiveStack() noexcept = default;
+
+    ~IntrusiveStack();
+
+    IntrusiveStack(const IntrusiveStack&) = delete;
+    IntrusiveStack& operator=(const IntrusiveStack&) = delete;
+
+    IntrusiveStack(IntrusiveStack&&) = delete;
+    IntrusiveStack& operator=(IntrusiveStack&&) = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    void push(reference element) noexcept;
+
+    /**
+     * @brief Pushes the whole list (its front ends up on top), leaving it empty.
+     */
+    void push_all(list_type& in) noexcept;
+
+    [[nodiscard]]
+    auto try_pop() noexcept -> pointer;
+
+    /**
+     * @brief Takes every element at once and appends them to out, top first.
+     *
+     * @return Number of elements moved.
+     */
+    auto pop_all(list_type& out) noexcept -> size_type;
+
+    /**
+     * @brief Snapshot, may be stale by the time it returns.
+     */
+    [[nodiscard]]
+    bool empty() const noexcept;
+
+  private:
+    /* [ tag : 16 | pointer : 48 ] */
+    static constexpr unsigned kTagShift = 48;
+    static constexpr std::uintptr_t kPtrMask = (std::uintptr_t{1} << kTagShift) - 1;
+    static constexpr std::uintptr_t kTagMask = ~kPtrMask;
+    static constexpr std::uintptr_t kTagOne = std::uintptr_t{1} << kTagShift;
+
+    [[nodiscard]]
+    static NodeBase* ptr_of(std::uintptr_t word) noexcept;
+
+    /* word with the new pointer and the next tag */
+    [[nodiscard]]
+    static std::uintptr_t retag(std::uintptr_t word, NodeBase* node) noexcept;
+
+    /* links [first ... last] on top with a CAS loop */
+    void push_chain(NodeBase* first, NodeBase* last) noexcept;
+
+    /*
+     * next_ of a stacked node is read by try_pop() threads that may lose the race for it :
+     * every access of the stack goes through std::atomic_ref, relaxed (the ordering comes from top_)
+     */
+    [[nodiscard]]
+    static NodeBase* load_next(NodeBase* node) noexcept;
+
+    static void store_next(NodeBase* node, NodeBase* next) noexcept;
+
+    /* reset_base() with an atomic store to next_ */
+    static void detach(NodeBase* node) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    alignas(kCacheLineSize) std::atomic<std::uintptr_t> top_{0};
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename... Options>
+IntrusiveStack<T, Options...>::~IntrusiveStack() {
+    assert(empty() && "destroying non-empty IntrusiveStack...");
+}
+
+template <typename T, typename... Options>
+NodeBase* IntrusiveStack<T, Options...>::ptr_of(std::uintptr_t word) noexcept {
+    return reinterpret_cast<NodeBase*>(word & kPtrMask);
+}
+
+template <typename T, typename... Options>
+std::uintptr_t IntrusiveStack<T, Options...>::retag(std::uintptr_t word, NodeBase* node) noexcept {
+    auto bits = reinterpret_cast<std::uintptr_t>(node);
+
+    assert((bits & kTagMask) == 0 && "pointer does not fit in 48 bits...");
+
+    return ((word & kTagMask) + kTagOne) | bits;
+}
+
+template <typename T, typename... Options>
+NodeBase* IntrusiveStack<T, Options...>::load_next(NodeBase* node) noexcept {
+    return std::atomic_ref<NodeBase*>(node->next_).load(std::memory_order_relaxed);
+}
+
+template <typename T, typename... Options>
+void IntrusiveStack<T, Options...>::store_next(NodeBase* node, NodeBase* next) noexcept {
+    std::atomic_ref<NodeBase*>(node->next_).store(next, std::memory_order_relaxed);
+}
+
+template <typename T, typename... Options>
+void IntrusiveStack<T, Options...>::detach(NodeBase* node) noexcept {
+    node->set_prev(nullptr);
+    store_next(node, nullptr);
+}
+
+template <typename T, typename... Options>
+void IntrusiveStack<T, Options...>::push_chain(NodeBase* first, NodeBase* last) noexcept {
+    std::uintptr_t top = top_.load(std::memory_order_relaxed);
+
+    /**
+     * Before : top -> old ...
+     * After  : top -> first -> ... -> last -> old ...
+     */
+    do {
+        store_next(last, ptr_of(top));
+    } while (!top_.compare_exchange_weak(top, retag(top, first),
+                                         std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename T, typename... Options>
+void IntrusiveStack<T, Options...>::push(reference element) noexcept {
+    node_type& node = *hook_traits::to_node(&element);
+
+    if constexpr (node_type::link_mode::is_safe) {
+        assert(!node.is_linked() && "Element already in a list!!");
+    }
+
+    push_chain(&node, &node);
+}
+
+template <typename T, typename... Options>
+void IntrusiveStack<T, Options...>::push_all(list_type& in) noexcept {
+    if (in.empty()) {
+        return;
+    }
+
+    /*
+     * The list is already chained front to back through next_ : take it as it is,
+     * only the back's next_ is rewritten (by push_chain()), the hooks stay untouched.
+     */
+    NodeBase* first = hook_traits::to_node(&in.front());
+    NodeBase* last = hook_traits::to_node(&in.back());
+
+    in.init_sentinel();
+    in.size_.reset();
+
+    push_chain(first, last);
+}
+
+template <typename T, typename... Options>
+auto IntrusiveStack<T, Options...>::try_pop() noexcept -> pointer {
+    std::uintptr_t top = top_.load(std::memory_order_acquire);
+
+    for (;;) {
+        NodeBase* node = ptr_of(top);
+
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        /* node may be popped (not freed) concurrently : the tag makes the CAS fail then */
+        NodeBase* next = load_next(node);
+
+        if (top_.compare_exchange_weak(top, retag(top, next),
+                                       std::memory_order_acquire, std::memory_order_acquire)) {
+            detach(node);
+            return hook_traits::to_value(node);
+        }
+    }
+}
+
+template <typename T, typename... Options>
+auto IntrusiveStack<T, Options...>::pop_all(list_type& out) noexcept -> size_type {
+    /**
+     * Keep the tag, drop the pointer : a later push bumps the tag anyway,
+     * so (X, tag) can never be observed twice.
+     */
+    std::uintptr_t top = top_.fetch_and(kTagMask, std::memory_order_acquire);
+
+    NodeBase* node = ptr_of(top);
+    NodeBase* tail = out.sentinel_.prev_node();
+    size_type count = 0;
+
+    /* link the chain behind out's tail, every next_ written through store_next() */
+    while (node != nullptr) {
+        NodeBase* next = load_next(node);
+
+        node->set_prev(tail);
+        store_next(tail, node);
+
+        tail = node;
+        node = next;
+        ++count;
+    }
+
+    store_next(tail, &out.sentinel_);
+    out.sentinel_.set_prev(tail);
+    out.size_.add(count);
+
+    return count;
+}
+
+template <typename T, typename... Options>
+bool IntrusiveStack<T, Options...>::empty() const noexcept {
+    return ptr_of(top_.load(std::memory_order_relaxed)) == nullptr;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -0,0 +1,403 @@
+#pragma once
+
+#include "config.hpp"
+#include "list.hpp"
+#include "work_stealing_deque.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Hook tag of ThreadPool tasks, so a task keeps its default hook for the user's own lists.
+ */
+struct PoolTaskTag {};
+
+/**
+ * @brief Unit of work of a ThreadPool : derive from it and implement run().
+ *
+ * The task object IS the queue node : submitting never allocates. It must stay
+ * alive until run() starts, run() may then destroy or resubmit it.
+ *
+ * >> USAGE :
+ *  struct Request : PoolTask {
+ *    void run() noexcept override { ... }
+ *  };
+ */
+class PoolTask : public IntrusiveListNode<PoolTaskTag, SafeLink> {
+  public:
+    virtual void run() noexcept = 0;
+
+  protected:
+    ~PoolTask() = default;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Work-stealing executor of intrusive PoolTask objects.
+ *
+ *   submit() from outside           submit() from a task
+ *           |                               |
+ *           v                               v
+ *   [ global overflow list ]     [ worker's IntrusiveWorkStealingDeque ] <-- steal_batch() --
+ *      (mutex, batches out)          (owner LIFO, no lock)                  by idle workers
+ *
+ *  >> submit()       : O(1), no allocation ; inside the pool : a push on the worker's own deque
+ *  >> submit_batch() : one splice of the whole list under the global lock, from any thread,
+ *                      O(1) since task_list counts its elements
+ *
+ * An idle worker pops its deque, then takes a batch from the global list, then steals
+ * from a random victim, spins kSpinRounds times through all of that, and only then
+ * parks. Parking is an eventcount : an epoch counter waited on with std::atomic::wait
+ * (a futex on Linux), bumped by submitters only when some worker is idle.
+ *
+ * The destructor runs every task submitted before it, including the ones those tasks
+ * submit, then joins the workers.
+ */
+class ThreadPool {
+  public:
+    using size_type = std::size_t;
+    /* counting : a batch is handed over without walking it */
+    using task_list = IntrusiveList<PoolTask, BaseHook<PoolTaskTag>, CountingPolicy>;
+
+    static constexpr size_type kLocalCapacity = 1024;
+
+    /* tasks taken from the global list at once */
+    static constexpr size_type kGlobalBatch = 32;
+
+    /* tasks taken from a victim at once */
+    static constexpr size_type kStealBatch = 32;
+
+    /* rounds of "look everywhere" before parking */
+    static constexpr unsigned kSpinRounds = 64;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    explicit ThreadPool(size_type threads = std::thread::hardware_concurrency());
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    void submit(PoolTask& task) noexcept;
+
+    /**
+     * @brief Submits every task of tasks with one splice onto the global list, leaving
+     * it empty. O(1), also when called from inside the pool.
+     */
+    void submit_batch(task_list& tasks) noexcept;
+
+    [[nodiscard]]
+    auto thread_count() const noexcept -> size_type;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    struct alignas(kCacheLineSize) Worker {
+        IntrusiveWorkStealingDeque<PoolTask, kLocalCapacity, BaseHook<PoolTaskTag>, CountingPolicy> deque;
+        std::thread thread;
+    };
+
+    /* the worker the calling thread is, in this pool, or nullptr */
+    [[nodiscard]]
+    auto current_worker() const noexcept -> Worker*;
+
+    void worker_loop(size_type index) noexcept;
+
+    /* next task for worker : own deque, global list, then a victim's deque */
+    [[nodiscard]]
+    auto find_task(size_type index, std::minstd_rand& rng) noexcept -> PoolTask*;
+
+    [[nodiscard]]
+    auto take_global(Worker& self) noexcept -> PoolTask*;
+
+    [[nodiscard]]
+    auto steal(size_type index, std::minstd_rand& rng) noexcept -> PoolTask*;
+
+    void push_global(task_list& tasks) noexcept;
+
+    /* unparks up to n idle workers */
+    void wake(size_type n) noexcept;
+
+    void park(std::uint32_t epoch) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    alignas(kCacheLineSize) std::mutex global_mutex_;
+    task_list global_;
+    std::atomic<bool> global_empty_{true};
+
+    /* eventcount */
+    alignas(kCacheLineSize) std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<size_type> idle_{0};
+
+    /* tasks submitted and not yet started : the destructor waits for 0 */
+    alignas(kCacheLineSize) std::atomic<size_type> pending_{0};
+    std::atomic<bool> stop_{false};
+
+    /* which pool / worker the calling thread belongs to */
+    static inline thread_local const ThreadPool* tls_pool_ = nullptr;
+    static inline thread_local Worker* tls_worker_ = nullptr;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+inline ThreadPool::ThreadPool(size_type threads) {
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    workers_.reserve(threads);
+
+    for (size_type i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    /* start only once every deque exists : thieves index the whole vector */
+    for (size_type i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread([this, i] { worker_loop(i); });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    stop_.store(true, std::memory_order_seq_cst);
+
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    epoch_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+
+    assert(global_.empty() && "ThreadPool destroyed with queued tasks...");
+}
+
+inline auto ThreadPool::thread_count() const noexcept -> size_type {
+    return workers_.size();
+}
+
+inline auto ThreadPool::current_worker() const noexcept -> Worker* {
+    return (tls_pool_ == this) ? tls_worker_ : nullptr;
+}
+
+/*---*---*---*---*---*---*---* Submission *---*---*---*---*---*---*---*/
+
+inline void ThreadPool::submit(PoolTask& task) noexcept {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+
+    Worker* self = current_worker();
+
+    if (self != nullptr && self->deque.push(task)) {
+        wake(1);
+        return;
+    }
+
+    task_list one;
+    one.push_back(task);
+
+    push_global(one);
+    wake(1);
+}
+
+inline void ThreadPool::submit_batch(task_list& tasks) noexcept {
+    if (tasks.empty()) {
+        return;
+    }
+
+    /* O(1) : the list counts */
+    const size_type cnt = tasks.size();
+
+    pending_.fetch_add(cnt, std::memory_order_relaxed);
+
+    /* from a worker as well : a whole batch is for everybody, not for this worker's deque */
+    push_global(tasks);
+
+    wake(cnt);
+}
+
+inline void ThreadPool::push_global(task_list& tasks) noexcept {
+    std::lock_guard lock(global_mutex_);
+
+    global_.splice(global_.cend(), tasks);
+    global_empty_.store(false, std::memory_order_relaxed);
+}
+
+/*---*---*---*---*---*---*---* Workers *---*---*---*---*---*---*---*/
+
+inline auto ThreadPool::take_global(Worker& self) noexcept -> PoolTask* {
+    /* cheap peek first : idle workers must not hammer the lock (seq_cst : see wake()) */
+    if (global_empty_.load(std::memory_order_seq_cst)) {
+        return nullptr;
+    }
+
+    task_list batch;
+
+    {
+        std::lock_guard lock(global_mutex_);
+
+        const size_type taken = global_.extract_front(batch, kGlobalBatch);
+        global_empty_.store(global_.empty(), std::memory_order_relaxed);
+
+        if (taken == 0) {
+            return nullptr;
+        }
+    }
+
+    PoolTask* first = batch.try_pop_front();
+
+    /* the rest becomes stealable right away */
+    self.deque.push_from(batch);
+
+    if (!batch.empty()) {
+        push_global(batch);
+    }
+
+    return first;
+}
+
+inline auto ThreadPool::steal(size_type index, std::minstd_rand& rng) noexcept -> PoolTask* {
+    const size_type n = workers_.size();
+
+    if (n < 2) {
+        return nullptr;
+    }
+
+    /* one pass over every other worker, from a random start */
+    const size_type start = rng() % n;
+
+    for (size_type i = 0; i < n; ++i) {
+        const size_type victim = (start + i) % n;
+
+        if (victim == index) {
+            continue;
+        }
+
+        task_list loot;
+
+        if (workers_[victim]->deque.steal_batch(loot, kStealBatch) == 0) {
+            continue;
+        }
+
+        PoolTask* first = loot.try_pop_front();
+
+        workers_[index]->deque.push_from(loot);
+
+        if (!loot.empty()) {
+            push_global(loot);
+        }
+
+        return first;
+    }
+
+    return nullptr;
+}
+
+inline auto ThreadPool::find_task(size_type index, std::minstd_rand& rng) noexcept -> PoolTask* {
+    Worker& self = *workers_[index];
+
+    if (PoolTask* task = self.deque.pop()) {
+        return task;
+    }
+
+    if (PoolTask* task = take_global(self)) {
+        return task;
+    }
+
+    return steal(index, rng);
+}
+
+inline void ThreadPool::worker_loop(size_type index) noexcept {
+    tls_pool_ = this;
+    tls_worker_ = workers_[index].get();
+
+    std::minstd_rand rng(static_cast<std::minstd_rand::result_type>(index + 1));
+
+    for (;;) {
+        PoolTask* task = nullptr;
+
+        for (unsigned round = 0; round < kSpinRounds && task == nullptr; ++round) {
+            task = find_task(index, rng);
+
+            if (task == nullptr) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (task != nullptr) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            task->run();
+            continue;
+        }
+
+        /* announce idleness BEFORE the last look : a submitter either sees idle_ or we see its task */
+        const std::uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+        idle_.fetch_add(1, std::memory_order_seq_cst);
+
+        task = find_task(index, rng);
+
+        if (task != nullptr) {
+            idle_.fetch_sub(1, std::memory_order_relaxed);
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            task->run();
+            continue;
+        }
+
+        if (stop_.load(std::memory_order_seq_cst) &&
+            pending_.load(std::memory_order_seq_cst) == 0) {
+            idle_.fetch_sub(1, std::memory_order_relaxed);
+
+            /* pass the word on : the next parked worker re-checks and leaves too */
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            epoch_.notify_all();
+            break;
+        }
+
+        park(epoch);
+        idle_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    tls_pool_ = nullptr;
+    tls_worker_ = nullptr;
+}
+
+/*---*---*---*---*---*---*---* Parking *---*---*---*---*---*---*---*/
+
+inline void ThreadPool::wake(size_type n) noexcept {
+    /* pairs with the idle_ increment of a worker about to park */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (idle_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+
+    if (n == 1) {
+        epoch_.notify_one();
+    } else {
+        epoch_.notify_all();
+    }
+}
+
+inline void ThreadPool::park(std::uint32_t epoch) noexcept {
+    epoch_.wait(epoch, std::memory_order_seq_cst);
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
@@ -0,0 +1,333 @@
+#pragma once
+
+#include "list.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Default deadline accessor of IntrusiveTimerWheel : reads element.deadline (in ticks).
+ */
+struct MemberDeadline {
+    template <typename T>
+    [[nodiscard]]
+    constexpr auto operator()(const T& element) const noexcept -> std::uint64_t {
+        return element.deadline;
+    }
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief Hierarchical timing wheel whose buckets are IntrusiveList<T, Options...> slots.
+ *
+ * kLevels wheels of kSlots slots, a slot of level k spans kSlots^k ticks.
+ * A timer sits at the level of the highest digit (base kSlots) where its deadline
+ * differs from now, in the slot of that digit. When now reaches that slot, the
+ * slot is cascaded : its timers move one by one (splice_cell, no copies) to the
+ * lower levels, or to the expired list. Deadlines beyond kSlots^kLevels ticks
+ * wait in an overflow list, re-examined every time the top level wraps.
+ *
+ *  >> schedule() : O(1)
+ *  >> cancel()   : O(1), static, IntrusiveList::remove() on whatever slot holds the timer
+ *  >> advance()  : O(kLevels per occupied slot reached + expired + cascaded), expired slots
+ *                  are spliced out whole and empty stretches are jumped over : an idle
+ *                  wheel moves to any now in O(kLevels)
+ *
+ * Each level keeps a bitmap of its occupied slots. cancel() cannot clear a bit (it does not
+ * know the wheel) : a stale bit only costs a visit to an empty slot, a clear bit is always exact.
+ *
+ * A deadline at or before now() fires on the next tick.
+ *
+ * Timers are mostly cancelled before they fire : a cancelled timer is never
+ * touched again by the wheel, it only ever pays for its push_back and its unlink.
+ *
+ * @tparam DeadlineOf Functor returning the deadline (std::uint64_t ticks) of an element,
+ *                    it must not change while the element is scheduled.
+ * @tparam Options    Same as IntrusiveList, without CountingPolicy (cancel() bypasses the slots).
+ *
+ * >> USAGE :
+ *  struct Conn : IntrusiveListNode<> {
+ *    std::uint64_t deadline;
+ *  };
+ *
+ *  IntrusiveTimerWheel<Conn> timeouts(now_ms());
+ *
+ *  conn.deadline = now_ms() + 30'000;
+ *  timeouts.schedule(conn);
+ *  ...
+ *  IntrusiveTimerWheel<Conn>::cancel(conn);
+ *  ...
+ *  IntrusiveList<Conn> expired;
+ *  timeouts.advance(now_ms(), expired);
+ */
+template <typename T, typename DeadlineOf = MemberDeadline, typename... Options>
+class IntrusiveTimerWheel {
+  public:
+    using value_type = T;
+    using reference = T&;
+    using size_type = std::size_t;
+
+    using list_type = IntrusiveList<T, Options...>;
+
+    static_assert(!list_type::size_policy::is_counting,
+                  "timer wheel slots cannot count : cancel() unlinks behind their back");
+
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+    static constexpr unsigned kLevels = 4;
+
+    static_assert(kSlots <= 64, "a level's occupancy bitmap is one std::uint64_t");
+
+    /* first deadline distance that does not fit in the wheels */
+    static constexpr std::uint64_t kRange = std::uint64_t{1} << (kSlotBits * kLevels);
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    explicit IntrusiveTimerWheel(std::uint64_t now = 0, const DeadlineOf& deadline_of = {}) noexcept;
+
+    ~IntrusiveTimerWheel();
+
+    IntrusiveTimerWheel(const IntrusiveTimerWheel&) = delete;
+    IntrusiveTimerWheel& operator=(const IntrusiveTimerWheel&) = delete;
+
+    IntrusiveTimerWheel(IntrusiveTimerWheel&&) = delete;
+    IntrusiveTimerWheel& operator=(IntrusiveTimerWheel&&) = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief Arms element for the deadline DeadlineOf reads from it. The element must not be linked.
+     */
+    void schedule(reference element) noexcept;
+
+    /**
+     * @brief Disarms element, no-op if it is not scheduled (SafeLink / AutoUnlink hooks).
+     */
+    static void cancel(reference element) noexcept;
+
+    /**
+     * @brief Moves the wheel to now and appends every timer due at or before now to expired,
+     * tick by tick (timers of the same tick in no particular order).
+     */
+    void advance(std::uint64_t now, list_type& expired) noexcept;
+
+    /**
+     * @brief Disarms every timer, one pass resetting the hooks.
+     */
+    void clear() noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    [[nodiscard]]
+    auto now() const noexcept -> std::uint64_t;
+
+    /* O(kLevels * kSlots) */
+    [[nodiscard]] bool empty() const noexcept;
+
+  private:
+    /* slot to file deadline in, marked occupied */
+    [[nodiscard]]
+    auto slot_for(std::uint64_t deadline) noexcept -> list_type&;
+
+    /* first tick after now_ with a slot (or the overflow list) to process, kNever if none */
+    [[nodiscard]]
+    auto next_event() const noexcept -> std::uint64_t;
+
+    /* takes the slot of level due at now_ out of the bitmap */
+    [[nodiscard]]
+    auto take_slot(unsigned level) noexcept -> list_type&;
+
+    /* re-files every timer of from relative to now_, due ones go to expired */
+    void cascade(list_type& from, list_type& expired) noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    list_type wheels_[kLevels][kSlots];
+    list_type overflow_;
+
+    /* bit s of occupied_[k] : wheels_[k][s] may hold timers */
+    std::uint64_t occupied_[kLevels]{};
+
+    std::uint64_t now_;
+
+    [[no_unique_address]] DeadlineOf deadline_of_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, typename DeadlineOf, typename... Options>
+IntrusiveTimerWheel<T, DeadlineOf, Options...>::IntrusiveTimerWheel(
+    std::uint64_t now, const DeadlineOf& deadline_of) noexcept
+    : now_(now), deadline_of_(deadline_of) {}
+
+template <typename T, typename DeadlineOf, typename... Options>
+IntrusiveTimerWheel<T, DeadlineOf, Options...>::~IntrusiveTimerWheel() {
+    clear();
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+auto IntrusiveTimerWheel<T, DeadlineOf, Options...>::now() const noexcept -> std::uint64_t {
+    return now_;
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+bool IntrusiveTimerWheel<T, DeadlineOf, Options...>::empty() const noexcept {
+    for (const auto& level : wheels_) {
+        for (const auto& slot : level) {
+            if (!slot.empty()) {
+                return false;
+            }
+        }
+    }
+
+    return overflow_.empty();
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+auto IntrusiveTimerWheel<T, DeadlineOf, Options...>::slot_for(std::uint64_t deadline) noexcept
+    -> list_type& {
+    if (deadline <= now_) {
+        deadline = now_ + 1;
+    }
+
+    /**
+     * Highest differing digit of deadline and now_ :
+     *
+     *   now_     : [ d3 | d2 | d1 | d0 ]
+     *   deadline : [ d3 | d2'| x  | x  ]   -> level 2, slot d2'
+     */
+    const std::uint64_t diff = deadline ^ now_;
+    const auto level = static_cast<unsigned>(std::bit_width(diff) - 1) / kSlotBits;
+
+    if (level >= kLevels) {
+        return overflow_;
+    }
+
+    const auto slot = static_cast<std::size_t>((deadline >> (level * kSlotBits)) & (kSlots - 1));
+    occupied_[level] |= std::uint64_t{1} << slot;
+
+    return wheels_[level][slot];
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+auto IntrusiveTimerWheel<T, DeadlineOf, Options...>::next_event() const noexcept -> std::uint64_t {
+    constexpr std::uint64_t kNever = std::numeric_limits<std::uint64_t>::max();
+    constexpr unsigned kTopShift = kLevels * kSlotBits;
+
+    /* the overflow list is re-examined when the top level wraps */
+    std::uint64_t next = overflow_.empty() ? kNever : ((now_ >> kTopShift) + 1) << kTopShift;
+
+    for (unsigned level = 0; level < kLevels; ++level) {
+        const unsigned shift = level * kSlotBits;
+        const std::uint64_t digit = (now_ >> shift) & (kSlots - 1);
+
+        /**
+         * Slots up to the current digit were processed on the way here : only the ones ahead count.
+         * The first of them is due when the digit reaches it, every lower digit being zero :
+         *
+         *   now_ : [ d3 | d2 | d1 | d0 ]   level 1, first slot ahead s -> [ d3 | d2 | s | 0 ]
+         */
+        const std::uint64_t ahead = occupied_[level] & ~((std::uint64_t{2} << digit) - 1);
+
+        if (ahead != 0) {
+            const std::uint64_t base = (now_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+            next = std::min(next, base | (static_cast<std::uint64_t>(std::countr_zero(ahead)) << shift));
+        }
+    }
+
+    return next;
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+auto IntrusiveTimerWheel<T, DeadlineOf, Options...>::take_slot(unsigned level) noexcept -> list_type& {
+    const auto slot = static_cast<std::size_t>((now_ >> (level * kSlotBits)) & (kSlots - 1));
+    occupied_[level] &= ~(std::uint64_t{1} << slot);
+
+    return wheels_[level][slot];
+}
+
+/*---*---*---*---*---*---*---* Modifiers *---*---*---*---*---*---*---*/
+
+template <typename T, typename DeadlineOf, typename... Options>
+void IntrusiveTimerWheel<T, DeadlineOf, Options...>::schedule(reference element) noexcept {
+    slot_for(deadline_of_(element)).push_back(element);
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+void IntrusiveTimerWheel<T, DeadlineOf, Options...>::cancel(reference element) noexcept {
+    list_type::remove(element);
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+void IntrusiveTimerWheel<T, DeadlineOf, Options...>::cascade(list_type& from,
+                                                            list_type& expired) noexcept {
+    /* detach first : an overflow timer may be filed back into the overflow list */
+    list_type pending;
+    pending.splice(pending.cend(), from);
+
+    while (!pending.empty()) {
+        auto first = pending.cbegin();
+        const std::uint64_t deadline = deadline_of_(*first);
+
+        list_type& to = (deadline <= now_) ? expired : slot_for(deadline);
+
+        to.splice_cell(to.cend(), pending, first);
+    }
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+void IntrusiveTimerWheel<T, DeadlineOf, Options...>::advance(std::uint64_t now,
+                                                            list_type& expired) noexcept {
+    while (now_ < now) {
+        /* every tick before the next event has nothing to process : jump over them */
+        const std::uint64_t next = next_event();
+
+        if (next > now) {
+            now_ = now;
+            return;
+        }
+
+        now_ = next;
+
+        /* number of low digits of now_ that just wrapped to zero */
+        unsigned wrapped = 0;
+
+        while (wrapped < kLevels && ((now_ >> (wrapped * kSlotBits)) & (kSlots - 1)) == 0) {
+            ++wrapped;
+        }
+
+        if (wrapped == kLevels) {
+            cascade(overflow_, expired);
+        }
+
+        /* top-down : a slot of level k is due once every digit below k is zero */
+        for (unsigned level = (wrapped == kLevels) ? kLevels - 1 : wrapped; level > 0; --level) {
+            cascade(take_slot(level), expired);
+        }
+
+        expired.splice(expired.cend(), take_slot(0));
+    }
+}
+
+template <typename T, typename DeadlineOf, typename... Options>
+void IntrusiveTimerWheel<T, DeadlineOf, Options...>::clear() noexcept {
+    for (auto& level : wheels_) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+
+    overflow_.clear();
+
+    std::fill(std::begin(occupied_), std::end(occupied_), std::uint64_t{0});
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
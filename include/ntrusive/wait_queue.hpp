@@ -0,0 +1,704 @@
+#pragma once
+
+#include "list.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Hook tag of SyncWaiter records.
+ */
+struct SyncWaitTag {};
+
+/**
+ * @brief Test-and-test-and-set spinlock guarding the waiter lists below.
+ *
+ * Held for a handful of pointer writes, never while a thread sleeps.
+ */
+class SpinLock {
+  public:
+    void lock() noexcept;
+
+    [[nodiscard]] bool try_lock() noexcept;
+
+    void unlock() noexcept;
+
+  private:
+    std::atomic<bool> locked_{false};
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief One blocked thread : a record on the waiting thread's stack, linked into
+ * the wait-list of a FifoMutex / FifoCondVar / FifoSemaphore.
+ *
+ * Each waiter sleeps on its own 32-bit word (a futex on Linux), so a wakeup
+ * reaches exactly the thread it is meant for : no herd, and the order is the
+ * order of the list.
+ *
+ * Waker side : unlink the record under the wait-list lock, THEN unpark() it outside.
+ * Once unpark() has stored the word, the record may be gone.
+ */
+class SyncWaiter : public IntrusiveListNode<SyncWaitTag, SafeLink> {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    SyncWaiter() noexcept = default;
+
+    /**
+     * @brief Blocks until unpark().
+     */
+    void park() noexcept;
+
+    /**
+     * @brief Blocks until unpark() or deadline.
+     *
+     * @return false on timeout : the record may still be linked, the caller removes it.
+     */
+    [[nodiscard]]
+    bool park_until(clock::time_point deadline) noexcept;
+
+    void unpark() noexcept;
+
+  private:
+    static constexpr std::uint32_t kParked = 0;
+    static constexpr std::uint32_t kWoken = 1;
+
+    /* without futex, notify_one() must not touch a dead record : the waiter leaves on kReleased */
+    static constexpr std::uint32_t kReleased = 2;
+
+    static constexpr unsigned kSpinCount = 128;
+
+    [[nodiscard]] bool woken() const noexcept;
+
+    /* sleeps while the word is kParked, at most timeout (nullptr : forever) */
+    void sleep(const clock::duration* timeout) noexcept;
+
+    std::atomic<std::uint32_t> state_{kParked};
+};
+
+using SyncWaitList = IntrusiveList<SyncWaiter, BaseHook<SyncWaitTag>>;
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief FIFO mutex : uncontended lock() / unlock() are one CAS each, under contention
+ * unlock() hands the mutex straight to the oldest waiter, which wakes up owning it.
+ *
+ *   state_ : [ has waiters | locked ]
+ *
+ *  >> lock()       : CAS 0 -> locked, else enqueue a SyncWaiter and park
+ *  >> unlock()     : CAS locked -> 0, else pop the front waiter and unpark it, still locked
+ *  >> try_lock_*() : a timed-out waiter takes itself out with IntrusiveList::remove()
+ *
+ * No barging : while anyone waits, try_lock() fails.
+ */
+class FifoMutex {
+  public:
+    using clock = SyncWaiter::clock;
+
+    FifoMutex() noexcept = default;
+
+    ~FifoMutex();
+
+    FifoMutex(const FifoMutex&) = delete;
+    FifoMutex& operator=(const FifoMutex&) = delete;
+
+    void lock() noexcept;
+
+    [[nodiscard]] bool try_lock() noexcept;
+
+    [[nodiscard]]
+    bool try_lock_until(clock::time_point deadline) noexcept;
+
+    template <typename Rep, typename Period>
+    [[nodiscard]]
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout) noexcept;
+
+    void unlock() noexcept;
+
+  private:
+    static constexpr std::uint32_t kLocked = 1;
+    static constexpr std::uint32_t kHasWaiters = 2;
+
+    /* nullptr deadline : wait forever */
+    bool lock_slow(const clock::time_point* deadline) noexcept;
+
+    void unlock_slow() noexcept;
+
+    std::atomic<std::uint32_t> state_{0};
+    SpinLock guard_;
+    SyncWaitList waiters_;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief FIFO condition variable : notify_one() wakes the longest waiter, notify_n(n)
+ * the n longest ones.
+ *
+ * notify_n() detaches its waiters with one extract_front() under the wait-list lock
+ * and unparks them after releasing it.
+ *
+ * Works with any lock the waiting thread holds (std::unique_lock<FifoMutex>, ...).
+ */
+class FifoCondVar {
+  public:
+    using size_type = std::size_t;
+    using clock = SyncWaiter::clock;
+
+    FifoCondVar() noexcept = default;
+
+    ~FifoCondVar();
+
+    FifoCondVar(const FifoCondVar&) = delete;
+    FifoCondVar& operator=(const FifoCondVar&) = delete;
+
+    template <typename Lock>
+    void wait(Lock& lock) noexcept;
+
+    template <typename Lock, typename Predicate>
+    void wait(Lock& lock, Predicate pred);
+
+    template <typename Lock>
+    auto wait_until(Lock& lock, clock::time_point deadline) noexcept -> std::cv_status;
+
+    template <typename Lock, typename Predicate>
+    bool wait_until(Lock& lock, clock::time_point deadline, Predicate pred);
+
+    template <typename Lock, typename Rep, typename Period>
+    auto wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& timeout) noexcept
+        -> std::cv_status;
+
+    template <typename Lock, typename Rep, typename Period, typename Predicate>
+    bool wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& timeout, Predicate pred);
+
+    void notify_one() noexcept;
+
+    /**
+     * @return Number of waiters woken.
+     */
+    auto notify_n(size_type n) noexcept -> size_type;
+
+    void notify_all() noexcept;
+
+  private:
+    void enqueue(SyncWaiter& waiter) noexcept;
+
+    /* after a timeout : true if a notify got there first */
+    bool cancel(SyncWaiter& waiter) noexcept;
+
+    static void unpark_all(SyncWaitList& woken) noexcept;
+
+    SpinLock guard_;
+    SyncWaitList waiters_;
+};
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+/**
+ * @brief FIFO counting semaphore : release(n) hands its permits to the n oldest
+ * waiters (one extract_front()) before anything goes back to the count.
+ */
+class FifoSemaphore {
+  public:
+    using size_type = std::size_t;
+    using clock = SyncWaiter::clock;
+
+    explicit FifoSemaphore(size_type permits = 0) noexcept;
+
+    ~FifoSemaphore();
+
+    FifoSemaphore(const FifoSemaphore&) = delete;
+    FifoSemaphore& operator=(const FifoSemaphore&) = delete;
+
+    void acquire() noexcept;
+
+    [[nodiscard]] bool try_acquire() noexcept;
+
+    [[nodiscard]]
+    bool try_acquire_until(clock::time_point deadline) noexcept;
+
+    template <typename Rep, typename Period>
+    [[nodiscard]]
+    bool try_acquire_for(const std::chrono::duration<Rep, Period>& timeout) noexcept;
+
+    void release(size_type n = 1) noexcept;
+
+    /**
+     * @brief Snapshot, may be stale by the time it returns.
+     */
+    [[nodiscard]]
+    auto available() noexcept -> size_type;
+
+  private:
+    /* nullptr deadline : wait forever */
+    bool acquire_slow(const clock::time_point* deadline) noexcept;
+
+    SpinLock guard_;
+    SyncWaitList waiters_;
+    size_type permits_;
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+inline void SpinLock::lock() noexcept {
+    for (;;) {
+        if (!locked_.exchange(true, std::memory_order_acquire)) {
+            return;
+        }
+
+        /* spin on a plain load : the line stays shared until the owner lets go */
+        while (locked_.load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+inline bool SpinLock::try_lock() noexcept {
+    return !locked_.load(std::memory_order_relaxed) &&
+           !locked_.exchange(true, std::memory_order_acquire);
+}
+
+inline void SpinLock::unlock() noexcept {
+    locked_.store(false, std::memory_order_release);
+}
+
+/*---*---*---*---*---*---*---* SyncWaiter *---*---*---*---*---*---*---*/
+
+inline bool SyncWaiter::woken() const noexcept {
+#if defined(__linux__)
+    return state_.load(std::memory_order_acquire) != kParked;
+#else
+    return state_.load(std::memory_order_acquire) == kReleased;
+#endif
+}
+
+inline void SyncWaiter::sleep(const clock::duration* timeout) noexcept {
+#if defined(__linux__)
+    static_assert(sizeof(state_) == sizeof(std::uint32_t), "futex word must be 32 bits");
+
+    timespec ts{};
+    timespec* rel = nullptr;
+
+    if (timeout != nullptr) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(*timeout).count();
+
+        ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+        ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+        rel = &ts;
+    }
+
+    /* EAGAIN (already woken), EINTR, ETIMEDOUT : the caller re-checks */
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), FUTEX_WAIT_PRIVATE, kParked,
+            rel, nullptr, 0);
+#else
+    if (timeout == nullptr) {
+        state_.wait(kParked, std::memory_order_acquire);
+    } else {
+        /* std::atomic::wait has no timeout : nap in short slices */
+        std::this_thread::sleep_for(std::min<clock::duration>(*timeout, std::chrono::microseconds(100)));
+    }
+#endif
+}
+
+inline void SyncWaiter::park() noexcept {
+    for (unsigned i = 0; i < kSpinCount; ++i) {
+        if (woken()) {
+            return;
+        }
+    }
+
+    while (!woken()) {
+        if (state_.load(std::memory_order_acquire) == kParked) {
+            sleep(nullptr);
+        }
+    }
+}
+
+inline bool SyncWaiter::park_until(clock::time_point deadline) noexcept {
+    while (!woken()) {
+        if (state_.load(std::memory_order_acquire) != kParked) {
+            continue; /* waker between its store and its release */
+        }
+
+        const auto now = clock::now();
+
+        if (now >= deadline) {
+            return false;
+        }
+
+        const clock::duration left = deadline - now;
+        sleep(&left);
+    }
+
+    return true;
+}
+
+inline void SyncWaiter::unpark() noexcept {
+    assert(!is_linked() && "unpark() : unlink the waiter first...");
+
+#if defined(__linux__)
+    /* the record may die right after the store : the futex call only uses its address */
+    std::uint32_t* word = reinterpret_cast<std::uint32_t*>(&state_);
+
+    state_.store(kWoken, std::memory_order_release);
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    state_.store(kWoken, std::memory_order_release);
+    state_.notify_one();
+    state_.store(kReleased, std::memory_order_release);
+#endif
+}
+
+/*---*---*---*---*---*---*---* FifoMutex *---*---*---*---*---*---*---*/
+
+inline FifoMutex::~FifoMutex() {
+    assert(waiters_.empty() && "destroying FifoMutex with waiting threads...");
+}
+
+inline void FifoMutex::lock() noexcept {
+    std::uint32_t expected = 0;
+
+    if (state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return;
+    }
+
+    lock_slow(nullptr);
+}
+
+inline bool FifoMutex::try_lock() noexcept {
+    std::uint32_t expected = 0;
+
+    return state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+}
+
+inline bool FifoMutex::try_lock_until(clock::time_point deadline) noexcept {
+    return try_lock() || lock_slow(&deadline);
+}
+
+template <typename Rep, typename Period>
+bool FifoMutex::try_lock_for(const std::chrono::duration<Rep, Period>& timeout) noexcept {
+    return try_lock_until(clock::now() + std::chrono::duration_cast<clock::duration>(timeout));
+}
+
+inline bool FifoMutex::lock_slow(const clock::time_point* deadline) noexcept {
+    SyncWaiter waiter;
+
+    {
+        std::lock_guard guard(guard_);
+
+        std::uint32_t state = state_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            if ((state & kLocked) == 0) {
+                if (state_.compare_exchange_weak(state, state | kLocked, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    return true;
+                }
+
+                continue;
+            }
+
+            /* from now on unlock() cannot take its fast path, it comes for the list */
+            if (state_.compare_exchange_weak(state, state | kHasWaiters, std::memory_order_relaxed,
+                                             std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        waiters_.push_back(waiter);
+    }
+
+    if (deadline == nullptr) {
+        waiter.park();
+        return true;
+    }
+
+    if (waiter.park_until(*deadline)) {
+        return true;
+    }
+
+    {
+        std::lock_guard guard(guard_);
+
+        if (waiter.is_linked()) {
+            SyncWaitList::remove(waiter);
+
+            if (waiters_.empty()) {
+                state_.fetch_and(~kHasWaiters, std::memory_order_relaxed);
+            }
+
+            return false;
+        }
+    }
+
+    /* unlock() popped us in the meantime : the mutex is ours, wait for the handoff */
+    waiter.park();
+
+    return true;
+}
+
+inline void FifoMutex::unlock() noexcept {
+    std::uint32_t expected = kLocked;
+
+    if (state_.compare_exchange_strong(expected, 0, std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+        return;
+    }
+
+    unlock_slow();
+}
+
+inline void FifoMutex::unlock_slow() noexcept {
+    SyncWaiter* next = nullptr;
+
+    {
+        std::lock_guard guard(guard_);
+
+        next = waiters_.try_pop_front();
+
+        if (next == nullptr) {
+            /* the last waiter timed out after our fast path failed */
+            state_.store(0, std::memory_order_release);
+        } else if (waiters_.empty()) {
+            /* handoff : stays locked, for next */
+            state_.store(kLocked, std::memory_order_relaxed);
+        }
+    }
+
+    if (next != nullptr) {
+        next->unpark();
+    }
+}
+
+/*---*---*---*---*---*---*---* FifoCondVar *---*---*---*---*---*---*---*/
+
+inline FifoCondVar::~FifoCondVar() {
+    assert(waiters_.empty() && "destroying FifoCondVar with waiting threads...");
+}
+
+inline void FifoCondVar::enqueue(SyncWaiter& waiter) noexcept {
+    std::lock_guard guard(guard_);
+    waiters_.push_back(waiter);
+}
+
+inline bool FifoCondVar::cancel(SyncWaiter& waiter) noexcept {
+    {
+        std::lock_guard guard(guard_);
+
+        if (waiter.is_linked()) {
+            SyncWaitList::remove(waiter);
+            return false;
+        }
+    }
+
+    /* a notify detached us already : let it finish with the record */
+    waiter.park();
+
+    return true;
+}
+
+template <typename Lock>
+void FifoCondVar::wait(Lock& lock) noexcept {
+    SyncWaiter waiter;
+
+    /* linked BEFORE the user lock is released : a notify after unlock() cannot miss us */
+    enqueue(waiter);
+
+    lock.unlock();
+    waiter.park();
+    lock.lock();
+}
+
+template <typename Lock, typename Predicate>
+void FifoCondVar::wait(Lock& lock, Predicate pred) {
+    while (!pred()) {
+        wait(lock);
+    }
+}
+
+template <typename Lock>
+auto FifoCondVar::wait_until(Lock& lock, clock::time_point deadline) noexcept -> std::cv_status {
+    SyncWaiter waiter;
+
+    enqueue(waiter);
+
+    lock.unlock();
+
+    const bool notified = waiter.park_until(deadline) || cancel(waiter);
+
+    lock.lock();
+
+    return notified ? std::cv_status::no_timeout : std::cv_status::timeout;
+}
+
+template <typename Lock, typename Predicate>
+bool FifoCondVar::wait_until(Lock& lock, clock::time_point deadline, Predicate pred) {
+    while (!pred()) {
+        if (wait_until(lock, deadline) == std::cv_status::timeout) {
+            return pred();
+        }
+    }
+
+    return true;
+}
+
+template <typename Lock, typename Rep, typename Period>
+auto FifoCondVar::wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& timeout) noexcept
+    -> std::cv_status {
+    return wait_until(lock, clock::now() + std::chrono::duration_cast<clock::duration>(timeout));
+}
+
+template <typename Lock, typename Rep, typename Period, typename Predicate>
+bool FifoCondVar::wait_for(Lock& lock, const std::chrono::duration<Rep, Period>& timeout,
+                           Predicate pred) {
+    return wait_until(lock, clock::now() + std::chrono::duration_cast<clock::duration>(timeout),
+                      pred);
+}
+
+inline void FifoCondVar::unpark_all(SyncWaitList& woken) noexcept {
+    /* unlink first : the thread may return (and its record die) as soon as it is unparked */
+    while (SyncWaiter* waiter = woken.try_pop_front()) {
+        waiter->unpark();
+    }
+}
+
+inline void FifoCondVar::notify_one() noexcept {
+    notify_n(1);
+}
+
+inline auto FifoCondVar::notify_n(size_type n) noexcept -> size_type {
+    SyncWaitList woken;
+    size_type cnt = 0;
+
+    {
+        std::lock_guard guard(guard_);
+        cnt = waiters_.extract_front(woken, n);
+    }
+
+    unpark_all(woken);
+
+    return cnt;
+}
+
+inline void FifoCondVar::notify_all() noexcept {
+    SyncWaitList woken;
+
+    {
+        std::lock_guard guard(guard_);
+        woken.splice(woken.cend(), waiters_);
+    }
+
+    unpark_all(woken);
+}
+
+/*---*---*---*---*---*---*---* FifoSemaphore *---*---*---*---*---*---*---*/
+
+inline FifoSemaphore::FifoSemaphore(size_type permits) noexcept : permits_(permits) {}
+
+inline FifoSemaphore::~FifoSemaphore() {
+    assert(waiters_.empty() && "destroying FifoSemaphore with waiting threads...");
+}
+
+inline void FifoSemaphore::acquire() noexcept {
+    acquire_slow(nullptr);
+}
+
+inline bool FifoSemaphore::try_acquire() noexcept {
+    std::lock_guard guard(guard_);
+
+    if (permits_ == 0) {
+        return false;
+    }
+
+    --permits_;
+
+    return true;
+}
+
+inline bool FifoSemaphore::try_acquire_until(clock::time_point deadline) noexcept {
+    return acquire_slow(&deadline);
+}
+
+template <typename Rep, typename Period>
+bool FifoSemaphore::try_acquire_for(const std::chrono::duration<Rep, Period>& timeout) noexcept {
+    return try_acquire_until(clock::now() + std::chrono::duration_cast<clock::duration>(timeout));
+}
+
+inline bool FifoSemaphore::acquire_slow(const clock::time_point* deadline) noexcept {
+    SyncWaiter waiter;
+
+    {
+        std::lock_guard guard(guard_);
+
+        /* permits_ > 0 implies nobody waits : release() serves the list first */
+        if (permits_ > 0) {
+            --permits_;
+            return true;
+        }
+
+        waiters_.push_back(waiter);
+    }
+
+    if (deadline == nullptr) {
+        waiter.park();
+        return true;
+    }
+
+    if (waiter.park_until(*deadline)) {
+        return true;
+    }
+
+    {
+        std::lock_guard guard(guard_);
+
+        if (waiter.is_linked()) {
+            SyncWaitList::remove(waiter);
+            return false;
+        }
+    }
+
+    /* release() handed us a permit in the meantime */
+    waiter.park();
+
+    return true;
+}
+
+inline void FifoSemaphore::release(size_type n) noexcept {
+    SyncWaitList woken;
+
+    {
+        std::lock_guard guard(guard_);
+
+        const size_type served = waiters_.extract_front(woken, n);
+        permits_ += n - served;
+    }
+
+    while (SyncWaiter* waiter = woken.try_pop_front()) {
+        waiter->unpark();
+    }
+}
+
+inline auto FifoSemaphore::available() noexcept -> size_type {
+    std::lock_guard guard(guard_);
+    return permits_;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
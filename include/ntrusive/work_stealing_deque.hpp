@@ -0,0 +1,299 @@
+#pragma once
+
+#include "config.hpp"
+#include "list.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Chase-Lev work-stealing deque of hook-carrying tasks.
+ *
+ * One owner thread works the bottom end LIFO without any RMW, any number of thieves
+ * take from the top end FIFO, one CAS on top_ per stolen task :
+ *
+ *            thieves                                  owner
+ *   steal() / steal_batch() --> [ top ... ... ... bottom ) <-- push() / pop()
+ *
+ *  >> push()        : owner only, wait-free, false when full (spill to an IntrusiveList)
+ *  >> pop()         : owner only, wait-free, a CAS only for the very last task
+ *  >> steal()       : any thread, lock-free
+ *  >> steal_batch() : any thread, up to half of the tasks moved into an IntrusiveList
+ *
+ * The ring is a fixed array of Capacity pointers inside the deque : it never grows,
+ * never allocates, and a slot is only reused once top_ has moved past it, so the
+ * classic buffer-reclamation problem of Chase-Lev does not arise. The hook of T is
+ * untouched while a task sits in the ring, it is what steal_batch() and the
+ * caller's overflow list chain through.
+ *
+ * Memory orders follow Le, Pop, Cohen, Zappa Nardelli, "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * @tparam Capacity Ring size, a power of two.
+ * @tparam Options  Same as IntrusiveList, for the lists steal_batch() fills.
+ *
+ * >> USAGE :
+ *  // owner
+ *  if (!deque.push(task)) {
+ *    overflow.push_back(task);
+ *  }
+ *  while (Task* t = deque.pop()) { ... }
+ *
+ *  // thief
+ *  IntrusiveList<Task> loot;
+ *  victim.steal_batch(loot, 32);
+ */
+template <typename T, std::size_t Capacity = 1024, typename... Options>
+class IntrusiveWorkStealingDeque {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using size_type = std::size_t;
+
+    using list_type = IntrusiveList<T, Options...>;
+
+    static constexpr size_type kCapacity = Capacity;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    IntrusiveWorkStealingDeque() noexcept = default;
+
+    ~IntrusiveWorkStealingDeque();
+
+    IntrusiveWorkStealingDeque(const IntrusiveWorkStealingDeque&) = delete;
+    IntrusiveWorkStealingDeque& operator=(const IntrusiveWorkStealingDeque&) = delete;
+
+    IntrusiveWorkStealingDeque(IntrusiveWorkStealingDeque&&) = delete;
+    IntrusiveWorkStealingDeque& operator=(IntrusiveWorkStealingDeque&&) = delete;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  public:
+    /**
+     * @brief OWNER : pushes element at the bottom.
+     *
+     * @return false (nothing pushed) when the ring is full.
+     */
+    [[nodiscard]]
+    bool push(reference element) noexcept;
+
+    /**
+     * @brief OWNER : pushes elements from the front of in until in is empty or the ring is full.
+     *
+     * @return Number of elements moved.
+     */
+    auto push_from(list_type& in) noexcept -> size_type;
+
+    /**
+     * @brief OWNER : pops the most recently pushed element, nullptr when empty.
+     */
+    [[nodiscard]]
+    auto pop() noexcept -> pointer;
+
+    /**
+     * @brief THIEF : takes the oldest element.
+     *
+     * @return nullptr when empty OR when another thread won the race for it.
+     */
+    [[nodiscard]]
+    auto steal() noexcept -> pointer;
+
+    /**
+     * @brief THIEF : appends up to min(max_cnt, half of the deque, rounded up) of the
+     * oldest elements to out, oldest first.
+     *
+     * Every element is claimed with its own CAS on top_ : claiming a whole range with
+     * one CAS would race with the owner popping into that range without a CAS.
+     *
+     * @return Number of elements stolen.
+     */
+    auto steal_batch(list_type& out, size_type max_cnt) noexcept -> size_type;
+
+    /**
+     * @brief Snapshot, may be stale by the time it returns.
+     */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type;
+
+    [[nodiscard]] bool empty() const noexcept;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    static constexpr size_type kMask = Capacity - 1;
+
+    /* a thief losing its CAS gets kLost, not nullptr, so steal_batch() knows to retry */
+    enum class StealResult { kTaken, kEmpty, kLost };
+
+    auto try_steal(pointer& out) noexcept -> StealResult;
+
+    /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+  private:
+    /* thieves' end */
+    alignas(kCacheLineSize) std::atomic<std::int64_t> top_{0};
+
+    /* owner's end */
+    alignas(kCacheLineSize) std::atomic<std::int64_t> bottom_{0};
+
+    alignas(kCacheLineSize) std::array<std::atomic<pointer>, Capacity> ring_{};
+};
+
+/*---*---*---*---*---*---*---*---* IMPL *---*---*---*---*---*---*---*---*---*/
+
+template <typename T, std::size_t Capacity, typename... Options>
+IntrusiveWorkStealingDeque<T, Capacity, Options...>::~IntrusiveWorkStealingDeque() {
+    assert(empty() && "destroying non-empty IntrusiveWorkStealingDeque...");
+}
+
+template <typename T, std::size_t Capacity, typename... Options>
+auto IntrusiveWorkStealingDeque<T, Capacity, Options...>::size() const noexcept -> size_type {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t t = top_.load(std::memory_order_relaxed);
+
+    return (b > t) ? static_cast<size_type>(b - t) : 0;
+}
+
+template <typename T, std::size_t Capacity, typename... Options>
+bool IntrusiveWorkStealingDeque<T, Capacity, Options...>::empty() const noexcept {
+    return size() == 0;
+}
+
+/*---*---*---*---*---*---*---* Owner *---*---*---*---*---*---*---*/
+
+template <typename T, std::size_t Capacity, typename... Options>
+bool IntrusiveWorkStealingDeque<T, Capacity, Options...>::push(reference element) noexcept {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t t = top_.load(std::memory_order_acquire);
+
+    /* slot b & kMask is free only once top_ has moved past b - Capacity */
+    if (b - t >= static_cast<std::int64_t>(Capacity)) {
+        return false;
+    }
+
+    ring_[static_cast<size_type>(b) & kMask].store(&element, std::memory_order_relaxed);
+
+    /* publish the slot (and the task's fields) with the new bottom */
+    bottom_.store(b + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T, std::size_t Capacity, typename... Options>
+auto IntrusiveWorkStealingDeque<T, Capacity, Options...>::push_from(list_type& in) noexcept
+    -> size_type {
+    size_type cnt = 0;
+
+    /* unlink BEFORE publishing : a thief may relink the element the moment it is in the ring */
+    while (pointer element = in.try_pop_front()) {
+        if (!push(*element)) {
+            in.push_front(*element);
+            break;
+        }
+
+        ++cnt;
+    }
+
+    return cnt;
+}
+
+template <typename T, std::size_t Capacity, typename... Options>
+auto IntrusiveWorkStealingDeque<T, Capacity, Options...>::pop() noexcept -> pointer {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+
+    /* reserve slot b first, then look at top_ : a thief does the opposite */
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        /* empty : undo the reservation */
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    pointer element = ring_[static_cast<size_type>(b) & kMask].load(std::memory_order_relaxed);
+
+    if (t == b) {
+        /* last one : race the thieves for it */
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            element = nullptr;
+        }
+
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return element;
+}
+
+/*---*---*---*---*---*---*---* Thieves *---*---*---*---*---*---*---*/
+
+template <typename T, std::size_t Capacity, typename... Options>
+auto IntrusiveWorkStealingDeque<T, Capacity, Options...>::try_steal(pointer& out) noexcept
+    -> StealResult {
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return StealResult::kEmpty;
+    }
+
+    /* read before claiming : once top_ moves, the owner may reuse the slot */
+    pointer element = ring_[static_cast<size_type>(t) & kMask].load(std::memory_order_relaxed);
+
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return StealResult::kLost;
+    }
+
+    out = element;
+
+    return StealResult::kTaken;
+}
+
+template <typename T, std::size_t Capacity, typename... Options>
+auto IntrusiveWorkStealingDeque<T, Capacity, Options...>::steal() noexcept -> pointer {
+    pointer element = nullptr;
+
+    return (try_steal(element) == StealResult::kTaken) ? element : nullptr;
+}
+
+template <typename T, std::size_t Capacity, typename... Options>
+auto IntrusiveWorkStealingDeque<T, Capacity, Options...>::steal_batch(list_type& out,
+                                                                      size_type max_cnt) noexcept
+    -> size_type {
+    /* leave the owner at least half of its work */
+    const size_type target = std::min(max_cnt, (size() + 1) / 2);
+
+    size_type cnt = 0;
+
+    while (cnt < target) {
+        pointer element = nullptr;
+
+        const StealResult result = try_steal(element);
+
+        if (result == StealResult::kEmpty) {
+            break;
+        }
+
+        if (result == StealResult::kTaken) {
+            out.push_back(*element);
+            ++cnt;
+        }
+    }
+
+    return cnt;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
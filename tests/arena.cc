@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <ntrusive/arena.hpp>
+#include <ntrusive/intrusive.hpp>
+#include <cstddef>
+#include <cstdint>
+
+struct ArenaNode : IntrusiveListNode<DefaultTag, NormalLink> {
+    int value{0};
+
+    explicit ArenaNode(int v) noexcept : value(v) {}
+};
+
+struct ArenaTagA {};
+struct ArenaTagB {};
+
+/* one node, two arena lists */
+struct ArenaPair : IntrusiveListNode<ArenaTagA, NormalLink>, IntrusiveListNode<ArenaTagB, NormalLink> {
+    int value{0};
+
+    explicit ArenaPair(int v) noexcept : value(v) {}
+};
+
+struct alignas(64) ArenaWide {
+    std::byte bytes[64];
+};
+
+TEST(ArenaTest, BumpAllocationIsAligned) {
+    Arena arena(256);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    ArenaWide* w = arena.create<ArenaWide>();
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 8, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(w) % 64, 0u);
+    EXPECT_TRUE(arena.owns(a));
+    EXPECT_TRUE(arena.owns(w));
+
+    int outside = 0;
+    EXPECT_FALSE(arena.owns(&outside));
+}
+
+TEST(ArenaTest, ChainsChunksAndReusesThemAfterReset) {
+    Arena arena(128);
+
+    for (int i = 0; i < 100; ++i) {
+        (void)arena.allocate(16, 8);
+    }
+
+    const std::size_t chunks = arena.chunk_count();
+    EXPECT_GT(chunks, 1u);
+    EXPECT_GE(arena.used(), 1600u);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+
+    for (int i = 0; i < 100; ++i) {
+        (void)arena.allocate(16, 8);
+    }
+
+    /* same work, no new chunk */
+    EXPECT_EQ(arena.chunk_count(), chunks);
+
+    /* bigger than a chunk : gets its own */
+    void* big = arena.allocate(1000, 8);
+    EXPECT_TRUE(arena.owns(big));
+    EXPECT_EQ(arena.chunk_count(), chunks + 1);
+
+    arena.release();
+    EXPECT_EQ(arena.chunk_count(), 0u);
+}
+
+TEST(ArenaTest, ListTeardownLeavesNodesAlone) {
+    Arena arena;
+
+    {
+        ArenaList<ArenaNode> list(arena);
+
+        for (int i = 0; i < 1000; ++i) {
+            list.emplace_back(i);
+        }
+
+        int expected = 0;
+
+        for (const ArenaNode& node : list) {
+            EXPECT_EQ(node.value, expected++);
+        }
+
+        list.clear();
+        EXPECT_TRUE(list.empty());
+
+        list.push_back(*arena.create<ArenaNode>(7));
+        EXPECT_EQ(list.front().value, 7);
+    }
+
+    arena.reset();
+}
+
+TEST(ArenaTest, SeveralListsOverTheSameNodes) {
+    Arena arena;
+
+    {
+        ArenaList<ArenaPair, BaseHook<ArenaTagA>> all(arena);
+        ArenaList<ArenaPair, BaseHook<ArenaTagB>, CountingPolicy> odd(arena);
+
+        for (int i = 0; i < 10; ++i) {
+            ArenaPair* pair = arena.create<ArenaPair>(i);
+            all.push_back(*pair);
+
+            if (i % 2 == 1) {
+                odd.push_front(*pair);
+            }
+        }
+
+        EXPECT_EQ(odd.size(), 5u);
+        EXPECT_EQ(odd.front().value, 9);
+        EXPECT_EQ(all.back().value, 9);
+    }
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST(ArenaTest, RangeInsertsGoThroughTheArenaCheck) {
+    Arena arena;
+
+    {
+        ArenaList<ArenaNode> list(arena);
+        ArenaNode* nodes[4];
+
+        for (int i = 0; i < 4; ++i) {
+            nodes[i] = arena.create<ArenaNode>(i);
+        }
+
+        list.push_back_range(nodes + 2, nodes + 4);
+
+        auto it = list.insert_range(list.cbegin(), nodes, nodes + 2);
+        EXPECT_EQ(it->value, 0);
+
+        list.insert(list.cend(), *arena.create<ArenaNode>(4));
+
+        int expected = 0;
+
+        for (const ArenaNode& node : list) {
+            EXPECT_EQ(node.value, expected++);
+        }
+
+        EXPECT_EQ(expected, 5);
+    }
+
+    arena.reset();
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <ntrusive/coro_scheduler.hpp>
+#include <ntrusive/intrusive.hpp>
+#include <cstddef>
+#include <vector>
+
+/* appends id, yields, appends id + 100 */
+CoroTask coro_yielder(CoroScheduler& sched, std::vector<int>& log, int id) {
+    log.push_back(id);
+    co_await sched.yield();
+    log.push_back(id + 100);
+}
+
+/* locks, yields while holding the lock, unlocks */
+CoroTask coro_locker(CoroScheduler& sched, AsyncMutex& mutex, std::vector<int>& log, int id) {
+    const bool locked = co_await mutex.lock();
+
+    if (!locked) {
+        log.push_back(-id);
+        co_return;
+    }
+
+    log.push_back(id);
+    co_await sched.yield();
+    log.push_back(id + 100);
+
+    mutex.unlock();
+}
+
+/* exposes its awaiter so the test can cancel it */
+CoroTask coro_cancellable(AsyncEvent& event, CoroAwaiter*& slot, std::vector<int>& log, int id) {
+    auto awaiter = event.wait();
+    slot = &awaiter;
+
+    log.push_back(co_await awaiter ? id : -id);
+}
+
+CoroTask coro_cancellable_lock(AsyncMutex& mutex, CoroAwaiter*& slot, std::vector<int>& log,
+                               int id) {
+    auto awaiter = mutex.lock();
+    slot = &awaiter;
+
+    if (!co_await awaiter) {
+        log.push_back(-id);
+        co_return;
+    }
+
+    log.push_back(id);
+    mutex.unlock();
+}
+
+CoroTask coro_waiter(AsyncEvent& event, std::vector<int>& log, int id) {
+    co_await event.wait();
+    log.push_back(id);
+}
+
+CoroTask coro_permit(CoroScheduler& sched, AsyncSemaphore& sem, int& inside, int& peak) {
+    co_await sem.acquire();
+
+    ++inside;
+    peak = (inside > peak) ? inside : peak;
+    co_await sched.yield();
+    --inside;
+
+    sem.release();
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(CoroSchedulerTest, YieldRoundRobins) {
+    CoroScheduler sched;
+    std::vector<int> log;
+
+    for (int id = 1; id <= 3; ++id) {
+        sched.spawn(coro_yielder(sched, log, id));
+    }
+
+    /* 3 starts + 3 resumptions after yield */
+    EXPECT_EQ(sched.run(), 6u);
+    EXPECT_TRUE(sched.empty());
+    EXPECT_EQ(log, (std::vector<int>{1, 2, 3, 101, 102, 103}));
+}
+
+TEST(CoroSchedulerTest, UnspawnedTaskIsDestroyed) {
+    CoroScheduler sched;
+    std::vector<int> log;
+
+    {
+        CoroTask task = coro_yielder(sched, log, 1);
+    }
+
+    EXPECT_TRUE(log.empty());
+    EXPECT_FALSE(sched.run_one());
+}
+
+TEST(CoroSchedulerTest, MutexHandsOffInFifoOrder) {
+    CoroScheduler sched;
+    AsyncMutex mutex(sched);
+    std::vector<int> log;
+
+    for (int id = 1; id <= 3; ++id) {
+        sched.spawn(coro_locker(sched, mutex, log, id));
+    }
+
+    sched.run();
+
+    /* every critical section runs alone, in arrival order */
+    EXPECT_EQ(log, (std::vector<int>{1, 101, 2, 102, 3, 103}));
+    EXPECT_FALSE(mutex.locked());
+}
+
+TEST(CoroSchedulerTest, EventWakesEveryWaiter) {
+    CoroScheduler sched;
+    AsyncEvent event(sched);
+    std::vector<int> log;
+
+    for (int id = 1; id <= 4; ++id) {
+        sched.spawn(coro_waiter(event, log, id));
+    }
+
+    sched.run();
+    EXPECT_TRUE(log.empty());
+
+    event.set();
+    sched.run();
+    EXPECT_EQ(log, (std::vector<int>{1, 2, 3, 4}));
+
+    /* already set : no suspension */
+    sched.spawn(coro_waiter(event, log, 5));
+    EXPECT_EQ(sched.run(), 1u);
+    EXPECT_EQ(log.back(), 5);
+}
+
+TEST(CoroSchedulerTest, CancelRemovesFromWaitList) {
+    CoroScheduler sched;
+    AsyncEvent event(sched);
+    std::vector<int> log;
+    CoroAwaiter* first = nullptr;
+    CoroAwaiter* second = nullptr;
+
+    sched.spawn(coro_cancellable(event, first, log, 1));
+    sched.spawn(coro_cancellable(event, second, log, 2));
+    sched.run();
+
+    ASSERT_NE(first, nullptr);
+    EXPECT_TRUE(first->waiting());
+
+    EXPECT_TRUE(sched.cancel(*first));
+    sched.run();
+    EXPECT_EQ(log, (std::vector<int>{-1}));
+
+    /* the other waiter is untouched */
+    EXPECT_TRUE(second->waiting());
+    event.set();
+    sched.run();
+
+    EXPECT_EQ(log, (std::vector<int>{-1, 2}));
+}
+
+TEST(CoroSchedulerTest, CancelAfterWakeIsNoop) {
+    CoroScheduler sched;
+    AsyncEvent event(sched);
+    std::vector<int> log;
+    CoroAwaiter* awaiter = nullptr;
+
+    sched.spawn(coro_cancellable(event, awaiter, log, 7));
+    sched.run();
+
+    event.set();
+
+    /* queued to run, no longer waiting */
+    EXPECT_FALSE(sched.cancel(*awaiter));
+    sched.run();
+
+    EXPECT_EQ(log, (std::vector<int>{7}));
+}
+
+TEST(CoroSchedulerTest, CancelledLockWaiterDoesNotGetTheLock) {
+    CoroScheduler sched;
+    AsyncMutex mutex(sched);
+    std::vector<int> log;
+
+    ASSERT_TRUE(mutex.try_lock());
+
+    CoroAwaiter* slot = nullptr;
+
+    sched.spawn(coro_cancellable_lock(mutex, slot, log, 1));
+    sched.spawn(coro_locker(sched, mutex, log, 2));
+    sched.run();
+
+    ASSERT_NE(slot, nullptr);
+    EXPECT_TRUE(sched.cancel(*slot));
+
+    mutex.unlock();
+    sched.run();
+
+    /* the lock skipped the cancelled waiter */
+    EXPECT_EQ(log, (std::vector<int>{-1, 2, 102}));
+    EXPECT_FALSE(mutex.locked());
+}
+
+TEST(CoroSchedulerTest, SemaphoreBoundsConcurrency) {
+    CoroScheduler sched;
+    AsyncSemaphore sem(sched, 2);
+    int inside = 0;
+    int peak = 0;
+
+    for (int i = 0; i < 10; ++i) {
+        sched.spawn(coro_permit(sched, sem, inside, peak));
+    }
+
+    sched.run();
+
+    EXPECT_EQ(peak, 2);
+    EXPECT_EQ(inside, 0);
+    EXPECT_EQ(sem.available(), 2u);
+}
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include <ntrusive/hash_set.hpp>
+#include <ntrusive/intrusive.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct Entry : IntrusiveListNode<DefaultTag, SafeLink> {
+    std::uint64_t id{0};
+
+    Entry() = default;
+    explicit Entry(std::uint64_t i) : id(i) {}
+};
+
+struct EntryHash {
+    std::size_t operator()(std::uint64_t id) const noexcept { return std::hash<std::uint64_t>{}(id); }
+    std::size_t operator()(const Entry& e) const noexcept { return (*this)(e.id); }
+};
+
+struct EntryEq {
+    bool operator()(std::uint64_t id, const Entry& e) const noexcept { return id == e.id; }
+    bool operator()(const Entry& a, const Entry& b) const noexcept { return a.id == b.id; }
+};
+
+using EntrySet = IntrusiveHashSet<Entry, EntryHash, EntryEq>;
+using CountedEntrySet = IntrusiveHashSet<Entry, EntryHash, EntryEq, CountingPolicy>;
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(HashSetTest, EmptySet) {
+    EntrySet::bucket_type buckets[16];
+    EntrySet set(buckets);
+
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.size(), 0u);
+    EXPECT_EQ(set.bucket_count(), 16u);
+    EXPECT_EQ(set.find(std::uint64_t{1}), nullptr);
+}
+
+TEST(HashSetTest, InsertFindErase) {
+    EntrySet::bucket_type buckets[8];
+    EntrySet set(buckets);
+
+    Entry a{1}, b{2}, c{3};
+
+    EXPECT_TRUE(set.insert(a));
+    EXPECT_TRUE(set.insert(b));
+    EXPECT_TRUE(set.insert(c));
+
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_EQ(set.find(std::uint64_t{2}), &b);
+    EXPECT_TRUE(set.contains(c));
+    EXPECT_FALSE(set.contains(std::uint64_t{4}));
+
+    set.erase(b);
+    EXPECT_FALSE(b.is_linked());
+    EXPECT_EQ(set.find(std::uint64_t{2}), nullptr);
+    EXPECT_EQ(set.size(), 2u);
+
+    set.clear();
+    EXPECT_FALSE(a.is_linked());
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(HashSetTest, RefusesDuplicates) {
+    CountedEntrySet::bucket_type buckets[4];
+    CountedEntrySet set(buckets);
+
+    Entry a{7}, twin{7};
+
+    EXPECT_TRUE(set.insert(a));
+    EXPECT_FALSE(set.insert(twin));
+    EXPECT_FALSE(twin.is_linked());
+    EXPECT_EQ(set.size(), 1u);
+
+    set.clear();
+}
+
+TEST(HashSetTest, StaticRemove) {
+    EntrySet::bucket_type buckets[4];
+    EntrySet set(buckets);
+
+    Entry a{1}, b{2};
+
+    set.insert(a);
+    set.insert(b);
+
+    EntrySet::remove(a);
+
+    EXPECT_FALSE(a.is_linked());
+    EXPECT_EQ(set.find(std::uint64_t{1}), nullptr);
+    EXPECT_EQ(set.find(std::uint64_t{2}), &b);
+
+    set.clear();
+}
+
+TEST(HashSetTest, SingleBucket) {
+    EntrySet::bucket_type bucket[1];
+    EntrySet set(bucket);
+
+    Entry e[5];
+
+    for (std::uint64_t i = 0; i < 5; ++i) {
+        e[i].id = i;
+        EXPECT_TRUE(set.insert(e[i]));
+    }
+
+    for (std::uint64_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(set.find(i), &e[i]);
+    }
+
+    set.clear();
+}
+
+TEST(HashSetTest, ManyEntries) {
+    constexpr std::size_t kCount = 10'000;
+
+    std::vector<CountedEntrySet::bucket_type> buckets(4096);
+    CountedEntrySet set(buckets);
+
+    auto entries = std::make_unique<Entry[]>(kCount);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        entries[i].id = i * 3;
+        ASSERT_TRUE(set.insert(entries[i]));
+    }
+
+    EXPECT_EQ(set.size(), kCount);
+
+    for (std::size_t i = 0; i < kCount; i += 2) {
+        set.erase(entries[i]);
+    }
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(set.contains(std::uint64_t{i * 3}), i % 2 == 1);
+    }
+
+    EXPECT_EQ(set.size(), kCount / 2);
+
+    set.clear();
+}
+
+TEST(HashSetTest, RehashIsIncremental) {
+    CountedEntrySet::bucket_type small[4];
+    CountedEntrySet::bucket_type large[64];
+
+    Entry e[32];
+    CountedEntrySet set(small);
+
+    for (std::uint64_t i = 0; i < 32; ++i) {
+        e[i].id = i;
+        set.insert(e[i]);
+    }
+
+    set.rehash(large);
+
+    EXPECT_TRUE(set.rehashing());
+    EXPECT_EQ(set.bucket_count(), 64u);
+
+    /* every element stays reachable wherever it currently is */
+    for (std::uint64_t i = 0; i < 32; ++i) {
+        EXPECT_EQ(set.find(i), &e[i]);
+    }
+
+    /* one step per bucket : nothing is moved ahead of time */
+    EXPECT_TRUE(set.rehash_step(1));
+    EXPECT_TRUE(set.rehash_step(2));
+    EXPECT_FALSE(set.rehash_step(1));
+    EXPECT_FALSE(set.rehashing());
+
+    for (auto& bucket : small) {
+        EXPECT_TRUE(bucket.empty());
+    }
+
+    for (std::uint64_t i = 0; i < 32; ++i) {
+        EXPECT_EQ(set.find(i), &e[i]);
+    }
+
+    EXPECT_EQ(set.size(), 32u);
+
+    set.clear();
+}
+
+TEST(HashSetTest, OperationsDuringRehash) {
+    EntrySet::bucket_type small[8];
+    EntrySet::bucket_type large[32];
+
+    Entry e[40];
+    EntrySet set(small);
+
+    for (std::uint64_t i = 0; i < 20; ++i) {
+        e[i].id = i;
+        set.insert(e[i]);
+    }
+
+    set.rehash(large);
+
+    /* inserts advance the migration and still refuse duplicates */
+    Entry twin{3};
+    EXPECT_FALSE(set.insert(twin));
+
+    for (std::uint64_t i = 20; i < 30; ++i) {
+        e[i].id = i;
+        EXPECT_TRUE(set.insert(e[i]));
+    }
+
+    EXPECT_FALSE(set.rehashing());
+
+    set.erase(e[5]);
+    EntrySet::remove(e[6]);
+
+    EXPECT_EQ(set.size(), 28u);
+    EXPECT_FALSE(set.contains(std::uint64_t{5}));
+    EXPECT_FALSE(set.contains(std::uint64_t{6}));
+    EXPECT_TRUE(set.contains(std::uint64_t{29}));
+
+    /* shrink back while erasing */
+    set.rehash(small);
+
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        set.erase(e[20 + i]);
+    }
+
+    EXPECT_FALSE(set.rehashing());
+    EXPECT_EQ(set.size(), 18u);
+
+    for (std::uint64_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(set.contains(i), i != 5 && i != 6);
+    }
+
+    set.clear();
+}
+
+TEST(HashSetTest, RehashWhileRehashingCompletesFirst) {
+    EntrySet::bucket_type a[2], b[16], c[4];
+
+    Entry e[12];
+    EntrySet set(a);
+
+    for (std::uint64_t i = 0; i < 12; ++i) {
+        e[i].id = i * 7;
+        set.insert(e[i]);
+    }
+
+    set.rehash(b);
+    set.rehash(c);
+
+    for (auto& bucket : a) {
+        EXPECT_TRUE(bucket.empty());
+    }
+
+    EXPECT_EQ(set.bucket_count(), 4u);
+    EXPECT_EQ(set.size(), 12u);
+
+    /* clear() also drops the elements still waiting in the old table */
+    set.clear();
+
+    EXPECT_FALSE(set.rehashing());
+    EXPECT_TRUE(set.empty());
+
+    for (auto& x : e) {
+        EXPECT_FALSE(x.is_linked());
+    }
+}
+
+TEST(HashSetTest, GrowsWithoutStopTheWorld) {
+    constexpr std::size_t kCount = 1 << 14;
+
+    auto entries = std::make_unique<Entry[]>(kCount);
+
+    std::vector<std::vector<CountedEntrySet::bucket_type>> tables;
+    tables.emplace_back(16);
+
+    CountedEntrySet set(tables.back());
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        /* double at load factor 1, the previous array is kept until migrated */
+        if (set.size() == set.bucket_count() && !set.rehashing()) {
+            tables.emplace_back(set.bucket_count() * 2);
+            set.rehash(tables.back());
+        }
+
+        entries[i].id = i;
+        ASSERT_TRUE(set.insert(entries[i]));
+    }
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        ASSERT_EQ(set.find(std::uint64_t{i}), &entries[i]);
+    }
+
+    EXPECT_EQ(set.size(), kCount);
+
+    set.clear();
+}
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+#include <ntrusive/heap.hpp>
+#include <ntrusive/intrusive.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+struct HeapTimer : IntrusiveHeapNode<> {
+    std::uint64_t deadline{0};
+
+    HeapTimer() = default;
+    explicit HeapTimer(std::uint64_t d) : deadline(d) {}
+};
+
+struct ByDeadline {
+    bool operator()(const HeapTimer& a, const HeapTimer& b) const noexcept {
+        return a.deadline < b.deadline;
+    }
+};
+
+struct PrioJob {
+    int priority{0};
+    IntrusiveHeapNode<> heap_hook_;
+};
+
+struct ByPriority {
+    bool operator()(const PrioJob& a, const PrioJob& b) const noexcept {
+        return a.priority < b.priority;
+    }
+};
+
+using TimerHeap = IntrusivePairingHeap<HeapTimer, ByDeadline>;
+using CountedTimerHeap = IntrusivePairingHeap<HeapTimer, ByDeadline, CountingPolicy>;
+using PrioJobHeap = IntrusivePairingHeap<PrioJob, ByPriority, MemberHook<&PrioJob::heap_hook_>>;
+
+template <typename Heap>
+std::vector<std::uint64_t> drain(Heap& heap) {
+    std::vector<std::uint64_t> out;
+
+    while (auto* t = heap.try_pop()) {
+        EXPECT_FALSE(t->is_linked());
+        out.push_back(t->deadline);
+    }
+
+    return out;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(PairingHeapTest, EmptyHeap) {
+    TimerHeap heap;
+
+    EXPECT_TRUE(heap.empty());
+    EXPECT_EQ(heap.size(), 0u);
+    EXPECT_EQ(heap.try_pop(), nullptr);
+}
+
+TEST(PairingHeapTest, PopsInOrder) {
+    HeapTimer t[6] = {HeapTimer{5}, HeapTimer{1}, HeapTimer{4},
+                      HeapTimer{1}, HeapTimer{9}, HeapTimer{3}};
+    TimerHeap heap;
+
+    for (auto& x : t) {
+        heap.push(x);
+        EXPECT_TRUE(x.is_linked());
+    }
+
+    EXPECT_EQ(heap.size(), 6u);
+    EXPECT_EQ(heap.top().deadline, 1u);
+
+    EXPECT_EQ(drain(heap), (std::vector<std::uint64_t>{1, 1, 3, 4, 5, 9}));
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST(PairingHeapTest, DecreaseKey) {
+    HeapTimer a{10}, b{20}, c{30}, d{40};
+    TimerHeap heap;
+
+    heap.push(a);
+    heap.push(b);
+    heap.push(c);
+    heap.push(d);
+
+    /* force some structure below the root */
+    heap.pop();
+    heap.push(a);
+
+    d.deadline = 5;
+    heap.decrease(d);
+    EXPECT_EQ(&heap.top(), &d);
+
+    /* decreasing the root is a no-op */
+    d.deadline = 1;
+    heap.decrease(d);
+    EXPECT_EQ(&heap.top(), &d);
+
+    EXPECT_EQ(drain(heap), (std::vector<std::uint64_t>{1, 10, 20, 30}));
+}
+
+TEST(PairingHeapTest, EraseAnyElement) {
+    HeapTimer t[8];
+    TimerHeap heap;
+
+    for (int i = 0; i < 8; ++i) {
+        t[i].deadline = static_cast<std::uint64_t>(i);
+        heap.push(t[i]);
+    }
+
+    heap.pop(); /* 0 */
+
+    heap.erase(t[5]);
+    heap.erase(t[1]); /* the root */
+    heap.erase(t[7]);
+
+    EXPECT_FALSE(t[5].is_linked());
+    EXPECT_FALSE(t[1].is_linked());
+
+    EXPECT_EQ(drain(heap), (std::vector<std::uint64_t>{2, 3, 4, 6}));
+}
+
+TEST(PairingHeapTest, StaticRemove) {
+    HeapTimer t[8];
+    TimerHeap heap;
+
+    for (int i = 0; i < 8; ++i) {
+        t[i].deadline = static_cast<std::uint64_t>(7 - i);
+        heap.push(t[i]);
+    }
+
+    heap.pop(); /* 0 : builds a multi-level tree */
+
+    TimerHeap::remove(t[3]); /* 4 */
+    TimerHeap::remove(t[6]); /* 1, the root */
+    TimerHeap::remove(t[0]); /* 7 */
+
+    EXPECT_FALSE(t[3].is_linked());
+    EXPECT_FALSE(t[6].is_linked());
+
+    EXPECT_EQ(heap.size(), 4u);
+    EXPECT_EQ(drain(heap), (std::vector<std::uint64_t>{2, 3, 5, 6}));
+}
+
+TEST(PairingHeapTest, Merge) {
+    HeapTimer a{3}, b{1}, c{4}, d{2};
+    CountedTimerHeap x, y;
+
+    x.push(a);
+    x.push(c);
+    y.push(b);
+    y.push(d);
+
+    x.merge(y);
+
+    EXPECT_TRUE(y.empty());
+    EXPECT_EQ(y.size(), 0u);
+    EXPECT_EQ(x.size(), 4u);
+
+    EXPECT_EQ(drain(x), (std::vector<std::uint64_t>{1, 2, 3, 4}));
+}
+
+TEST(PairingHeapTest, ClearResetsAllHooks) {
+    HeapTimer t[32];
+    TimerHeap heap;
+
+    for (int i = 0; i < 32; ++i) {
+        t[i].deadline = static_cast<std::uint64_t>((i * 7) % 32);
+        heap.push(t[i]);
+    }
+
+    heap.pop();
+    heap.pop();
+
+    heap.clear();
+
+    EXPECT_TRUE(heap.empty());
+    for (auto& x : t) {
+        EXPECT_FALSE(x.is_linked());
+    }
+}
+
+TEST(PairingHeapTest, MemberHook) {
+    PrioJob jobs[4];
+    PrioJobHeap heap;
+
+    for (int i = 0; i < 4; ++i) {
+        jobs[i].priority = 10 - i;
+        heap.push(jobs[i]);
+    }
+
+    EXPECT_EQ(&heap.top(), &jobs[3]);
+
+    heap.erase(jobs[3]);
+    EXPECT_EQ(&heap.top(), &jobs[2]);
+
+    heap.clear();
+}
+
+TEST(PairingHeapTest, RandomizedAgainstSort) {
+    constexpr std::size_t kCount = 2000;
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::uint64_t> dist(0, 1000);
+
+    auto timers = std::make_unique<HeapTimer[]>(kCount);
+    CountedTimerHeap heap;
+    std::vector<HeapTimer*> live;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        timers[i].deadline = dist(rng);
+        heap.push(timers[i]);
+        live.push_back(&timers[i]);
+
+        /* mix in pops, decreases and erases */
+        switch (rng() % 4) {
+        case 0: {
+            HeapTimer* top = &heap.top();
+            heap.pop();
+            live.erase(std::find(live.begin(), live.end(), top));
+            break;
+        }
+        case 1: {
+            HeapTimer* t = live[rng() % live.size()];
+            t->deadline /= 2;
+            heap.decrease(*t);
+            break;
+        }
+        case 2: {
+            HeapTimer* t = live[rng() % live.size()];
+            heap.erase(*t);
+            live.erase(std::find(live.begin(), live.end(), t));
+            break;
+        }
+        default:
+            break;
+        }
+
+        ASSERT_EQ(heap.size(), live.size());
+    }
+
+    std::vector<std::uint64_t> expected;
+    for (auto* t : live) {
+        expected.push_back(t->deadline);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    EXPECT_EQ(drain(heap), expected);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/lru_cache.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Blob : IntrusiveListNode<LruOrderTag, SafeLink>, IntrusiveListNode<LruIndexTag> {
+    std::uint64_t key{0};
+
+    Blob() = default;
+    explicit Blob(std::uint64_t k) : key(k) {}
+};
+
+struct Page : IntrusiveListNode<LruOrderTag, SafeLink>, IntrusiveListNode<LruIndexTag, SafeLink> {
+    std::string name;
+};
+
+struct PageName {
+    const std::string& operator()(const Page& p) const noexcept { return p.name; }
+};
+
+using Cache = IntrusiveLruCache<std::uint64_t, Blob>;
+using PageCache = IntrusiveLruCache<std::string, Page, PageName>;
+
+std::vector<std::uint64_t> recency(Cache::order_type& list) {
+    std::vector<std::uint64_t> out;
+
+    for (auto& b : list) {
+        out.push_back(b.key);
+    }
+
+    return out;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(LruCacheTest, InsertAndFind) {
+    Blob a{1}, b{2};
+    Cache::bucket_type buckets[16];
+    Cache cache(buckets);
+
+
+    EXPECT_TRUE(cache.empty());
+    EXPECT_TRUE(cache.insert(a));
+    EXPECT_TRUE(cache.insert(b));
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.find(1), &a);
+    EXPECT_EQ(cache.find(3), nullptr);
+
+    EXPECT_EQ(&cache.mru(), &b);
+    EXPECT_EQ(&cache.lru(), &a);
+}
+
+TEST(LruCacheTest, DuplicateKeyRefused) {
+    Blob a{1}, twin{1};
+    Cache::bucket_type buckets[4];
+    Cache cache(buckets);
+
+
+    EXPECT_TRUE(cache.insert(a));
+    EXPECT_FALSE(cache.insert(twin));
+    EXPECT_EQ(cache.size(), 1u);
+
+    EXPECT_FALSE((static_cast<IntrusiveListNode<LruOrderTag, SafeLink>&>(twin).is_linked()));
+}
+
+TEST(LruCacheTest, GetTouches) {
+    Blob a{1}, b{2}, c{3};
+    Cache::bucket_type buckets[8];
+    Cache cache(buckets);
+
+
+    cache.insert(a);
+    cache.insert(b);
+    cache.insert(c);
+
+    /* find() leaves the order alone */
+    EXPECT_EQ(cache.find(1), &a);
+    EXPECT_EQ(&cache.lru(), &a);
+
+    EXPECT_EQ(cache.get(1), &a);
+    EXPECT_EQ(&cache.mru(), &a);
+    EXPECT_EQ(&cache.lru(), &b);
+
+    cache.touch(b);
+    EXPECT_EQ(&cache.mru(), &b);
+    EXPECT_EQ(&cache.lru(), &c);
+
+    EXPECT_EQ(cache.get(42), nullptr);
+}
+
+TEST(LruCacheTest, EvictN) {
+    Blob blobs[6];
+    Cache::bucket_type buckets[8];
+    Cache cache(buckets);
+
+
+    for (std::uint64_t i = 0; i < 6; ++i) {
+        blobs[i].key = i;
+        cache.insert(blobs[i]);
+    }
+
+    cache.touch(blobs[0]);
+
+    /* recency : 0 5 4 3 2 1 */
+    Cache::order_type evicted;
+
+    EXPECT_EQ(cache.evict_n(3, evicted), 3u);
+    EXPECT_EQ(recency(evicted), (std::vector<std::uint64_t>{3, 2, 1}));
+
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_EQ(cache.find(3), nullptr);
+    EXPECT_EQ(cache.find(4), &blobs[4]);
+
+    EXPECT_FALSE((static_cast<IntrusiveListNode<LruIndexTag>&>(blobs[2]).is_linked()));
+
+    /* more than available : appended after the previous batch */
+    EXPECT_EQ(cache.evict_n(10, evicted), 3u);
+    EXPECT_EQ(recency(evicted), (std::vector<std::uint64_t>{3, 2, 1, 0, 5, 4}));
+
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.evict_n(1, evicted), 0u);
+
+    evicted.clear();
+}
+
+TEST(LruCacheTest, EraseBothHooks) {
+    Blob a{1}, b{2};
+    Cache::bucket_type buckets[8];
+    Cache cache(buckets);
+
+
+    cache.insert(a);
+    cache.insert(b);
+
+    cache.erase(a);
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_FALSE((static_cast<IntrusiveListNode<LruOrderTag, SafeLink>&>(a).is_linked()));
+    EXPECT_FALSE((static_cast<IntrusiveListNode<LruIndexTag>&>(a).is_linked()));
+
+    /* can come back */
+    EXPECT_TRUE(cache.insert(a));
+    EXPECT_EQ(&cache.mru(), &a);
+}
+
+TEST(LruCacheTest, CustomKey) {
+    Page home, about;
+    PageCache::bucket_type buckets[8];
+    PageCache cache(buckets);
+
+    home.name = "/";
+    about.name = "/about";
+
+    cache.insert(home);
+    cache.insert(about);
+
+    EXPECT_EQ(cache.get("/"), &home);
+    EXPECT_EQ(&cache.lru(), &about);
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+}
+
+TEST(LruCacheTest, BoundedCacheWorkload) {
+    constexpr std::size_t kCapacity = 64;
+    constexpr std::size_t kObjects = 1000;
+
+    auto blobs = std::make_unique<Blob[]>(kObjects);
+
+    std::vector<Cache::bucket_type> buckets(128);
+    Cache cache(buckets);
+    Cache::order_type evicted;
+
+    for (std::size_t i = 0; i < kObjects; ++i) {
+        blobs[i].key = i;
+
+        if (cache.size() == kCapacity) {
+            ASSERT_EQ(cache.evict_n(8, evicted), 8u);
+            evicted.clear();
+        }
+
+        ASSERT_TRUE(cache.insert(blobs[i]));
+
+        /* keep a hot key alive */
+        if (i >= 1) {
+            ASSERT_EQ(cache.get(1), &blobs[1]);
+        }
+    }
+
+    EXPECT_LE(cache.size(), kCapacity);
+    EXPECT_EQ(cache.find(1), &blobs[1]);
+    EXPECT_EQ(cache.find(kObjects - 1), &blobs[kObjects - 1]);
+}
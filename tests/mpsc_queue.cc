@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/mpsc_queue.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct Msg : IntrusiveListNode<> {
+    int producer{0};
+    int seq{0};
+};
+
+using Queue = IntrusiveMpscQueue<Msg>;
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(MpscQueueTest, EmptyQueue) {
+    Queue queue;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.try_pop(), nullptr);
+}
+
+TEST(MpscQueueTest, FifoOrder) {
+    Msg a, b, c;
+    a.seq = 1;
+    b.seq = 2;
+    c.seq = 3;
+
+    Queue queue;
+
+    queue.push(a);
+    queue.push(b);
+
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.try_pop(), &a);
+
+    queue.push(c);
+
+    EXPECT_EQ(queue.try_pop(), &b);
+    EXPECT_EQ(queue.try_pop(), &c);
+    EXPECT_EQ(queue.try_pop(), nullptr);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, PoppedElementIsUnlinked) {
+    Msg a;
+    Queue queue;
+    IntrusiveList<Msg> list;
+
+    queue.push(a);
+
+    auto* msg = queue.try_pop();
+
+    ASSERT_EQ(msg, &a);
+    EXPECT_FALSE(a.is_linked());
+
+    list.push_back(a);
+    list.clear();
+}
+
+TEST(MpscQueueTest, ReuseAfterDrain) {
+    Msg a, b;
+    Queue queue;
+
+    for (int i = 0; i < 5; ++i) {
+        queue.push(a);
+        queue.push(b);
+
+        EXPECT_EQ(queue.try_pop(), &a);
+        EXPECT_EQ(queue.try_pop(), &b);
+        EXPECT_EQ(queue.try_pop(), nullptr);
+    }
+}
+
+TEST(MpscQueueTest, PopAllHandsOverList) {
+    Msg msgs[4];
+    Queue queue;
+    IntrusiveList<Msg> out;
+
+    for (int i = 0; i < 4; ++i) {
+        msgs[i].seq = i;
+        queue.push(msgs[i]);
+    }
+
+    EXPECT_EQ(queue.pop_all(out), 4u);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.pop_all(out), 0u);
+
+    int expected = 0;
+    for (auto& msg : out) {
+        EXPECT_EQ(msg.seq, expected++);
+    }
+    EXPECT_EQ(expected, 4);
+
+    out.clear();
+}
+
+TEST(MpscQueueTest, PopAllAfterTryPop) {
+    Msg msgs[5];
+    Queue queue;
+    IntrusiveList<Msg> out;
+
+    for (int i = 0; i < 5; ++i) {
+        msgs[i].seq = i;
+    }
+
+    /* try_pop() of the last element queues the stub behind it */
+    queue.push(msgs[0]);
+    EXPECT_EQ(queue.try_pop(), &msgs[0]);
+
+    queue.push(msgs[1]);
+    queue.push(msgs[2]);
+    EXPECT_EQ(queue.try_pop(), &msgs[1]);
+
+    queue.push(msgs[3]);
+    queue.push(msgs[4]);
+
+    EXPECT_EQ(queue.pop_all(out), 3u);
+
+    std::vector<int> seqs;
+    for (auto& msg : out) {
+        seqs.push_back(msg.seq);
+    }
+    EXPECT_EQ(seqs, (std::vector{2, 3, 4}));
+
+    EXPECT_TRUE(queue.empty());
+
+    out.clear();
+}
+
+TEST(MpscQueueTest, MemberHook) {
+    struct Job {
+        int id{0};
+        IntrusiveListNode<> hook_;
+    };
+
+    Job a, b;
+    a.id = 1;
+    b.id = 2;
+
+    IntrusiveMpscQueue<Job, MemberHook<&Job::hook_>> queue;
+
+    queue.push(a);
+    queue.push(b);
+
+    EXPECT_EQ(queue.try_pop()->id, 1);
+    EXPECT_EQ(queue.try_pop()->id, 2);
+}
+
+TEST(MpscQueueTest, ConcurrentProducersKeepPerProducerOrder) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+
+    auto msgs = std::make_unique<Msg[]>(kProducers * kPerProducer);
+    Queue queue;
+
+    std::vector<std::thread> producers;
+
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                auto& msg = msgs[p * kPerProducer + i];
+                msg.producer = p;
+                msg.seq = i;
+                queue.push(msg);
+            }
+        });
+    }
+
+    std::vector<int> next_seq(kProducers, 0);
+    int received = 0;
+    IntrusiveList<Msg> batch;
+
+    auto check = [&](Msg& msg) {
+        EXPECT_EQ(msg.seq, next_seq[msg.producer]);
+        next_seq[msg.producer] = msg.seq + 1;
+        ++received;
+    };
+
+    while (received < kProducers * kPerProducer) {
+        /* alternate both consuming styles */
+        if (received % 2 == 0) {
+            if (auto* msg = queue.try_pop()) {
+                check(*msg);
+            }
+        } else {
+            queue.pop_all(batch);
+
+            while (auto* msg = batch.try_pop_front()) {
+                check(*msg);
+            }
+        }
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+
+    EXPECT_TRUE(queue.empty());
+}
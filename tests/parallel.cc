@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/parallel.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct Shard : IntrusiveListNode<DefaultTag, SafeLink> {
+    std::uint32_t key{0};
+    std::uint32_t rank{0};
+    std::uint64_t visits{0};
+};
+
+using ShardList = IntrusiveList<Shard, CountingPolicy>;
+
+/* n nodes with few distinct keys, so stability is visible */
+std::unique_ptr<Shard[]> shards(std::size_t n) {
+    auto nodes = std::make_unique<Shard[]>(n);
+    std::uint32_t x = 12345;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        x = x * 1103515245u + 12345u;
+        nodes[i].key = (x >> 16) % 97;
+        nodes[i].rank = static_cast<std::uint32_t>(i);
+    }
+
+    return nodes;
+}
+
+TEST(ParallelTest, SortMatchesStableSort) {
+    constexpr std::size_t kCount = 5 * kParallelGrain + 123;
+
+    ThreadPool pool(4);
+    auto nodes = shards(kCount);
+    ShardList list;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        list.push_back(nodes[i]);
+    }
+
+    parallel_sort(list, pool, [](const Shard& a, const Shard& b) { return a.key < b.key; });
+
+    ASSERT_EQ(list.size(), kCount);
+
+    const Shard* prev = nullptr;
+    std::size_t walked = 0;
+
+    for (const Shard& s : list) {
+        if (prev != nullptr) {
+            ASSERT_TRUE(prev->key < s.key || (prev->key == s.key && prev->rank < s.rank));
+        }
+
+        prev = &s;
+        ++walked;
+    }
+
+    EXPECT_EQ(walked, kCount);
+    EXPECT_EQ(&list.back(), prev);
+
+    list.clear();
+}
+
+TEST(ParallelTest, SortsNonCountingListSplitInOneWalk) {
+    /* odd length : the cuts land on marks, not on exact positions */
+    constexpr std::size_t kCount = 9 * kParallelGrain + 77;
+
+    ThreadPool pool(4);
+    auto nodes = shards(kCount);
+    IntrusiveList<Shard> list;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        list.push_back(nodes[i]);
+    }
+
+    parallel_sort(list, pool, [](const Shard& a, const Shard& b) { return a.key < b.key; });
+
+    const Shard* prev = nullptr;
+    std::size_t walked = 0;
+
+    for (const Shard& s : list) {
+        if (prev != nullptr) {
+            ASSERT_TRUE(prev->key < s.key || (prev->key == s.key && prev->rank < s.rank));
+        }
+
+        prev = &s;
+        ++walked;
+    }
+
+    EXPECT_EQ(walked, kCount);
+    list.clear();
+}
+
+TEST(ParallelTest, SmallListSortsInline) {
+    ThreadPool pool(2);
+    auto nodes = shards(100);
+    ShardList list;
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        list.push_front(nodes[i]);
+    }
+
+    parallel_sort(list, pool, [](const Shard& a, const Shard& b) { return a.rank < b.rank; });
+
+    std::uint32_t expected = 0;
+
+    for (const Shard& s : list) {
+        EXPECT_EQ(s.rank, expected++);
+    }
+
+    EXPECT_EQ(expected, 100u);
+    list.clear();
+}
+
+TEST(ParallelTest, ForEachVisitsEveryElementOnceInPlace) {
+    constexpr std::size_t kCount = 7 * kParallelGrain;
+
+    ThreadPool pool(3);
+    auto nodes = shards(kCount);
+    IntrusiveList<Shard> list;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        list.push_back(nodes[i]);
+    }
+
+    parallel_for_each(list, [](Shard& s) { ++s.visits; }, pool);
+
+    std::uint32_t expected = 0;
+
+    for (const Shard& s : list) {
+        EXPECT_EQ(s.rank, expected++);
+        EXPECT_EQ(s.visits, 1u);
+    }
+
+    EXPECT_EQ(expected, kCount);
+    list.clear();
+}
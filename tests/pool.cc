@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/pool.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct Pooled : IntrusiveListNode<> {
+    static inline int alive = 0;
+
+    std::uint64_t id{0};
+    char payload[40]{};
+
+    Pooled() noexcept { ++alive; }
+    explicit Pooled(std::uint64_t i) noexcept : id(i) { ++alive; }
+    ~Pooled() { --alive; }
+};
+
+/* too small to hold a free-list hook on its own */
+struct Tiny {
+    char c{0};
+};
+
+struct Throwing {
+    explicit Throwing(bool fail) {
+        if (fail) {
+            throw std::runtime_error("ctor");
+        }
+    }
+};
+
+TEST(PoolTest, AcquireReleaseRecyclesSlots) {
+    IntrusivePool<Pooled, 8> pool;
+
+    Pooled* a = pool.acquire(1u);
+    EXPECT_EQ(a->id, 1u);
+    EXPECT_EQ(Pooled::alive, 1);
+    EXPECT_EQ(pool.capacity(), 8u);
+    EXPECT_EQ(pool.available(), 7u);
+
+    pool.release(a);
+    EXPECT_EQ(Pooled::alive, 0);
+
+    /* LIFO : the slot just released comes back first */
+    Pooled* b = pool.acquire(2u);
+    EXPECT_EQ(b, a);
+    EXPECT_EQ(b->id, 2u);
+
+    pool.release(b);
+    EXPECT_EQ(pool.available(), 8u);
+}
+
+TEST(PoolTest, GrowsBySlabs) {
+    IntrusivePool<Pooled, 4> pool;
+    std::vector<Pooled*> objects;
+    std::set<Pooled*> distinct;
+
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        objects.push_back(pool.acquire(i));
+        distinct.insert(objects.back());
+    }
+
+    EXPECT_EQ(distinct.size(), 10u);
+    EXPECT_EQ(pool.capacity(), 12u);
+
+    for (Pooled* p : objects) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignof(Pooled), 0u);
+        pool.release(p);
+    }
+
+    EXPECT_EQ(pool.available(), 12u);
+}
+
+TEST(PoolTest, TinyObjects) {
+    IntrusivePool<Tiny, 16> pool(20);
+    EXPECT_EQ(pool.capacity(), 32u);
+
+    Tiny* a = pool.acquire();
+    Tiny* b = pool.acquire();
+    a->c = 'a';
+    b->c = 'b';
+
+    EXPECT_EQ(a->c, 'a');
+    pool.release(a);
+    pool.release(b);
+}
+
+TEST(PoolTest, BatchAcquireAndRelease) {
+    IntrusivePool<Pooled, 16> pool;
+    IntrusiveList<Pooled> batch;
+
+    EXPECT_EQ(pool.acquire_batch(40, batch), 40u);
+    EXPECT_EQ(batch.size(), 40u);
+    EXPECT_EQ(Pooled::alive, 40);
+    EXPECT_EQ(pool.capacity(), 48u);
+
+    pool.release_batch(batch);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(Pooled::alive, 0);
+    EXPECT_EQ(pool.available(), 48u);
+}
+
+TEST(PoolTest, ThrowingConstructorKeepsTheSlot) {
+    IntrusivePool<Throwing, 4> pool;
+
+    EXPECT_THROW((void)pool.acquire(true), std::runtime_error);
+    EXPECT_EQ(pool.available(), 4u);
+
+    Throwing* ok = pool.acquire(false);
+    pool.release(ok);
+}
+
+TEST(PoolTest, LocalCacheRefillsAndSpills) {
+    using Pool = IntrusivePool<Pooled, 64>;
+    Pool pool;
+
+    {
+        Pool::LocalCache cache(pool);
+
+        Pooled* first = cache.acquire(7u);
+        EXPECT_EQ(cache.cached(), Pool::kCacheBatch - 1);
+        EXPECT_EQ(pool.available(), 64 - Pool::kCacheBatch);
+
+        IntrusiveList<Pooled> batch;
+        cache.acquire_batch(100, batch);
+        EXPECT_EQ(batch.size(), 100u);
+
+        cache.release(first);
+        cache.release_batch(batch);
+
+        /* spilled down to one batch, the rest is back in the depot */
+        EXPECT_EQ(cache.cached(), Pool::kCacheBatch);
+    }
+
+    EXPECT_EQ(Pooled::alive, 0);
+    EXPECT_EQ(pool.available(), pool.capacity());
+}
+
+TEST(PoolTest, CachesOnSeveralThreads) {
+    using Pool = IntrusivePool<Pooled, 32>;
+    Pool pool;
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, t] {
+            Pool::LocalCache cache(pool);
+            IntrusiveList<Pooled> live;
+
+            for (int round = 0; round < 200; ++round) {
+                for (int i = 0; i < 50; ++i) {
+                    live.push_back(*cache.acquire(static_cast<std::uint64_t>(t)));
+                }
+
+                for (const Pooled& p : live) {
+                    EXPECT_EQ(p.id, static_cast<std::uint64_t>(t));
+                }
+
+                cache.release_batch(live);
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(pool.available(), pool.capacity());
+}
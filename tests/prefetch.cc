@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/prefetch.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+struct Scan : IntrusiveListNode<DefaultTag, SafeLink> {
+    int value{0};
+
+    explicit Scan(int v) noexcept : value(v) {}
+
+    /* hooks are never moved : the new object starts unlinked */
+    Scan(Scan&& other) noexcept : value(other.value) {}
+};
+
+TEST(PrefetchTest, VisitsEveryElementInOrder) {
+    std::vector<std::unique_ptr<Scan>> storage;
+    IntrusiveList<Scan> list;
+
+    for (int i = 0; i < 50; ++i) {
+        storage.push_back(std::make_unique<Scan>(i));
+        list.push_back(*storage.back());
+    }
+
+    for (std::size_t distance : {0u, 1u, 8u, 100u}) {
+        std::vector<int> seen;
+        for_each_prefetch(list, [&](Scan& s) { seen.push_back(s.value); }, distance);
+
+        ASSERT_EQ(seen.size(), 50u);
+
+        for (int i = 0; i < 50; ++i) {
+            EXPECT_EQ(seen[static_cast<std::size_t>(i)], i);
+        }
+    }
+
+    list.clear();
+}
+
+TEST(PrefetchTest, CallbackMayUnlinkCurrent) {
+    std::vector<std::unique_ptr<Scan>> storage;
+    IntrusiveList<Scan> list;
+
+    for (int i = 0; i < 20; ++i) {
+        storage.push_back(std::make_unique<Scan>(i));
+        list.push_back(*storage.back());
+    }
+
+    for_each_prefetch(list, [&](Scan& s) {
+        if (s.value % 2 == 0) {
+            list.erase(s);
+        }
+    });
+
+    int expected = 1;
+
+    for (const Scan& s : list) {
+        EXPECT_EQ(s.value, expected);
+        expected += 2;
+    }
+
+    EXPECT_EQ(expected, 21);
+    list.clear();
+}
+
+TEST(PrefetchTest, RelayoutMakesTheListContiguous) {
+    IntrusiveList<Scan, CountingPolicy> list;
+
+    /* scattered : every other allocation kept */
+    std::vector<std::unique_ptr<Scan>> spacers;
+
+    for (int i = 0; i < 30; ++i) {
+        spacers.push_back(std::make_unique<Scan>(-1));
+        list.push_front(*new Scan(i));
+    }
+
+    std::allocator<Scan> alloc;
+    std::size_t disposed = 0;
+
+    Scan* buffer = relayout(list, alloc, [&](Scan& old) {
+        EXPECT_FALSE(old.is_linked());
+        ++disposed;
+        delete &old;
+    });
+
+    EXPECT_EQ(disposed, 30u);
+    ASSERT_EQ(list.size(), 30u);
+
+    std::size_t i = 0;
+
+    for (const Scan& s : list) {
+        EXPECT_EQ(&s, buffer + i);
+        EXPECT_EQ(s.value, 29 - static_cast<int>(i));
+        ++i;
+    }
+
+    list.clear();
+
+    for (std::size_t k = 0; k < 30; ++k) {
+        buffer[k].~Scan();
+    }
+
+    alloc.deallocate(buffer, 30);
+}
@@ -0,0 +1,337 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/rbtree.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+struct RbItem : IntrusiveRbTreeNode<> {
+    int key{0};
+    int seq{0};
+
+    RbItem() = default;
+    explicit RbItem(int k, int s = 0) : key(k), seq(s) {}
+};
+
+struct ByKey {
+    bool operator()(const RbItem& a, const RbItem& b) const noexcept { return a.key < b.key; }
+    bool operator()(const RbItem& a, int k) const noexcept { return a.key < k; }
+    bool operator()(int k, const RbItem& b) const noexcept { return k < b.key; }
+};
+
+struct PriceLevel {
+    std::int64_t price{0};
+    IntrusiveRbTreeNode<> tree_hook_;
+};
+
+struct ByPrice {
+    bool operator()(const PriceLevel& a, const PriceLevel& b) const noexcept {
+        return a.price < b.price;
+    }
+};
+
+using RbItemTree = IntrusiveRbTree<RbItem, ByKey>;
+using CountedRbItemTree = IntrusiveRbTree<RbItem, ByKey, CountingPolicy>;
+using LevelTree = IntrusiveRbTree<PriceLevel, ByPrice, MemberHook<&PriceLevel::tree_hook_>>;
+
+/* black height of the subtree, -1 if a red-black invariant is broken */
+int black_height(const RbNodeBase* node, const RbNodeBase* parent) {
+    if (node == nullptr) {
+        return 1;
+    }
+
+    if (node->parent_ != parent) {
+        return -1;
+    }
+
+    if (node->red_ && ((node->left_ != nullptr && node->left_->red_) ||
+                       (node->right_ != nullptr && node->right_->red_))) {
+        return -1;
+    }
+
+    const int left = black_height(node->left_, node);
+    const int right = black_height(node->right_, node);
+
+    if (left < 0 || left != right) {
+        return -1;
+    }
+
+    return left + (node->red_ ? 0 : 1);
+}
+
+template <typename Tree>
+void check_rb(const Tree& tree, const std::vector<int>& expected) {
+    std::vector<int> keys;
+
+    for (const auto& item : tree) {
+        keys.push_back(item.key);
+    }
+
+    EXPECT_EQ(keys, expected);
+
+    if (tree.empty()) {
+        return;
+    }
+
+    const RbNodeBase* root = &static_cast<const IntrusiveRbTreeNode<>&>(tree.front());
+
+    while (!root->parent_->is_header()) {
+        root = root->parent_;
+    }
+
+    EXPECT_FALSE(root->red_);
+    EXPECT_GT(black_height(root, root->parent_), 0);
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(RbTreeTest, EmptyTree) {
+    RbItemTree tree;
+
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_EQ(tree.begin(), tree.end());
+    EXPECT_EQ(tree.find(1), tree.end());
+    EXPECT_EQ(tree.unlink_leftmost_without_rebalance(), nullptr);
+}
+
+TEST(RbTreeTest, InsertKeepsOrder) {
+    RbItem items[7] = {RbItem{5}, RbItem{1}, RbItem{4}, RbItem{7},
+                       RbItem{2}, RbItem{6}, RbItem{3}};
+    RbItemTree tree;
+
+    for (auto& item : items) {
+        tree.insert(item);
+        EXPECT_TRUE(item.is_linked());
+    }
+
+    check_rb(tree, {1, 2, 3, 4, 5, 6, 7});
+
+    EXPECT_EQ(tree.size(), 7u);
+    EXPECT_EQ(tree.front().key, 1);
+    EXPECT_EQ(tree.back().key, 7);
+
+    tree.clear();
+}
+
+TEST(RbTreeTest, ReverseIteration) {
+    RbItem items[5] = {RbItem{3}, RbItem{1}, RbItem{5}, RbItem{2}, RbItem{4}};
+    RbItemTree tree;
+
+    for (auto& item : items) {
+        tree.insert(item);
+    }
+
+    std::vector<int> keys;
+
+    for (auto it = tree.end(); it != tree.begin();) {
+        --it;
+        keys.push_back(it->key);
+    }
+
+    EXPECT_EQ(keys, (std::vector<int>{5, 4, 3, 2, 1}));
+
+    tree.clear();
+}
+
+TEST(RbTreeTest, EqualKeysKeepInsertionOrder) {
+    RbItem items[4] = {RbItem{2, 0}, RbItem{1, 1}, RbItem{2, 2}, RbItem{2, 3}};
+    RbItemTree tree;
+
+    for (auto& item : items) {
+        tree.insert(item);
+    }
+
+    std::vector<int> seqs;
+
+    for (auto it = tree.lower_bound(2); it != tree.upper_bound(2); ++it) {
+        seqs.push_back(it->seq);
+    }
+
+    EXPECT_EQ(seqs, (std::vector<int>{0, 2, 3}));
+
+    tree.clear();
+}
+
+TEST(RbTreeTest, InsertUnique) {
+    RbItem a{1}, b{2}, twin{2}, c{0};
+    CountedRbItemTree tree;
+
+    EXPECT_TRUE(tree.insert_unique(b).second);
+    EXPECT_TRUE(tree.insert_unique(a).second);
+
+    auto [pos, inserted] = tree.insert_unique(twin);
+
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(&*pos, &b);
+    EXPECT_FALSE(twin.is_linked());
+
+    EXPECT_TRUE(tree.insert_unique(c).second);
+    EXPECT_EQ(tree.size(), 3u);
+
+    check_rb(tree, {0, 1, 2});
+
+    tree.clear();
+}
+
+TEST(RbTreeTest, Bounds) {
+    RbItem items[4] = {RbItem{10}, RbItem{20}, RbItem{30}, RbItem{40}};
+    RbItemTree tree;
+
+    for (auto& item : items) {
+        tree.insert(item);
+    }
+
+    EXPECT_EQ(tree.lower_bound(20)->key, 20);
+    EXPECT_EQ(tree.lower_bound(21)->key, 30);
+    EXPECT_EQ(tree.upper_bound(20)->key, 30);
+    EXPECT_EQ(tree.lower_bound(5)->key, 10);
+    EXPECT_EQ(tree.lower_bound(41), tree.end());
+
+    EXPECT_EQ(&*tree.find(30), &items[2]);
+    EXPECT_EQ(tree.find(31), tree.end());
+    EXPECT_TRUE(tree.contains(40));
+    EXPECT_FALSE(tree.contains(0));
+
+    tree.clear();
+}
+
+TEST(RbTreeTest, EraseByReferenceAndIterator) {
+    RbItem items[6];
+    CountedRbItemTree tree;
+
+    for (int i = 0; i < 6; ++i) {
+        items[i].key = i;
+        tree.insert(items[i]);
+    }
+
+    tree.erase(items[3]);
+    EXPECT_FALSE(items[3].is_linked());
+
+    auto next = tree.erase(tree.iterator_to(items[1]));
+    EXPECT_EQ(next->key, 2);
+
+    next = tree.erase(tree.iterator_to(items[5]));
+    EXPECT_EQ(next, tree.end());
+
+    EXPECT_EQ(tree.size(), 3u);
+    check_rb(tree, {0, 2, 4});
+
+    tree.clear();
+}
+
+TEST(RbTreeTest, StaticRemove) {
+    RbItem items[16];
+    RbItemTree tree;
+
+    for (int i = 0; i < 16; ++i) {
+        items[i].key = i;
+        tree.insert(items[i]);
+    }
+
+    RbItemTree::remove(items[0]);
+    RbItemTree::remove(items[7]);
+    RbItemTree::remove(items[15]);
+
+    /* not linked : no-op */
+    RbItemTree::remove(items[7]);
+
+    check_rb(tree, {1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14});
+
+    tree.clear();
+}
+
+TEST(RbTreeTest, UnlinkLeftmostTearsDown) {
+    RbItem items[32];
+    CountedRbItemTree tree;
+
+    for (int i = 0; i < 32; ++i) {
+        items[i].key = (i * 13) % 32;
+        tree.insert(items[i]);
+    }
+
+    std::vector<int> keys;
+
+    while (RbItem* item = tree.unlink_leftmost_without_rebalance()) {
+        EXPECT_FALSE(item->is_linked());
+        keys.push_back(item->key);
+    }
+
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    EXPECT_EQ(keys.size(), 32u);
+
+    /* usable again */
+    tree.insert(items[0]);
+    check_rb(tree, {0});
+
+    tree.clear();
+}
+
+TEST(RbTreeTest, MemberHook) {
+    PriceLevel levels[4];
+    LevelTree book;
+
+    for (int i = 0; i < 4; ++i) {
+        levels[i].price = 100 - i;
+        book.insert(levels[i]);
+    }
+
+    EXPECT_EQ(&book.front(), &levels[3]);
+    EXPECT_EQ(&book.back(), &levels[0]);
+
+    book.erase(levels[3]);
+    EXPECT_EQ(book.front().price, 98);
+
+    book.clear();
+
+    for (auto& level : levels) {
+        EXPECT_FALSE(level.tree_hook_.is_linked());
+    }
+}
+
+TEST(RbTreeTest, RandomizedAgainstMultiset) {
+    constexpr std::size_t kCount = 3000;
+
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> dist(0, 500);
+
+    auto items = std::make_unique<RbItem[]>(kCount);
+    CountedRbItemTree tree;
+    std::vector<RbItem*> live;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        items[i].key = dist(rng);
+        tree.insert(items[i]);
+        live.push_back(&items[i]);
+
+        if (rng() % 3 == 0) {
+            const std::size_t victim = rng() % live.size();
+
+            if (rng() % 2 == 0) {
+                tree.erase(*live[victim]);
+            } else {
+                tree.erase(tree.iterator_to(*live[victim]));
+            }
+
+            live.erase(live.begin() + static_cast<std::ptrdiff_t>(victim));
+        }
+
+        ASSERT_EQ(tree.size(), live.size());
+    }
+
+    std::vector<int> expected;
+
+    for (auto* item : live) {
+        expected.push_back(item->key);
+    }
+
+    std::sort(expected.begin(), expected.end());
+
+    check_rb(tree, expected);
+
+    tree.clear();
+}
@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/slist.hpp>
+#include <vector>
+
+struct Job : IntrusiveSListNode<> {
+    int id{0};
+};
+
+struct TwoQueues : IntrusiveSListNode<> {
+    int id{0};
+    IntrusiveSListNode<> retry_hook_;
+};
+
+using JobList = IntrusiveSList<Job>;
+using CountedJobList = IntrusiveSList<Job, CountingPolicy>;
+using RetryList = IntrusiveSList<TwoQueues, MemberHook<&TwoQueues::retry_hook_>>;
+
+template <typename List>
+std::vector<int> ids(const List& list) {
+    std::vector<int> out;
+
+    for (auto it = list.cbegin(); it != list.cend(); ++it) {
+        out.push_back(it->id);
+    }
+
+    return out;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(SListTest, HookIsOnePointer) {
+    EXPECT_EQ(sizeof(IntrusiveSListNode<>), sizeof(void*));
+}
+
+TEST(SListTest, EmptyList) {
+    JobList list;
+
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.size(), 0u);
+    EXPECT_EQ(list.begin(), list.end());
+    EXPECT_EQ(list.try_pop_front(), nullptr);
+}
+
+TEST(SListTest, PushBackIsFifo) {
+    Job a, b, c;
+    a.id = 1, b.id = 2, c.id = 3;
+    JobList list;
+
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    EXPECT_EQ(ids(list), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(&list.front(), &a);
+    EXPECT_EQ(&list.back(), &c);
+
+    EXPECT_EQ(list.try_pop_front(), &a);
+    EXPECT_EQ(list.try_pop_front(), &b);
+    EXPECT_EQ(list.try_pop_front(), &c);
+    EXPECT_EQ(list.try_pop_front(), nullptr);
+}
+
+TEST(SListTest, PushFrontIsLifo) {
+    Job a, b, c;
+    a.id = 1, b.id = 2, c.id = 3;
+    JobList list;
+
+    list.push_front(a);
+    list.push_front(b);
+    list.push_front(c);
+
+    EXPECT_EQ(ids(list), (std::vector<int>{3, 2, 1}));
+    EXPECT_EQ(&list.back(), &a);
+
+    list.clear();
+}
+
+TEST(SListTest, PopFrontResetsHook) {
+    Job a;
+    JobList list;
+
+    list.push_back(a);
+    EXPECT_TRUE(a.is_linked());
+
+    list.pop_front();
+    EXPECT_FALSE(a.is_linked());
+    EXPECT_TRUE(list.empty());
+
+    /* tail must be back to the sentinel */
+    list.push_back(a);
+    EXPECT_EQ(&list.front(), &a);
+    EXPECT_EQ(&list.back(), &a);
+
+    list.clear();
+}
+
+TEST(SListTest, InsertAndEraseAfter) {
+    Job a, b, c;
+    a.id = 1, b.id = 2, c.id = 3;
+    JobList list;
+
+    list.push_back(a);
+    list.push_back(c);
+    list.insert_after(list.begin(), b);
+
+    EXPECT_EQ(ids(list), (std::vector<int>{1, 2, 3}));
+
+    auto next = list.erase_after(list.begin());
+    EXPECT_EQ(&*next, &c);
+    EXPECT_FALSE(b.is_linked());
+
+    /* erasing the last element moves the tail back */
+    list.erase_after(list.begin());
+    EXPECT_EQ(&list.back(), &a);
+
+    list.push_back(c);
+    EXPECT_EQ(ids(list), (std::vector<int>{1, 3}));
+
+    list.clear();
+}
+
+TEST(SListTest, ClearResetsAllHooks) {
+    Job jobs[4];
+    JobList list;
+
+    for (auto& j : jobs) {
+        list.push_back(j);
+    }
+
+    list.clear();
+
+    EXPECT_TRUE(list.empty());
+    for (auto& j : jobs) {
+        EXPECT_FALSE(j.is_linked());
+    }
+}
+
+TEST(SListTest, SpliceAfterWholeList) {
+    Job a, b, c, d;
+    a.id = 1, b.id = 2, c.id = 3, d.id = 4;
+    JobList dst, src;
+
+    dst.push_back(a);
+    dst.push_back(d);
+    src.push_back(b);
+    src.push_back(c);
+
+    dst.splice_after(dst.begin(), src);
+
+    EXPECT_TRUE(src.empty());
+    EXPECT_EQ(ids(dst), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(&dst.back(), &d);
+
+    dst.clear();
+}
+
+TEST(SListTest, SpliceAfterAtTailUpdatesTail) {
+    Job a, b, c;
+    a.id = 1, b.id = 2, c.id = 3;
+    JobList dst, src;
+
+    dst.push_back(a);
+    src.push_back(b);
+    src.push_back(c);
+
+    dst.splice_after(JobList::const_iterator(&dst.back()), src);
+
+    EXPECT_EQ(&dst.back(), &c);
+
+    Job d;
+    d.id = 4;
+    dst.push_back(d);
+    EXPECT_EQ(ids(dst), (std::vector<int>{1, 2, 3, 4}));
+
+    dst.clear();
+}
+
+TEST(SListTest, SpliceAfterRange) {
+    Job jobs[5];
+    JobList src, dst;
+
+    for (int i = 0; i < 5; ++i) {
+        jobs[i].id = i;
+        src.push_back(jobs[i]);
+    }
+
+    /* (0, 4) -> moves 1, 2, 3 */
+    auto before_first = src.begin();
+    auto last = before_first;
+    for (int i = 0; i < 4; ++i) {
+        ++last;
+    }
+
+    dst.splice_after(dst.before_begin(), src, before_first, last);
+
+    EXPECT_EQ(ids(src), (std::vector<int>{0, 4}));
+    EXPECT_EQ(ids(dst), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(&dst.back(), &jobs[3]);
+
+    /* range ending at end() moves the tail of src too */
+    dst.splice_after(JobList::const_iterator(&dst.back()), src, src.begin(), src.end());
+
+    EXPECT_EQ(ids(src), (std::vector<int>{0}));
+    EXPECT_EQ(&src.back(), &jobs[0]);
+    EXPECT_EQ(ids(dst), (std::vector<int>{1, 2, 3, 4}));
+
+    src.clear();
+    dst.clear();
+}
+
+TEST(SListTest, ExtractFront) {
+    Job jobs[5];
+    JobList src, dst;
+
+    for (int i = 0; i < 5; ++i) {
+        jobs[i].id = i;
+        src.push_back(jobs[i]);
+    }
+
+    EXPECT_EQ(src.extract_front(dst, 2), 2u);
+    EXPECT_EQ(ids(src), (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(ids(dst), (std::vector<int>{0, 1}));
+
+    EXPECT_EQ(src.extract_front(dst, 10), 3u);
+    EXPECT_TRUE(src.empty());
+    EXPECT_EQ(ids(dst), (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(&dst.back(), &jobs[4]);
+
+    EXPECT_EQ(src.extract_front(dst, 1), 0u);
+
+    dst.clear();
+}
+
+TEST(SListTest, CountingPolicyTracksMoves) {
+    Job jobs[6];
+    CountedJobList a, b;
+
+    for (auto& j : jobs) {
+        a.push_back(j);
+    }
+    EXPECT_EQ(a.size(), 6u);
+
+    EXPECT_EQ(a.extract_front(b, 2), 2u);
+    EXPECT_EQ(a.size(), 4u);
+    EXPECT_EQ(b.size(), 2u);
+
+    b.splice_after(b.before_begin(), a, a.before_begin(), ++a.begin());
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(b.size(), 3u);
+
+    a.pop_front();
+    EXPECT_EQ(a.size(), 2u);
+
+    b.splice_after(b.before_begin(), a);
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_EQ(b.size(), 5u);
+
+    b.clear();
+    EXPECT_EQ(b.size(), 0u);
+}
+
+TEST(SListTest, MemberHookIndependentOfBaseHook) {
+    TwoQueues x, y;
+    x.id = 1, y.id = 2;
+
+    IntrusiveSList<TwoQueues> main_list;
+    RetryList retry;
+
+    main_list.push_back(x);
+    main_list.push_back(y);
+    retry.push_back(y);
+    retry.push_back(x);
+
+    EXPECT_EQ(ids(main_list), (std::vector<int>{1, 2}));
+    EXPECT_EQ(ids(retry), (std::vector<int>{2, 1}));
+
+    main_list.clear();
+    EXPECT_TRUE(x.retry_hook_.is_linked());
+
+    retry.clear();
+}
+
+TEST(SListTest, ForwardListAlias) {
+    Job a;
+    IntrusiveForwardList<Job> list;
+
+    list.push_front(a);
+    EXPECT_EQ(list.size(), 1u);
+
+    list.clear();
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/stack.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct Slot : IntrusiveListNode<> {
+    int id{0};
+    std::atomic<int> owners{0};
+};
+
+using Stack = IntrusiveStack<Slot>;
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(StackTest, EmptyStack) {
+    Stack stack;
+
+    EXPECT_TRUE(stack.empty());
+    EXPECT_EQ(stack.try_pop(), nullptr);
+}
+
+TEST(StackTest, LifoOrder) {
+    Slot a, b, c;
+    Stack stack;
+
+    stack.push(a);
+    stack.push(b);
+    stack.push(c);
+
+    EXPECT_EQ(stack.try_pop(), &c);
+    EXPECT_EQ(stack.try_pop(), &b);
+    EXPECT_EQ(stack.try_pop(), &a);
+    EXPECT_EQ(stack.try_pop(), nullptr);
+    EXPECT_TRUE(stack.empty());
+}
+
+TEST(StackTest, PoppedElementIsUnlinked) {
+    Slot a;
+    Stack stack;
+    IntrusiveList<Slot> list;
+
+    stack.push(a);
+
+    ASSERT_EQ(stack.try_pop(), &a);
+    EXPECT_FALSE(a.is_linked());
+
+    list.push_back(a);
+    list.clear();
+}
+
+TEST(StackTest, PopAllTopFirst) {
+    Slot slots[4];
+    Stack stack;
+    IntrusiveList<Slot> out;
+
+    for (int i = 0; i < 4; ++i) {
+        slots[i].id = i;
+        stack.push(slots[i]);
+    }
+
+    EXPECT_EQ(stack.pop_all(out), 4u);
+    EXPECT_TRUE(stack.empty());
+    EXPECT_EQ(stack.pop_all(out), 0u);
+
+    std::vector<int> ids;
+    for (auto& slot : out) {
+        ids.push_back(slot.id);
+    }
+    EXPECT_EQ(ids, (std::vector{3, 2, 1, 0}));
+
+    out.clear();
+}
+
+TEST(StackTest, PushAllKeepsListOrder) {
+    Slot slots[3];
+    Slot top;
+    Stack stack;
+    IntrusiveList<Slot> in;
+
+    top.id = 99;
+    stack.push(top);
+
+    for (int i = 0; i < 3; ++i) {
+        slots[i].id = i;
+        in.push_back(slots[i]);
+    }
+
+    stack.push_all(in);
+
+    EXPECT_TRUE(in.empty());
+
+    EXPECT_EQ(stack.try_pop()->id, 0);
+    EXPECT_EQ(stack.try_pop()->id, 1);
+    EXPECT_EQ(stack.try_pop()->id, 2);
+    EXPECT_EQ(stack.try_pop()->id, 99);
+    EXPECT_TRUE(stack.empty());
+}
+
+TEST(StackTest, ConcurrentFreeListNeverHandsOutTwice) {
+    constexpr int kThreads = 4;
+    constexpr int kSlots = 64;
+    constexpr int kRounds = 20000;
+
+    auto slots = std::make_unique<Slot[]>(kSlots);
+    Stack stack;
+
+    for (int i = 0; i < kSlots; ++i) {
+        stack.push(slots[i]);
+    }
+
+    std::atomic<bool> twice{false};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            IntrusiveList<Slot> stolen;
+
+            for (int r = 0; r < kRounds; ++r) {
+                if (t == 0 && r % 64 == 0) {
+                    /* a thread that ran dry steals everything */
+                    stack.pop_all(stolen);
+                    stack.push_all(stolen);
+                    continue;
+                }
+
+                if (Slot* slot = stack.try_pop()) {
+                    if (slot->owners.fetch_add(1) != 0) {
+                        twice = true;
+                    }
+                    slot->owners.fetch_sub(1);
+                    stack.push(*slot);
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_FALSE(twice.load());
+
+    IntrusiveList<Slot> all;
+    EXPECT_EQ(stack.pop_all(all), static_cast<std::size_t>(kSlots));
+    all.clear();
+}
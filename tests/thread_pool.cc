@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/thread_pool.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct CountTask : PoolTask {
+    std::atomic<std::size_t>* counter{nullptr};
+    std::atomic<int> runs{0};
+
+    void run() noexcept override {
+        runs.fetch_add(1, std::memory_order_relaxed);
+        counter->fetch_add(1, std::memory_order_release);
+    }
+};
+
+/* fork : a task of depth d submits two tasks of depth d - 1 from inside the pool */
+struct ForkNode : PoolTask {
+    ThreadPool* pool{nullptr};
+    ForkNode* nodes{nullptr};
+    std::size_t index{0};
+    std::size_t total{0};
+    std::atomic<std::size_t>* counter{nullptr};
+
+    void run() noexcept override {
+        for (std::size_t child : {2 * index + 1, 2 * index + 2}) {
+            if (child < total) {
+                pool->submit(nodes[child]);
+            }
+        }
+
+        counter->fetch_add(1, std::memory_order_release);
+    }
+};
+
+void wait_for(const std::atomic<std::size_t>& counter, std::size_t expected) {
+    while (counter.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(ThreadPoolTest, RunsEverySubmittedTaskOnce) {
+    constexpr std::size_t kTasks = 10'000;
+
+    std::atomic<std::size_t> counter{0};
+    auto tasks = std::make_unique<CountTask[]>(kTasks);
+
+    {
+        ThreadPool pool(4);
+
+        EXPECT_EQ(pool.thread_count(), 4u);
+
+        for (std::size_t i = 0; i < kTasks; ++i) {
+            tasks[i].counter = &counter;
+            pool.submit(tasks[i]);
+        }
+
+        wait_for(counter, kTasks);
+    }
+
+    for (std::size_t i = 0; i < kTasks; ++i) {
+        ASSERT_EQ(tasks[i].runs.load(), 1);
+        ASSERT_FALSE(tasks[i].is_linked());
+    }
+}
+
+TEST(ThreadPoolTest, SubmitBatchIsOneSplice) {
+    constexpr std::size_t kTasks = 5'000;
+
+    std::atomic<std::size_t> counter{0};
+    auto tasks = std::make_unique<CountTask[]>(kTasks);
+
+    ThreadPool pool(3);
+    ThreadPool::task_list batch;
+
+    for (std::size_t i = 0; i < kTasks; ++i) {
+        tasks[i].counter = &counter;
+        batch.push_back(tasks[i]);
+    }
+
+    pool.submit_batch(batch);
+
+    EXPECT_TRUE(batch.empty());
+
+    wait_for(counter, kTasks);
+
+    for (std::size_t i = 0; i < kTasks; ++i) {
+        ASSERT_EQ(tasks[i].runs.load(), 1);
+    }
+}
+
+/* a task that fans out a whole batch from inside the pool */
+struct BatchSpawner : PoolTask {
+    ThreadPool* pool{nullptr};
+    CountTask* children{nullptr};
+    std::size_t count{0};
+
+    void run() noexcept override {
+        ThreadPool::task_list batch;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            batch.push_back(children[i]);
+        }
+
+        pool->submit_batch(batch);
+    }
+};
+
+TEST(ThreadPoolTest, SubmitBatchFromInsideThePool) {
+    constexpr std::size_t kTasks = 3'000;
+
+    std::atomic<std::size_t> counter{0};
+    auto tasks = std::make_unique<CountTask[]>(kTasks);
+
+    ThreadPool pool(3);
+    BatchSpawner spawner;
+
+    for (std::size_t i = 0; i < kTasks; ++i) {
+        tasks[i].counter = &counter;
+    }
+
+    spawner.pool = &pool;
+    spawner.children = tasks.get();
+    spawner.count = kTasks;
+
+    pool.submit(spawner);
+
+    wait_for(counter, kTasks);
+
+    for (std::size_t i = 0; i < kTasks; ++i) {
+        ASSERT_EQ(tasks[i].runs.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, TasksSubmitFromInsideThePool) {
+    constexpr std::size_t kNodes = (1 << 14) - 1;
+
+    std::atomic<std::size_t> counter{0};
+    auto nodes = std::make_unique<ForkNode[]>(kNodes);
+
+    ThreadPool pool(4);
+
+    for (std::size_t i = 0; i < kNodes; ++i) {
+        nodes[i].pool = &pool;
+        nodes[i].nodes = nodes.get();
+        nodes[i].index = i;
+        nodes[i].total = kNodes;
+        nodes[i].counter = &counter;
+    }
+
+    pool.submit(nodes[0]);
+
+    wait_for(counter, kNodes);
+}
+
+TEST(ThreadPoolTest, DestructorDrainsPendingWork) {
+    constexpr std::size_t kNodes = (1 << 12) - 1;
+
+    std::atomic<std::size_t> counter{0};
+    auto nodes = std::make_unique<ForkNode[]>(kNodes);
+
+    {
+        ThreadPool pool(2);
+
+        for (std::size_t i = 0; i < kNodes; ++i) {
+            nodes[i].pool = &pool;
+            nodes[i].nodes = nodes.get();
+            nodes[i].index = i;
+            nodes[i].total = kNodes;
+            nodes[i].counter = &counter;
+        }
+
+        pool.submit(nodes[0]);
+    }
+
+    EXPECT_EQ(counter.load(), kNodes);
+}
+
+TEST(ThreadPoolTest, ParkedWorkersWakeUp) {
+    std::atomic<std::size_t> counter{0};
+    CountTask tasks[8];
+
+    ThreadPool pool(4);
+
+    for (int round = 0; round < 8; ++round) {
+        /* give every worker time to park */
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        tasks[round].counter = &counter;
+        pool.submit(tasks[round]);
+
+        wait_for(counter, static_cast<std::size_t>(round + 1));
+    }
+}
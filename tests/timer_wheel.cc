@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/timer_wheel.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+struct WheelTimer : IntrusiveListNode<> {
+    std::uint64_t deadline{0};
+    int id{0};
+};
+
+struct Session {
+    std::uint64_t expires_at{0};
+    IntrusiveListNode<> timeout_hook_;
+};
+
+struct ExpiresAt {
+    std::uint64_t operator()(const Session& s) const noexcept { return s.expires_at; }
+};
+
+using Wheel = IntrusiveTimerWheel<WheelTimer>;
+using SessionWheel = IntrusiveTimerWheel<Session, ExpiresAt, MemberHook<&Session::timeout_hook_>>;
+
+std::vector<std::uint64_t> deadlines(IntrusiveList<WheelTimer>& list) {
+    std::vector<std::uint64_t> out;
+
+    while (auto* t = list.try_pop_front()) {
+        out.push_back(t->deadline);
+    }
+
+    return out;
+}
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(TimerWheelTest, EmptyWheel) {
+    Wheel wheel(100);
+    IntrusiveList<WheelTimer> expired;
+
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(wheel.now(), 100u);
+
+    wheel.advance(1000, expired);
+
+    EXPECT_TRUE(expired.empty());
+    EXPECT_EQ(wheel.now(), 1000u);
+}
+
+TEST(TimerWheelTest, FiresAtDeadline) {
+    WheelTimer a, b;
+    a.deadline = 10;
+    b.deadline = 11;
+
+    Wheel wheel;
+    IntrusiveList<WheelTimer> expired;
+
+    wheel.schedule(a);
+    wheel.schedule(b);
+    EXPECT_FALSE(wheel.empty());
+
+    wheel.advance(9, expired);
+    EXPECT_TRUE(expired.empty());
+
+    wheel.advance(10, expired);
+    EXPECT_EQ(deadlines(expired), (std::vector<std::uint64_t>{10}));
+
+    wheel.advance(20, expired);
+    EXPECT_EQ(deadlines(expired), (std::vector<std::uint64_t>{11}));
+
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, PastDeadlineFiresNextTick) {
+    WheelTimer a;
+    a.deadline = 3;
+
+    Wheel wheel(50);
+    IntrusiveList<WheelTimer> expired;
+
+    wheel.schedule(a);
+    wheel.advance(51, expired);
+
+    EXPECT_EQ(&expired.front(), &a);
+    expired.clear();
+}
+
+TEST(TimerWheelTest, CascadesAcrossLevels) {
+    WheelTimer t[4];
+    t[0].deadline = 63;
+    t[1].deadline = 64;             /* level 1 */
+    t[2].deadline = 64 * 64 + 5;    /* level 2 */
+    t[3].deadline = 64 * 64 * 64 * 3 + 64 * 7 + 1; /* level 3 */
+
+    Wheel wheel;
+    IntrusiveList<WheelTimer> expired;
+
+    for (auto& x : t) {
+        wheel.schedule(x);
+    }
+
+    wheel.advance(63, expired);
+    EXPECT_EQ(deadlines(expired), (std::vector<std::uint64_t>{63}));
+
+    wheel.advance(64, expired);
+    EXPECT_EQ(deadlines(expired), (std::vector<std::uint64_t>{64}));
+
+    wheel.advance(64 * 64 + 4, expired);
+    EXPECT_TRUE(expired.empty());
+
+    wheel.advance(64 * 64 + 5, expired);
+    EXPECT_EQ(deadlines(expired), (std::vector<std::uint64_t>{64 * 64 + 5}));
+
+    wheel.advance(t[3].deadline - 1, expired);
+    EXPECT_TRUE(expired.empty());
+
+    wheel.advance(t[3].deadline, expired);
+    EXPECT_EQ(expired.size(), 1u);
+    expired.clear();
+
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, OverflowBeyondRange) {
+    WheelTimer far;
+    far.deadline = Wheel::kRange * 2 + 17;
+
+    Wheel wheel(5);
+    IntrusiveList<WheelTimer> expired;
+
+    wheel.schedule(far);
+
+    wheel.advance(far.deadline - 1, expired);
+    EXPECT_TRUE(expired.empty());
+
+    wheel.advance(far.deadline, expired);
+    EXPECT_EQ(&expired.front(), &far);
+    expired.clear();
+}
+
+TEST(TimerWheelTest, LongIdleGapsAreJumpedOver) {
+    /* tick by tick, these advances would take hours */
+    constexpr std::uint64_t kFar = std::uint64_t{1} << 40;
+
+    WheelTimer near, mid, far;
+    near.deadline = 70;
+    mid.deadline = 5'000'000;
+    far.deadline = kFar + 3;
+
+    Wheel wheel(5);
+    IntrusiveList<WheelTimer> expired;
+
+    wheel.schedule(far);
+    wheel.schedule(mid);
+    wheel.schedule(near);
+
+    wheel.advance(kFar, expired);
+    EXPECT_EQ(deadlines(expired), (std::vector<std::uint64_t>{70, 5'000'000}));
+    EXPECT_EQ(wheel.now(), kFar);
+
+    wheel.advance(kFar + 2, expired);
+    EXPECT_TRUE(expired.empty());
+
+    wheel.advance(kFar + 3, expired);
+    EXPECT_EQ(&expired.front(), &far);
+    expired.clear();
+
+    EXPECT_TRUE(wheel.empty());
+
+    /* empty wheel : one jump */
+    wheel.advance(kFar * 4, expired);
+    EXPECT_TRUE(expired.empty());
+    EXPECT_EQ(wheel.now(), kFar * 4);
+}
+
+TEST(TimerWheelTest, CancelIsRemove) {
+    WheelTimer a, b;
+    a.deadline = 200;
+    b.deadline = 200;
+
+    Wheel wheel;
+    IntrusiveList<WheelTimer> expired;
+
+    wheel.schedule(a);
+    wheel.schedule(b);
+
+    Wheel::cancel(a);
+    EXPECT_FALSE(a.is_linked());
+
+    /* cancelling twice is a no-op */
+    Wheel::cancel(a);
+
+    wheel.advance(300, expired);
+    EXPECT_EQ(&expired.front(), &b);
+    EXPECT_EQ(expired.size(), 1u);
+
+    expired.clear();
+}
+
+TEST(TimerWheelTest, RescheduleAfterCancel) {
+    WheelTimer a;
+    a.deadline = 100;
+
+    Wheel wheel;
+    IntrusiveList<WheelTimer> expired;
+
+    wheel.schedule(a);
+    wheel.advance(50, expired);
+
+    Wheel::cancel(a);
+    a.deadline = 5000;
+    wheel.schedule(a);
+
+    wheel.advance(4999, expired);
+    EXPECT_TRUE(expired.empty());
+
+    wheel.advance(5000, expired);
+    EXPECT_EQ(&expired.front(), &a);
+    expired.clear();
+}
+
+TEST(TimerWheelTest, MemberHookAndCustomDeadline) {
+    Session s[3];
+    s[0].expires_at = 7;
+    s[1].expires_at = 700;
+    s[2].expires_at = 70'000;
+
+    SessionWheel wheel;
+    SessionWheel::list_type expired;
+
+    for (auto& x : s) {
+        wheel.schedule(x);
+    }
+
+    SessionWheel::cancel(s[1]);
+
+    wheel.advance(100'000, expired);
+
+    ASSERT_EQ(expired.size(), 2u);
+    EXPECT_EQ(&expired.front(), &s[0]);
+    EXPECT_EQ(&expired.back(), &s[2]);
+
+    expired.clear();
+}
+
+TEST(TimerWheelTest, ClearDisarmsEverything) {
+    WheelTimer t[8];
+    Wheel wheel;
+
+    for (int i = 0; i < 8; ++i) {
+        t[i].deadline = static_cast<std::uint64_t>(1) << (i * 3);
+        wheel.schedule(t[i]);
+    }
+
+    wheel.clear();
+
+    EXPECT_TRUE(wheel.empty());
+    for (auto& x : t) {
+        EXPECT_FALSE(x.is_linked());
+    }
+}
+
+TEST(TimerWheelTest, RandomizedFiresInTickOrder) {
+    constexpr std::size_t kCount = 5000;
+
+    std::mt19937_64 rng(7);
+    auto timers = std::make_unique<WheelTimer[]>(kCount);
+
+    Wheel wheel(1000);
+    IntrusiveList<WheelTimer> expired;
+    std::vector<std::uint64_t> expected;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        timers[i].deadline = 1000 + rng() % 300'000;
+        wheel.schedule(timers[i]);
+
+        /* a third gets cancelled */
+        if (rng() % 3 == 0) {
+            Wheel::cancel(timers[i]);
+        } else {
+            expected.push_back(timers[i].deadline);
+        }
+    }
+
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<std::uint64_t> fired;
+    std::uint64_t now = 1000;
+
+    while (fired.size() < expected.size()) {
+        now += 1 + rng() % 5000;
+        wheel.advance(now, expired);
+
+        while (auto* t = expired.try_pop_front()) {
+            EXPECT_LE(t->deadline, now);
+            EXPECT_GT(t->deadline, now - 5001);
+            fired.push_back(t->deadline);
+        }
+    }
+
+    EXPECT_EQ(fired, expected);
+    EXPECT_TRUE(wheel.empty());
+}
@@ -1,9 +1,12 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 #include <ntrusive/intrusive.hpp>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <vector>
 
-struct Item : IntrusiveListNode {
+struct Item : IntrusiveListNode<> {
     int value;
 
     explicit Item(int v) : value(v) {}
@@ -13,7 +16,8 @@ using ItemList = IntrusiveList<Item>;
 
 /*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
 
-static void check_integrity(ItemList& list, std::vector<int> expected) {
+template <typename List>
+static void check_integrity(List& list, std::vector<int> expected) {
     std::vector<int> forward;
 
     for (auto& item : list) {
@@ -746,6 +750,23 @@ TEST_F(ListTest, SpliceCellSingle) {
     check_integrity(other, {});
 }
 
+TEST_F(ListTest, SpliceCellOntoItselfIsNoop) {
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    auto it = list.begin();
+
+    ++it;
+
+    /* before itself, and before its successor */
+    list.splice_cell(it, list, it);
+    list.splice_cell(std::next(it), list, it);
+    list.splice_cell(list.begin(), list, list.begin());
+
+    check_integrity(list, {1, 2, 3});
+}
+
 TEST_F(ListTest, ExtractFrontPartial) {
     ItemList out;
     list.push_back(a);
@@ -873,3 +894,762 @@ TEST_F(ListTest, MutateThroughIterator) {
     EXPECT_EQ(a.value, 10);
     EXPECT_EQ(b.value, 20);
 }
+
+/*---*---*---*---*---*---*---*---* CountingPolicy *---*---*---*---*---*---*---*---*/
+
+/* counting lists do not take AutoUnlink hooks */
+struct SafeItem : IntrusiveListNode<DefaultTag, SafeLink> {
+    int value;
+
+    explicit SafeItem(int v) : value(v) {}
+};
+
+using CountedList = IntrusiveList<SafeItem, CountingPolicy>;
+
+static_assert(sizeof(ItemList) == sizeof(NodeBase), "default list must stay counter-free");
+
+class CountedListTest : public testing::Test {
+  protected:
+    SafeItem a{1}, b{2}, c{3}, d{4}, e{5};
+    CountedList list;
+};
+
+TEST_F(CountedListTest, PushPopKeepCount) {
+    list.push_back(a);
+    list.push_front(b);
+    list.insert(list.end(), c);
+
+    check_integrity(list, {2, 1, 3});
+
+    list.pop_front();
+    list.pop_back();
+
+    check_integrity(list, {1});
+
+    EXPECT_EQ(list.try_pop_front(), &a);
+    EXPECT_EQ(list.size(), 0u);
+}
+
+TEST_F(CountedListTest, EraseKeepsCount) {
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+    list.push_back(d);
+
+    list.erase(list.begin());
+    list.erase(c);
+
+    check_integrity(list, {2, 4});
+
+    auto first = list.begin();
+    list.erase_range(first, list.end());
+
+    check_integrity(list, {});
+}
+
+TEST_F(CountedListTest, ClearResetsCount) {
+    list.push_back(a);
+    list.push_back(b);
+
+    list.clear();
+
+    check_integrity(list, {});
+}
+
+TEST_F(CountedListTest, SpliceMovesCount) {
+    CountedList other;
+    list.push_back(a);
+    other.push_back(b);
+    other.push_back(c);
+
+    list.splice(list.end(), other);
+
+    check_integrity(list, {1, 2, 3});
+    check_integrity(other, {});
+}
+
+TEST_F(CountedListTest, SpliceRangeFromOtherList) {
+    CountedList other;
+    list.push_back(a);
+    other.push_back(b);
+    other.push_back(c);
+    other.push_back(d);
+
+    auto last = other.begin();
+    ++last;
+    ++last;
+
+    list.splice_range(list.end(), other, other.begin(), last);
+
+    check_integrity(list, {1, 2, 3});
+    check_integrity(other, {4});
+}
+
+TEST_F(CountedListTest, SpliceRangeWithinSameList) {
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    auto first = list.begin();
+    ++first;
+
+    /* move [b, c] in front of a */
+    list.splice_range(list.begin(), list, first, list.end());
+
+    check_integrity(list, {2, 3, 1});
+}
+
+TEST_F(CountedListTest, SpliceCellMovesOne) {
+    CountedList other;
+    list.push_back(a);
+    other.push_back(b);
+    other.push_back(c);
+
+    list.splice_cell(list.end(), other, other.begin());
+
+    check_integrity(list, {1, 2});
+    check_integrity(other, {3});
+}
+
+TEST_F(CountedListTest, ExtractFrontMovesCount) {
+    CountedList out;
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    EXPECT_EQ(list.extract_front(out, 2), 2u);
+
+    check_integrity(out, {1, 2});
+    check_integrity(list, {3});
+}
+
+/*---*---*---*---*---*---*---*---* Multiple hooks *---*---*---*---*---*---*---*---*/
+
+struct LruTag {};
+struct ReadyTag {};
+
+struct Conn : IntrusiveListNode<LruTag>, IntrusiveListNode<ReadyTag, SafeLink> {
+    int value;
+    IntrusiveListNode<> timeout_hook_;
+
+    explicit Conn(int v) : value(v) {}
+};
+
+using LruList = IntrusiveList<Conn, BaseHook<LruTag>>;
+using ReadyList = IntrusiveList<Conn, BaseHook<ReadyTag>, CountingPolicy>;
+using TimeoutList = IntrusiveList<Conn, MemberHook<&Conn::timeout_hook_>>;
+
+class MultiHookTest : public testing::Test {
+  protected:
+    Conn a{1}, b{2}, c{3};
+
+    LruList lru;
+    ReadyList ready;
+    TimeoutList timeouts;
+};
+
+TEST_F(MultiHookTest, OneObjectInThreeLists) {
+    lru.push_back(a);
+    lru.push_back(b);
+    lru.push_back(c);
+
+    ready.push_back(c);
+    ready.push_back(a);
+
+    timeouts.push_back(b);
+    timeouts.push_front(c);
+
+    check_integrity(lru, {1, 2, 3});
+    check_integrity(ready, {3, 1});
+    check_integrity(timeouts, {3, 2});
+}
+
+TEST_F(MultiHookTest, MemberHookIteratorReturnsOwner) {
+    timeouts.push_back(a);
+    timeouts.push_back(b);
+
+    EXPECT_EQ(&timeouts.front(), &a);
+    EXPECT_EQ(&timeouts.back(), &b);
+    EXPECT_EQ(&(*timeouts.begin()), &a);
+    EXPECT_EQ(timeouts.begin()->value, 1);
+
+    auto inserted = timeouts.insert(timeouts.end(), c);
+
+    EXPECT_EQ(&(*inserted), &c);
+}
+
+TEST_F(MultiHookTest, HooksAreIndependent) {
+    lru.push_back(a);
+    ready.push_back(a);
+    timeouts.push_back(a);
+
+    LruList::remove(a);
+
+    EXPECT_FALSE(static_cast<IntrusiveListNode<LruTag>&>(a).is_linked());
+    EXPECT_TRUE((static_cast<IntrusiveListNode<ReadyTag, SafeLink>&>(a).is_linked()));
+    EXPECT_TRUE(a.timeout_hook_.is_linked());
+
+    check_integrity(lru, {});
+    check_integrity(ready, {1});
+    check_integrity(timeouts, {1});
+
+    TimeoutList::remove(a);
+    ready.erase(a);
+
+    check_integrity(ready, {});
+    check_integrity(timeouts, {});
+}
+
+TEST_F(MultiHookTest, SpliceAndExtractWithMemberHook) {
+    TimeoutList other;
+    timeouts.push_back(a);
+    other.push_back(b);
+    other.push_back(c);
+
+    timeouts.splice(timeouts.end(), other);
+
+    check_integrity(timeouts, {1, 2, 3});
+
+    EXPECT_EQ(timeouts.extract_front(other, 2), 2u);
+
+    check_integrity(other, {1, 2});
+    check_integrity(timeouts, {3});
+}
+
+TEST_F(MultiHookTest, DestroyedObjectLeavesAllLists) {
+    {
+        Conn temp{99};
+
+        lru.push_back(a);
+        lru.push_back(temp);
+        timeouts.push_back(temp);
+        timeouts.push_back(b);
+    }
+
+    check_integrity(lru, {1});
+    check_integrity(timeouts, {2});
+}
+
+/*---*---*---*---*---*---*---*---* Link modes / bulk detach *---*---*---*---*---*---*---*---*/
+
+struct NormalItem : IntrusiveListNode<DefaultTag, NormalLink> {
+    int value;
+
+    explicit NormalItem(int v) : value(v) {}
+};
+
+using NormalList = IntrusiveList<NormalItem>;
+
+TEST_F(ListTest, DetachAllResetsHooks) {
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    list.detach_all();
+
+    EXPECT_FALSE(a.is_linked());
+    EXPECT_FALSE(b.is_linked());
+    EXPECT_FALSE(c.is_linked());
+
+    check_integrity(list, {});
+
+    list.push_back(c);
+    list.push_back(a);
+
+    check_integrity(list, {3, 1});
+}
+
+TEST_F(CountedListTest, DetachAllResetsCount) {
+    list.push_back(a);
+    list.push_back(b);
+
+    list.detach_all();
+
+    EXPECT_FALSE(a.is_linked());
+    check_integrity(list, {});
+}
+
+TEST(NormalLinkTest, PushPopErase) {
+    NormalItem a{1}, b{2}, c{3};
+    NormalList list;
+
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    list.erase(list.begin());
+    NormalList::remove(c);
+
+    check_integrity(list, {2});
+
+    list.pop_front();
+
+    check_integrity(list, {});
+
+    /* stale hooks are fine, linking overwrites them */
+    list.push_back(c);
+    list.push_back(a);
+
+    check_integrity(list, {3, 1});
+}
+
+TEST(NormalLinkTest, ReleaseAllIsConstantTime) {
+    NormalItem a{1}, b{2};
+    NormalList list;
+    NormalList other;
+
+    list.push_back(a);
+    list.push_back(b);
+
+    list.release_all();
+
+    check_integrity(list, {});
+
+    other.push_back(b);
+    other.push_back(a);
+
+    check_integrity(other, {2, 1});
+}
+
+TEST(NormalLinkTest, CountingReleaseAll) {
+    NormalItem a{1}, b{2};
+    IntrusiveList<NormalItem, CountingPolicy> list;
+
+    list.push_back(a);
+    list.push_back(b);
+
+    EXPECT_EQ(list.size(), 2u);
+
+    list.release_all();
+
+    check_integrity(list, {});
+}
+
+/*---*---*---*---*---*---*---*---* Compact / tracked hooks *---*---*---*---*---*---*---*---*/
+
+struct TrackedItem : IntrusiveListNode<DefaultTag, TrackedLink> {
+    int value;
+
+    explicit TrackedItem(int v) : value(v) {}
+};
+
+using TrackedList = IntrusiveList<TrackedItem>;
+
+TEST(CompactHookTest, HookIsTwoPointers) {
+    EXPECT_EQ(sizeof(IntrusiveListNode<>), 2 * sizeof(void*));
+    EXPECT_EQ((sizeof(IntrusiveListNode<DefaultTag, SafeLink>)), 2 * sizeof(void*));
+    EXPECT_EQ((sizeof(IntrusiveListNode<DefaultTag, NormalLink>)), 2 * sizeof(void*));
+    EXPECT_GT((sizeof(IntrusiveListNode<DefaultTag, TrackedLink>)), 2 * sizeof(void*));
+}
+
+TEST_F(ListTest, LinkedStateFollowsPointers) {
+    list.push_back(a);
+    list.push_back(b);
+
+    EXPECT_TRUE(a.is_linked());
+
+    a.unlink();
+    EXPECT_FALSE(a.is_linked());
+    EXPECT_EQ(a.next_node(), nullptr);
+
+    list.erase(list.begin());
+    EXPECT_FALSE(b.is_linked());
+
+    check_integrity(list, {});
+}
+
+TEST(TrackedLinkTest, FlagAgreesWithPointers) {
+    TrackedItem a{1}, b{2}, c{3};
+    TrackedList list;
+
+    list.push_back(a);
+    list.push_back(b);
+    list.push_front(c);
+
+    EXPECT_TRUE(a.is_linked());
+    EXPECT_TRUE(c.is_linked());
+
+    b.unlink();
+    EXPECT_FALSE(b.is_linked());
+
+    list.pop_front();
+    EXPECT_FALSE(c.is_linked());
+
+    check_integrity(list, {1});
+
+    list.detach_all();
+    EXPECT_FALSE(a.is_linked());
+}
+
+TEST(TrackedLinkTest, AutoUnlinksOnDestruction) {
+    TrackedItem a{1};
+    TrackedList list;
+
+    list.push_back(a);
+    {
+        TrackedItem temp{2};
+        list.push_back(temp);
+    }
+
+    check_integrity(list, {1});
+}
+
+/*---*---*---*---*---*---*---*---* Algorithms *---*---*---*---*---*---*---*---*/
+
+TEST_F(ListTest, SortOrdersAndKeepsLinks) {
+    for (Item* item : {&c, &a, &e, &b, &d}) {
+        list.push_back(*item);
+    }
+
+    list.sort([](const Item& x, const Item& y) { return x.value < y.value; });
+
+    check_integrity(list, {1, 2, 3, 4, 5});
+
+    list.sort([](const Item& x, const Item& y) { return x.value > y.value; });
+
+    check_integrity(list, {5, 4, 3, 2, 1});
+}
+
+TEST(ListAlgorithmTest, SortIsStableOnLargeInput) {
+    /* value = key * 1000 + insertion rank : the rank must stay increasing within a key */
+    std::vector<std::unique_ptr<Item>> items;
+
+    for (int i = 0; i < 1000; ++i) {
+        items.push_back(std::make_unique<Item>(((i * 7919) % 13) * 1000 + i));
+    }
+
+    ItemList list;
+
+    for (auto& item : items) {
+        list.push_back(*item);
+    }
+
+    list.sort([](const Item& x, const Item& y) { return x.value / 1000 < y.value / 1000; });
+
+    std::vector<int> expected;
+
+    for (const auto& item : items) {
+        expected.push_back(item->value);
+    }
+
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](int x, int y) { return x / 1000 < y / 1000; });
+
+    check_integrity(list, expected);
+    list.clear();
+}
+
+TEST_F(ListTest, SortEmptyAndSingle) {
+    list.sort([](const Item& x, const Item& y) { return x.value < y.value; });
+    check_integrity(list, {});
+
+    list.push_back(a);
+    list.sort([](const Item& x, const Item& y) { return x.value < y.value; });
+    check_integrity(list, {1});
+}
+
+TEST_F(CountedListTest, MergeMovesEverythingAndCount) {
+    CountedList other;
+    const auto less = [](const SafeItem& x, const SafeItem& y) { return x.value < y.value; };
+
+    list.push_back(b);
+    list.push_back(d);
+    other.push_back(a);
+    other.push_back(c);
+    other.push_back(e);
+
+    list.merge(other, less);
+
+    check_integrity(list, {1, 2, 3, 4, 5});
+    check_integrity(other, {});
+}
+
+TEST_F(ListTest, MergeIsStable) {
+    ItemList other;
+    Item b2{2}, d2{4};
+    const auto less = [](const Item& x, const Item& y) { return x.value < y.value; };
+
+    list.push_back(b);
+    list.push_back(d);
+    other.push_back(b2);
+    other.push_back(d2);
+    other.push_back(e);
+
+    list.merge(other, less);
+
+    std::vector<const Item*> order;
+
+    for (auto& item : list) {
+        order.push_back(&item);
+    }
+
+    EXPECT_EQ(order, (std::vector<const Item*>{&b, &b2, &d, &d2, &e}));
+    EXPECT_TRUE(other.empty());
+    list.clear();
+}
+
+TEST_F(CountedListTest, UniqueRemovesConsecutiveDuplicates) {
+    SafeItem b2{2}, b3{2}, d2{4};
+
+    for (SafeItem* item : {&a, &b, &b2, &b3, &c, &d, &d2, &e}) {
+        list.push_back(*item);
+    }
+
+    std::vector<SafeItem*> disposed;
+
+    const auto same = [](const SafeItem& x, const SafeItem& y) { return x.value == y.value; };
+    EXPECT_EQ(list.unique(same, [&](SafeItem& item) { disposed.push_back(&item); }), 3u);
+
+    check_integrity(list, {1, 2, 3, 4, 5});
+    EXPECT_EQ(disposed, (std::vector<SafeItem*>{&b2, &b3, &d2}));
+    EXPECT_FALSE(b2.is_linked());
+}
+
+TEST_F(CountedListTest, RemoveIfUnlinksMatches) {
+    for (SafeItem* item : {&a, &b, &c, &d, &e}) {
+        list.push_back(*item);
+    }
+
+    EXPECT_EQ(list.remove_if([](const SafeItem& x) { return x.value % 2 == 0; }), 2u);
+
+    check_integrity(list, {1, 3, 5});
+    EXPECT_FALSE(b.is_linked());
+    EXPECT_FALSE(d.is_linked());
+}
+
+TEST_F(ListTest, ReverseFlipsBothDirections) {
+    list.reverse();
+    check_integrity(list, {});
+
+    for (Item* item : {&a, &b, &c, &d}) {
+        list.push_back(*item);
+    }
+
+    list.reverse();
+
+    check_integrity(list, {4, 3, 2, 1});
+}
+
+/*---*---*---*---*---*---*---*---* Batched insertion *---*---*---*---*---*---*---*---*/
+
+TEST_F(ListTest, PushBackRangeOfReferences) {
+    list.push_back(a);
+
+    std::vector<std::reference_wrapper<Item>> batch{b, c, d};
+    list.push_back_range(batch.begin(), batch.end());
+
+    check_integrity(list, {1, 2, 3, 4});
+    EXPECT_TRUE(c.is_linked());
+}
+
+TEST_F(ListTest, InsertRangeOfPointersInMiddle) {
+    list.push_back(a);
+    list.push_back(e);
+
+    Item* batch[] = {&b, &c, &d};
+    auto pos = list.begin();
+    ++pos;
+
+    auto first = list.insert_range(pos, std::begin(batch), std::end(batch));
+
+    EXPECT_EQ(&*first, &b);
+    check_integrity(list, {1, 2, 3, 4, 5});
+}
+
+TEST_F(ListTest, InsertEmptyRangeReturnsPos) {
+    list.push_back(a);
+
+    Item* none[1] = {nullptr};
+    auto it = list.insert_range(list.begin(), none, none);
+
+    EXPECT_EQ(it, list.begin());
+    check_integrity(list, {1});
+}
+
+TEST_F(CountedListTest, InsertRangeBumpsCount) {
+    SafeItem* batch[] = {&a, &b, &c};
+
+    list.push_back(d);
+    list.insert_range(list.begin(), std::begin(batch), std::end(batch));
+    list.push_back_range(&e, &e + 1);
+
+    check_integrity(list, {1, 2, 3, 4, 5});
+}
+
+/*---*---*---*---*---*---*---*---* Tail extraction and cuts *---*---*---*---*---*---*---*---*/
+
+TEST_F(ListTest, ExtractBackKeepsOrder) {
+    ItemList out;
+
+    for (Item* item : {&a, &b, &c, &d, &e}) {
+        list.push_back(*item);
+    }
+
+    EXPECT_EQ(list.extract_back(out, 2), 2u);
+    check_integrity(list, {1, 2, 3});
+    check_integrity(out, {4, 5});
+
+    EXPECT_EQ(list.extract_back(out, 10), 3u);
+    check_integrity(list, {});
+    check_integrity(out, {4, 5, 1, 2, 3});
+
+    EXPECT_EQ(list.extract_back(out, 1), 0u);
+}
+
+TEST_F(ListTest, SplitAtAndAfter) {
+    ItemList tail;
+    ItemList rest;
+
+    for (Item* item : {&a, &b, &c, &d, &e}) {
+        list.push_back(*item);
+    }
+
+    auto pos = list.begin();
+    ++pos;
+    ++pos;
+
+    list.split_at(pos, tail);
+    check_integrity(list, {1, 2});
+    check_integrity(tail, {3, 4, 5});
+
+    tail.split_after(tail.begin(), rest);
+    check_integrity(tail, {3});
+    check_integrity(rest, {4, 5});
+
+    /* nothing after the last element, nothing at end() */
+    rest.split_after(--rest.end(), tail);
+    list.split_at(list.end(), tail);
+    check_integrity(rest, {4, 5});
+    check_integrity(list, {1, 2});
+    check_integrity(tail, {3});
+}
+
+TEST_F(CountedListTest, SplitCountsTheShorterSide) {
+    CountedList out;
+
+    for (SafeItem* item : {&a, &b, &c, &d, &e}) {
+        list.push_back(*item);
+    }
+
+    /* short tail */
+    list.split_after(--list.end(), out);
+    list.split_at(--list.end(), out);
+    check_integrity(list, {1, 2, 3, 4});
+    check_integrity(out, {5});
+
+    /* short head */
+    list.split_after(list.begin(), out);
+    check_integrity(list, {1});
+    check_integrity(out, {5, 2, 3, 4});
+
+    EXPECT_EQ(out.extract_back(list, 2), 2u);
+    check_integrity(out, {5, 2});
+    check_integrity(list, {1, 3, 4});
+
+    list.split_at(list.begin(), out);
+    check_integrity(list, {});
+    check_integrity(out, {5, 2, 1, 3, 4});
+}
+
+/*---*---*---*---*---*---*---*---* Consume *---*---*---*---*---*---*---*---*/
+
+TEST_F(CountedListTest, ConsumeFrontHandsOutUnlinkedElements) {
+    for (SafeItem* item : {&a, &b, &c, &d, &e}) {
+        list.push_back(*item);
+    }
+
+    std::vector<int> seen;
+
+    auto n = list.consume_front(3, [&](SafeItem& item) {
+        EXPECT_FALSE(item.is_linked());
+        seen.push_back(item.value);
+    });
+
+    EXPECT_EQ(n, 3u);
+    EXPECT_EQ(seen, (std::vector<int>{1, 2, 3}));
+    check_integrity(list, {4, 5});
+
+    EXPECT_EQ(list.consume_front(10, [&](SafeItem& item) { seen.push_back(item.value); }), 2u);
+    check_integrity(list, {});
+    EXPECT_EQ(list.consume_front(1, [](SafeItem&) {}), 0u);
+}
+
+TEST_F(CountedListTest, ConsumeCallbackMayRequeue) {
+    for (SafeItem* item : {&a, &b, &c, &d}) {
+        list.push_back(*item);
+    }
+
+    /* rotate the first two to the back */
+    list.consume_front(2, [&](SafeItem& item) { list.push_back(item); });
+    check_integrity(list, {3, 4, 1, 2});
+
+    /* fewer elements than asked : the requeued ones are not taken again */
+    EXPECT_EQ(list.consume_front(10, [&](SafeItem& item) { list.push_back(item); }), 4u);
+    check_integrity(list, {3, 4, 1, 2});
+
+    /* every element goes back, only the ones present at the call are visited */
+    std::size_t visited = list.consume_all([&](SafeItem& item) { list.push_front(item); });
+
+    EXPECT_EQ(visited, 4u);
+    check_integrity(list, {2, 1, 4, 3});
+}
+
+TEST_F(CountedListTest, ConsumeCallbackMayEraseLaterElements) {
+    list.push_back(a);
+    list.push_back(b);
+
+    /* the whole rest of the batch goes away */
+    EXPECT_EQ(list.consume_front(10, [&](SafeItem&) { list.erase(b); }), 1u);
+    check_integrity(list, {});
+    EXPECT_FALSE(b.is_linked());
+
+    for (SafeItem* item : {&a, &b, &c, &d}) {
+        list.push_back(*item);
+    }
+
+    /* a middle element is skipped */
+    std::vector<int> seen;
+
+    EXPECT_EQ(list.consume_front(10, [&](SafeItem& item) {
+        seen.push_back(item.value);
+        if (&item == &a) {
+            list.erase(c);
+        }
+    }), 3u);
+
+    EXPECT_EQ(seen, (std::vector<int>{1, 2, 4}));
+    check_integrity(list, {});
+
+    for (SafeItem* item : {&a, &b, &c}) {
+        list.push_back(*item);
+    }
+
+    /* the tail goes away while the batch is requeued : the requeued ones are not taken */
+    EXPECT_EQ(list.consume_front(10, [&](SafeItem& item) {
+        if (&item == &a) {
+            list.erase(c);
+        }
+        list.push_back(item);
+    }), 1u);
+
+    check_integrity(list, {2, 1});
+}
+
+TEST(ListConsumeTest, CallbackMayDestroy) {
+    ItemList list;
+
+    for (int i = 0; i < 8; ++i) {
+        list.push_back(*new Item(i));
+    }
+
+    int sum = 0;
+
+    auto n = list.consume_all([&](Item& item) {
+        sum += item.value;
+        delete &item;
+    });
+
+    EXPECT_EQ(n, 8u);
+    EXPECT_EQ(sum, 28);
+    EXPECT_TRUE(list.empty());
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/wait_queue.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(WaitQueueTest, MutexExcludes) {
+    FifoMutex mutex;
+    std::size_t counter = 0;
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 20'000; ++i) {
+                std::lock_guard lock(mutex);
+                ++counter;
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(counter, 80'000u);
+}
+
+TEST(WaitQueueTest, MutexTimedLockCancelsItself) {
+    FifoMutex mutex;
+    mutex.lock();
+
+    std::thread other([&] {
+        EXPECT_FALSE(mutex.try_lock_for(10ms));
+    });
+
+    other.join();
+
+    /* the timed-out waiter left the list : the fast path works again */
+    mutex.unlock();
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(WaitQueueTest, MutexTimedLockGetsHandoff) {
+    FifoMutex mutex;
+    mutex.lock();
+
+    std::atomic<bool> locked{false};
+
+    std::thread other([&] {
+        locked.store(mutex.try_lock_for(10s));
+        mutex.unlock();
+    });
+
+    std::this_thread::sleep_for(5ms);
+    mutex.unlock();
+    other.join();
+
+    EXPECT_TRUE(locked.load());
+}
+
+TEST(WaitQueueTest, CondVarWakesInArrivalOrder) {
+    FifoMutex mutex;
+    FifoCondVar cv;
+    std::size_t arrived = 0;
+    std::vector<int> order;
+
+    std::vector<std::thread> threads;
+
+    for (int id = 0; id < 5; ++id) {
+        threads.emplace_back([&, id] {
+            std::unique_lock lock(mutex);
+            ++arrived;
+            cv.wait(lock);
+            order.push_back(id);
+        });
+
+        /* thread id is linked once it has released the mutex inside wait() */
+        for (;;) {
+            std::lock_guard lock(mutex);
+
+            if (arrived == static_cast<std::size_t>(id) + 1) {
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        cv.notify_one();
+
+        for (;;) {
+            std::lock_guard lock(mutex);
+
+            if (order.size() == static_cast<std::size_t>(i) + 1) {
+                break;
+            }
+        }
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(WaitQueueTest, NotifyNWakesExactlyN) {
+    FifoMutex mutex;
+    FifoCondVar cv;
+    std::size_t arrived = 0;
+    std::atomic<std::size_t> woken{0};
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 5; ++t) {
+        threads.emplace_back([&] {
+            std::unique_lock lock(mutex);
+            ++arrived;
+            cv.wait(lock);
+            woken.fetch_add(1);
+        });
+    }
+
+    for (;;) {
+        std::lock_guard lock(mutex);
+
+        if (arrived == 5) {
+            break;
+        }
+    }
+
+    EXPECT_EQ(cv.notify_n(2), 2u);
+
+    while (woken.load() < 2) {
+        std::this_thread::yield();
+    }
+
+    std::this_thread::sleep_for(5ms);
+    EXPECT_EQ(woken.load(), 2u);
+
+    cv.notify_all();
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(woken.load(), 5u);
+    EXPECT_EQ(cv.notify_n(3), 0u);
+}
+
+TEST(WaitQueueTest, CondVarWaitForTimesOut) {
+    FifoMutex mutex;
+    FifoCondVar cv;
+
+    std::unique_lock lock(mutex);
+
+    EXPECT_EQ(cv.wait_for(lock, 5ms), std::cv_status::timeout);
+    EXPECT_FALSE(cv.wait_for(lock, 5ms, [] { return false; }));
+    EXPECT_TRUE(lock.owns_lock());
+
+    /* nobody left behind in the list */
+    EXPECT_EQ(cv.notify_n(1), 0u);
+}
+
+TEST(WaitQueueTest, SemaphoreHandsPermitsToWaiters) {
+    FifoSemaphore sem(0);
+    std::atomic<std::size_t> acquired{0};
+
+    EXPECT_FALSE(sem.try_acquire());
+    EXPECT_FALSE(sem.try_acquire_for(5ms));
+
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&] {
+            sem.acquire();
+            acquired.fetch_add(1);
+        });
+    }
+
+    sem.release(2);
+
+    while (acquired.load() < 2) {
+        std::this_thread::yield();
+    }
+
+    sem.release(2);
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(acquired.load(), 3u);
+    EXPECT_EQ(sem.available(), 1u);
+}
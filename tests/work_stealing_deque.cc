@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <ntrusive/intrusive.hpp>
+#include <ntrusive/work_stealing_deque.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct StealTask : IntrusiveListNode<DefaultTag, SafeLink> {
+    int id{0};
+    std::atomic<int> runs{0};
+};
+
+using StealDeque = IntrusiveWorkStealingDeque<StealTask, 8, BaseHook<DefaultTag>>;
+using StealList = StealDeque::list_type;
+
+/*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*---*/
+
+TEST(WorkStealingDequeTest, EmptyDeque) {
+    StealDeque deque;
+
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThiefIsFifo) {
+    StealTask t[4];
+    StealDeque deque;
+
+    for (int i = 0; i < 4; ++i) {
+        t[i].id = i;
+        ASSERT_TRUE(deque.push(t[i]));
+    }
+
+    EXPECT_EQ(deque.size(), 4u);
+
+    EXPECT_EQ(deque.pop(), &t[3]);
+    EXPECT_EQ(deque.steal(), &t[0]);
+    EXPECT_EQ(deque.pop(), &t[2]);
+    EXPECT_EQ(deque.steal(), &t[1]);
+
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(deque.pop(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, FullRingRefusesPush) {
+    StealTask t[9];
+    StealDeque deque;
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(deque.push(t[i]));
+    }
+
+    EXPECT_FALSE(deque.push(t[8]));
+
+    /* a steal frees a slot, the ring wraps */
+    EXPECT_EQ(deque.steal(), &t[0]);
+    EXPECT_TRUE(deque.push(t[8]));
+    EXPECT_EQ(deque.pop(), &t[8]);
+
+    while (deque.pop() != nullptr) {
+    }
+}
+
+TEST(WorkStealingDequeTest, PushFromSpillsTheRest) {
+    StealTask t[10];
+    StealList in;
+
+    for (auto& x : t) {
+        in.push_back(x);
+    }
+
+    StealDeque deque;
+
+    EXPECT_EQ(deque.push_from(in), 8u);
+    EXPECT_EQ(in.size(), 2u);
+    EXPECT_EQ(&in.front(), &t[8]);
+
+    /* elements in the ring carry no list link */
+    EXPECT_FALSE(t[0].is_linked());
+
+    while (deque.pop() != nullptr) {
+    }
+
+    in.clear();
+}
+
+TEST(WorkStealingDequeTest, StealBatchTakesHalfOldestFirst) {
+    StealTask t[7];
+    StealDeque deque;
+
+    for (int i = 0; i < 7; ++i) {
+        t[i].id = i;
+        ASSERT_TRUE(deque.push(t[i]));
+    }
+
+    StealList loot;
+
+    EXPECT_EQ(deque.steal_batch(loot, 100), 4u);
+    EXPECT_EQ(deque.size(), 3u);
+
+    int expected = 0;
+    for (auto& task : loot) {
+        EXPECT_EQ(task.id, expected++);
+    }
+
+    EXPECT_EQ(deque.steal_batch(loot, 1), 1u);
+    EXPECT_EQ(&loot.back(), &t[4]);
+
+    while (deque.pop() != nullptr) {
+    }
+
+    loot.clear();
+}
+
+TEST(WorkStealingDequeTest, ConcurrentOwnerAndThievesRunEachTaskOnce) {
+    constexpr std::size_t kTasks = 200'000;
+    constexpr int kThieves = 3;
+
+    using Deque = IntrusiveWorkStealingDeque<StealTask, 256, BaseHook<DefaultTag>>;
+
+    auto tasks = std::make_unique<StealTask[]>(kTasks);
+    Deque deque;
+
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> thieves;
+
+    for (int i = 0; i < kThieves; ++i) {
+        thieves.emplace_back([&, i] {
+            Deque::list_type loot;
+
+            while (!stop.load(std::memory_order_acquire)) {
+                if (i % 2 == 0) {
+                    if (StealTask* task = deque.steal()) {
+                        task->runs.fetch_add(1, std::memory_order_relaxed);
+                        done.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    continue;
+                }
+
+                const std::size_t n = deque.steal_batch(loot, 16);
+
+                while (StealTask* task = loot.try_pop_front()) {
+                    task->runs.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                done.fetch_add(n, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    /* owner : pushes everything, popping whenever the ring is full */
+    for (std::size_t i = 0; i < kTasks; ++i) {
+        while (!deque.push(tasks[i])) {
+            if (StealTask* task = deque.pop()) {
+                task->runs.fetch_add(1, std::memory_order_relaxed);
+                done.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    while (StealTask* task = deque.pop()) {
+        task->runs.fetch_add(1, std::memory_order_relaxed);
+        done.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    while (done.load(std::memory_order_relaxed) < kTasks) {
+        std::this_thread::yield();
+    }
+
+    stop.store(true, std::memory_order_release);
+
+    for (auto& t : thieves) {
+        t.join();
+    }
+
+    EXPECT_EQ(done.load(), kTasks);
+
+    for (std::size_t i = 0; i < kTasks; ++i) {
+        ASSERT_EQ(tasks[i].runs.load(), 1) << "task " << i;
+    }
+}